@@ -869,6 +869,42 @@ void CompAssignment(DTRRenderContext renderContext, PlatformInput *const input,
 	}
 }
 
+// Point the render buffer at the state's persistent depth buffers, (re)allocating them from a
+// block compatible with stack if the buffer has been resized.
+FILE_SCOPE bool SetupDepthBuffersInternal(DTRState *const state, DqnMemStack *const stack,
+                                          DTRRenderBuffer *const renderBuffer)
+{
+	const DqnV2i dim            = DqnV2i_2i(renderBuffer->width, renderBuffer->height);
+	const i32 zBufferSize       = dim.w * dim.h;
+	const i32 zBufferBlockCount = DTRRender_DepthBlockCount(renderBuffer);
+
+	const size_t zBufferBytes = zBufferSize * DTRRender_DepthBytesPerPixel(renderBuffer->depthFormat);
+	const size_t blocksBytes  = zBufferBlockCount * sizeof(*renderBuffer->zBufferBlocks);
+	const size_t stampsBytes  = zBufferBlockCount * sizeof(*renderBuffer->zBufferBlockStamps);
+	const size_t locksBytes   = zBufferSize * sizeof(*renderBuffer->pixelLockTable);
+
+	if (!state->depthMemBlock || state->depthMemBlockDim.w != dim.w ||
+	    state->depthMemBlockDim.h != dim.h || state->depthMemBlockFormat != renderBuffer->depthFormat)
+	{
+		// NOTE: The block is zero cleared, so every lock is released and every stamp is stale
+		DqnMemStack_FreeDetachedBlock(state->depthMemBlock);
+		state->depthMemBlock = DqnMemStack_AllocateCompatibleBlock(
+		    stack, zBufferBytes + blocksBytes + stampsBytes + locksBytes);
+		state->depthMemBlockDim    = dim;
+		state->depthMemBlockFormat = renderBuffer->depthFormat;
+		state->depthStamp          = 0;
+		if (!state->depthMemBlock) return false;
+	}
+
+	u8 *const memory                 = state->depthMemBlock->memory;
+	renderBuffer->zBuffer            = (f32 *)memory;
+	renderBuffer->zBufferBlocks      = (DTRRenderDepthBlock *)(memory + zBufferBytes);
+	renderBuffer->zBufferBlockStamps = (u32 *)(memory + zBufferBytes + blocksBytes);
+	renderBuffer->pixelLockTable     = (bool *)(memory + zBufferBytes + blocksBytes + stampsBytes);
+	renderBuffer->depthStamp         = state->depthStamp;
+	return true;
+}
+
 extern "C" void DTR_Update(PlatformRenderBuffer *const platformRenderBuffer,
                            PlatformInput *const input,
                            PlatformMemory *const memory)
@@ -878,6 +914,9 @@ extern "C" void DTR_Update(PlatformRenderBuffer *const platformRenderBuffer,
 	////////////////////////////////////////////////////////////////////////////
 	DTRState *state        = (DTRState *)memory->context;
 	globalDTRPlatformFlags = input->flags;
+
+	// NOTE: Globals are lost when the DLL is reloaded, this is a no-op once the tables are built
+	DTRRender_InitColorTables();
 	if (globalDTRPlatformFlags.executableReloaded)
 	{
 		// DTR_DEBUG_EP_PROFILE_END();
@@ -912,20 +951,20 @@ extern "C" void DTR_Update(PlatformRenderBuffer *const platformRenderBuffer,
 		DTRAsset_InitGlobalState();
 		DTRAsset_LoadFontToBitmap(input->api, &memory->mainStack, tempStack, &state->font,
 		                          "Roboto-bold.ttf", DqnV2i_2i(256, 256), DqnV2i_2i(' ', '~'), 12);
-		DTRAsset_LoadBitmap(input->api, assetStack,
-		                    tempStack, &state->bitmap, "tree00.bmp");
+		DTRAsset_LoadBitmap(input->api, assetStack, tempStack, &state->bitmap, "tree00.bmp",
+		                    DTRBitmapLayout_RowMajor, DTRBitmapFormat_Linear16);
 
 #if 1
-		if (DTRAsset_LoadWavefrontObj(input->api, assetStack, &state->mesh, "african_head.obj"))
+		if (DTRAsset_LoadMesh(input->api, input->jobQueue, assetStack, tempStack, &state->mesh, "african_head.obj"))
 		{
 			DTRAsset_LoadBitmap(input->api, assetStack, tempStack, &state->mesh.tex,
-			                    "african_head_diffuse.tga");
+			                    "african_head_diffuse.tga", DTRBitmapLayout_Tiled4x4, DTRBitmapFormat_Linear16);
 		}
 #else
-		if (DTRAsset_LoadWavefrontObj(input->api, assetStack, &state->mesh, "chalet.obj"))
+		if (DTRAsset_LoadMesh(input->api, input->jobQueue, assetStack, tempStack, &state->mesh, "chalet.obj"))
 		{
 			DTRAsset_LoadBitmap(input->api, assetStack, tempStack, &state->mesh.tex,
-			                    "chalet.jpg");
+			                    "chalet.jpg", DTRBitmapLayout_Tiled4x4, DTRBitmapFormat_Linear16);
 		}
 #endif
 
@@ -957,6 +996,16 @@ extern "C" void DTR_Update(PlatformRenderBuffer *const platformRenderBuffer,
 			DqnMemStack_InitWithFixedMem(&globalDebug.memStack, debugMemory, debugSize);
 			DTRDebug_BeginCycleCount("DTR_Update", DTRDebugCycleCount_DTR_Update);
 
+			// NOTE: Rendering needs the debug memory, so the test can't run with the other debug
+			// tests on initialisation
+			LOCAL_PERSIST bool testMeshCullingOnce = true;
+			if (DTR_DEBUG && testMeshCullingOnce)
+			{
+				DTRDebug_TestMeshBackFaceCulling(&state->mesh, &input->api, input->jobQueue,
+				                                 &memory->tempStack);
+				testMeshCullingOnce = false;
+			}
+
 			DTRRenderBuffer renderBuffer = {};
 			renderBuffer.width           = platformRenderBuffer->width;
 			renderBuffer.height          = platformRenderBuffer->height;
@@ -964,17 +1013,12 @@ extern "C" void DTR_Update(PlatformRenderBuffer *const platformRenderBuffer,
 			renderBuffer.memory          = (u8 *)platformRenderBuffer->memory;
 			renderBuffer.renderLock      = state->renderLock;
 
-			u32 zBufferSize      = platformRenderBuffer->width * platformRenderBuffer->height;
-			renderBuffer.zBuffer = (f32 *)DqnMemStack_Push(
-			    &memory->tempStack, zBufferSize * sizeof(*renderBuffer.zBuffer));
-
-			renderBuffer.pixelLockTable = (bool *)DqnMemStack_Push(
-			    &memory->tempStack, zBufferSize * sizeof(*renderBuffer.pixelLockTable));
-
-			for (u32 i = 0; i < zBufferSize; i++)
+			renderBuffer.depthFormat = DTRRenderDepthFormat_F32;
+			if (!SetupDepthBuffersInternal(state, &memory->mainStack, &renderBuffer))
 			{
-				renderBuffer.zBuffer[i]        = DQN_F32_MIN;
-				renderBuffer.pixelLockTable[i] = false;
+				// TODO(doyle): Not enough memory die gracefully
+				DQN_ASSERT(DQN_INVALID_CODE_PATH);
+				return;
 			}
 
 			DTRRenderContext renderContext = {};
@@ -986,7 +1030,19 @@ extern "C" void DTR_Update(PlatformRenderBuffer *const platformRenderBuffer,
 			////////////////////////////////////////////////////////////////////////////
 			// Update and Render
 			////////////////////////////////////////////////////////////////////////////
-			DTRRender_Clear(renderContext, DqnV3_3f(0.5f, 0.0f, 1.0f));
+			// NOTE: The frame's draws are recorded then submitted together, see DTRRenderCommandBuffer
+			const u32 MAX_FRAME_COMMANDS    = 1024;
+			DTRRenderCommandBuffer commands = {};
+			if (!DTRRender_BeginCommands(&commands, &memory->tempStack, MAX_FRAME_COMMANDS))
+			{
+				// TODO(doyle): Not enough memory die gracefully
+				DQN_ASSERT(DQN_INVALID_CODE_PATH);
+				return;
+			}
+
+			// NOTE: Pixel locks persist and are always released after use, so they stay clear
+			DTRRender_PushClear(&commands, renderContext, DqnV3_3f(0.5f, 0.0f, 1.0f),
+			                    DTRRenderClearFlag_Color | DTRRenderClearFlag_Depth);
 
 #if 1
 			DqnV4 colorRed    = DqnV4_4f(0.8f, 0, 0, 1);
@@ -1012,17 +1068,12 @@ extern "C" void DTR_Update(PlatformRenderBuffer *const platformRenderBuffer,
 
 				if (0)
 				{
-					DTRDebug_BeginCycleCount(
-					    "DTR_Update_RenderPrimitiveTriangles",
-					    DTRDebugCycleCount_DTR_Update_RenderPrimitiveTriangles);
-
-					DTRRender_Triangle(renderContext, t0[0], t0[1], t0[2], colorRed);
-					DTRRender_Triangle(renderContext, t1[0], t1[1], t1[2], colorRed);
-					DTRRender_Triangle(renderContext, t3[0], t3[1], t3[2], colorRed, rotatingXform);
-					DTRRender_Triangle(renderContext, t2[0], t2[1], t2[2], colorRed);
-					DTRRender_Triangle(renderContext, t4[0], t4[1], t4[2], colorRed);
-					DTRRender_Triangle(renderContext, t5[0], t5[1], t5[2], colorRed);
-					DTRDebug_EndCycleCount(DTRDebugCycleCount_DTR_Update_RenderPrimitiveTriangles);
+					DTRRender_PushTriangle(&commands, renderContext, t0[0], t0[1], t0[2], colorRed);
+					DTRRender_PushTriangle(&commands, renderContext, t1[0], t1[1], t1[2], colorRed);
+					DTRRender_PushTriangle(&commands, renderContext, t3[0], t3[1], t3[2], colorRed, rotatingXform);
+					DTRRender_PushTriangle(&commands, renderContext, t2[0], t2[1], t2[2], colorRed);
+					DTRRender_PushTriangle(&commands, renderContext, t4[0], t4[1], t4[2], colorRed);
+					DTRRender_PushTriangle(&commands, renderContext, t5[0], t5[1], t5[2], colorRed);
 				}
 
 				if (1)
@@ -1034,8 +1085,6 @@ extern "C" void DTR_Update(PlatformRenderBuffer *const platformRenderBuffer,
 						runTinyRendererOnce = false;
 					}
 
-					DTRDebug_BeginCycleCount("DTR_Update_RenderModel",
-					                         DTRDebugCycleCount_DTR_Update_RenderModel);
 					////////////////////////////////////////////////////////////////////////
 					// Draw Loaded Model
 					////////////////////////////////////////////////////////////////////////
@@ -1058,9 +1107,10 @@ extern "C" void DTR_Update(PlatformRenderBuffer *const platformRenderBuffer,
 					lighting.vector         = LIGHT;
 					lighting.color          = DqnV4_4f(1, 1, 1, 1);
 
-					DTRRender_Mesh(renderContext, input->jobQueue, mesh, lighting, modelP,
-					               transform);
-					DTRDebug_EndCycleCount(DTRDebugCycleCount_DTR_Update_RenderModel);
+					DTRRenderContext meshContext = renderContext;
+					meshContext.cullMode         = DTRRenderCullMode_Back;
+					meshContext.blendMode        = DTRRenderBlendMode_Opaque;
+					DTRRender_PushMesh(&commands, meshContext, mesh, lighting, modelP, transform);
 				}
 			}
 
@@ -1070,8 +1120,9 @@ extern "C" void DTR_Update(PlatformRenderBuffer *const platformRenderBuffer,
 				DTRRenderTransform transform = DTRRender_DefaultTransform();
 				transform.rotation           = rotation + 45;
 
-				DTRRender_Rectangle(renderContext, DqnV2_1f(300.0f), DqnV2_1f(300 + 100.0f),
-				                    DqnV4_4f(0, 1.0f, 1.0f, 1.0f), transform);
+				DTRRender_PushRectangle(&commands, renderContext, DqnV2_1f(300.0f),
+				                        DqnV2_1f(300 + 100.0f), DqnV4_4f(0, 1.0f, 1.0f, 1.0f),
+				                        transform);
 			}
 
 			// Bitmap drawing
@@ -1087,19 +1138,24 @@ extern "C" void DTR_Update(PlatformRenderBuffer *const platformRenderBuffer,
 				DqnV4 color =
 				    DqnV4_4f(0.5f + 0.5f * sinf(cAngle), 0.5f + 0.5f * sinf(2.9f * cAngle),
 				             0.5f + 0.5f * cosf(10.0f * cAngle), 1.0f);
-				DTRRender_Bitmap(renderContext, &state->bitmap, bitmapP, transform, color);
+				DTRRender_PushBitmap(&commands, renderContext, &state->bitmap, bitmapP, transform,
+				                     color);
 			}
 
 #else
 // CompAssignment(renderBuffer, input, memory);
 #endif
+			// NOTE: The model dominates the frame's commands so it's counted as the submit
+			DTRDebug_BeginCycleCount("DTR_Update_RenderModel", DTRDebugCycleCount_DTR_Update_RenderModel);
+			DTRRender_SubmitCommands(renderContext, &commands);
+			DTRDebug_EndCycleCount(DTRDebugCycleCount_DTR_Update_RenderModel);
+
 			DTRDebug_EndCycleCount(DTRDebugCycleCount_DTR_Update);
 			DTRDebug_Update(state, renderContext, input, memory);
+			state->depthStamp = renderBuffer.depthStamp;
 		}
 
-		while (input->api.QueueTryExecuteNextJob(input->jobQueue) ||
-		       !input->api.QueueAllJobsComplete(input->jobQueue))
-			;
+		input->api.QueueWaitAllJobsComplete(input->jobQueue);
 	}
 
 	////////////////////////////////////////////////////////////////////////////
@@ -15,6 +15,14 @@ typedef struct DTRState
 	DTRMesh   mesh;
 
 	struct PlatformLock *renderLock;
+
+	// NOTE: The zBuffer, its blocks, stamps and the pixel lock table persist between frames so
+	// depth can be cleared lazily, see DTRRenderBuffer. Reallocated when the buffer is resized or
+	// changes depth format.
+	DqnMemStackBlock *depthMemBlock;
+	DqnV2i            depthMemBlockDim;
+	i32               depthMemBlockFormat; // DTRRenderDepthFormat
+	u32               depthStamp;
 } DTRState;
 
 extern PlatformFlags globalDTRPlatformFlags;
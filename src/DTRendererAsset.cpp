@@ -1,4 +1,5 @@
 #include "DTRendererAsset.h"
+#include "DTRenderer.h"
 #include "DTRendererDebug.h"
 #include "DTRendererRender.h"
 
@@ -24,512 +25,339 @@ FILE_SCOPE void MemcopyInternal(u8 *const dest, u8 *const src, size_t numBytes)
 		dest[i] = src[i];
 }
 
-// NOTE: Dynamic array allocations just requests space at the first option it
-// can take. Realloc will reallocate in place if there's space. Otherwise
-// it'll create a new block and reallocate there by copying the old data over.
+////////////////////////////////////////////////////////////////////////////////
+// Wavefront Obj
+////////////////////////////////////////////////////////////////////////////////
+// NOTE: The obj is split into chunks on line boundaries and each chunk is parsed as a job in two
+// passes. The first pass counts the records of each chunk. The counts are prefix summed to give
+// each chunk its offset into the final mesh arrays, so once the arrays are allocated the second
+// pass parses every chunk straight into its slice of the mesh with no merging afterwards.
+#define WAVEF_CHUNK_SIZE DQN_KILOBYTE(256)
 
-// So this does waste space. But is a quick way to reroute allocations into
-// a MemStack. It's main intended purpose is for one-shot loading data that you
-// don't know how much space you need in your DArray. After filling out
-// the dynamic array you then compact the data manually using memcopys into
-// a new block and discard the old data.
-FILE_SCOPE void DumbDynamicArrayMemAPICallback(DqnMemAPICallbackInfo info, DqnMemAPICallbackResult *result)
+typedef struct WavefChunk
 {
-	DQN_ASSERT(info.type != DqnMemAPICallbackType_Invalid);
-	DqnMemStack *stack = static_cast<DqnMemStack *>(info.userContext);
-	switch (info.type)
-	{
-		case DqnMemAPICallbackType_Alloc:
-		{
-			void *ptr         = DqnMemStack_Push(stack, info.requestSize);
-			result->newMemPtr = ptr;
-			result->type      = DqnMemAPICallbackType_Alloc;
-		}
-		break;
-
-		case DqnMemAPICallbackType_Free:
-		{
-			DQN_ASSERT(DQN_INVALID_CODE_PATH);
-		}
-		break;
-
-		case DqnMemAPICallbackType_Realloc:
-		{
-			result->type = DqnMemAPICallbackType_Realloc;
-
-			// Check if the ptr is the last thing that was allocated. If so we
-			// can check if there's enough space in place for realloc and give
-			// them that.
-			u8 *currMemPtr = (u8 *)(stack->block->memory + stack->block->used);
-			u8 *checkPtr   = currMemPtr - info.oldSize;
-			if (checkPtr == info.oldMemPtr)
-			{
-				if ((stack->block->used + info.newRequestSize) < stack->block->size)
-				{
-					stack->block->used += info.newRequestSize;
-					result->newMemPtr = info.oldMemPtr;
-					return;
-				}
-
-				// The allocation was the last one allocated, but there's not
-				// enough space to realloc in the block. For book-keeping,
-				// "deallocate" the old mem ptr by reverting the usage of the
-				// memory stack.
-				stack->block->used -= info.oldSize;
-			}
-
-			// Otherwise, not enough space or, allocation is not the last
-			// allocated, so can't expand inplace.
-			DqnMemStackBlock *newBlock =
-			    DqnMemStack_AllocateCompatibleBlock(stack, info.newRequestSize);
-			if (DqnMemStack_AttachBlock(stack, newBlock))
-			{
-				// NOTE(doyle): This leaves chunks of memory dead!!! But, we use
-				// this in our custom allocator, which its strategy is to load all
-				// the data, using as much re-allocations as required then after the
-				// fact, recompact the data by Memcopying the data together and free
-				// the extraneous blocks we've made.
-
-				void *newPtr = DqnMemStack_Push(stack, info.newRequestSize);
-				MemcopyInternal((u8 *)newPtr, (u8 *)info.oldMemPtr, info.oldSize);
-
-				result->newMemPtr = newPtr;
-			}
-			else
-			{
-				// TODO(doyle): Die out of memory
-				DQN_ASSERT(DQN_INVALID_CODE_PATH);
-			}
-		}
-		break;
-	}
+	char    *start;
+	char    *end;
+	DTRMesh *mesh;
+
+	// Set by the count pass
+	u32 numVertexes;
+	u32 numTexUV;
+	u32 numNormals;
+	u32 numFaces;
+
+	// Prefix sum of the counts of the chunks before this one
+	u32 vertexesOffset;
+	u32 texUVOffset;
+	u32 normalsOffset;
+	u32 facesOffset;
+
+	// Cleared by the parse pass if a face references an attribute that doesn't exist
+	bool valid;
+} WavefChunk;
+
+enum WavefRecordType
+{
+	WavefRecordType_Invalid,
+	WavefRecordType_Geometric,
+	WavefRecordType_Texture,
+	WavefRecordType_Normal,
+	WavefRecordType_Face,
+};
+
+FILE_SCOPE inline bool WavefIsSpace(const char c)
+{
+	bool result = (c == ' ' || c == '\t' || c == '\r');
+	return result;
 }
 
-typedef struct WavefModelFace
+FILE_SCOPE inline char *WavefFindLineEnd(char *ptr, char *const end)
 {
-	DqnArray<i32> vertexIndexArray;
-	DqnArray<i32> textureIndexArray;
-	DqnArray<i32> normalIndexArray;
-} WavefModelFace;
+	while (ptr < end && *ptr != '\n')
+		ptr++;
+	return ptr;
+}
 
-typedef struct WavefModel
+// Get the next whitespace separated token in [*scan, lineEnd) and advance scan past it. Returns the
+// length of the token, 0 if there are no more tokens on the line.
+FILE_SCOPE i32 WavefNextToken(char **const scan, char *const lineEnd, char **const token)
 {
-	DqnArray<DqnV4> geometryArray;
-	DqnArray<DqnV3> textureArray;
-	DqnArray<DqnV3> normalArray;
+	char *ptr = *scan;
+	while (ptr < lineEnd && WavefIsSpace(*ptr))
+		ptr++;
 
-	// TODO(doyle): Fixed size
-	char *groupName[16];
-	i32   groupNameIndex;
-	i32   groupSmoothing;
+	*token = ptr;
+	while (ptr < lineEnd && !WavefIsSpace(*ptr))
+		ptr++;
 
-	DqnArray<WavefModelFace> faces;
-} WavefModel;
+	*scan      = ptr;
+	i32 result = (i32)(ptr - *token);
+	return result;
+}
 
-FILE_SCOPE bool WavefModelInit(WavefModel *const obj,
-                               DqnMemAPI memAPI             = DqnMemAPI_DefaultUseCalloc(),
-                               const i32 vertexInitCapacity = 1000,
-                               const i32 faceInitCapacity   = 1000)
+// Returns the type of the record on the line and points args to the first char after its keyword.
+// Statements we don't use (comments, groups, smoothing, materials, points, lines) are Invalid.
+FILE_SCOPE enum WavefRecordType WavefClassifyLine(char *line, char *const lineEnd,
+                                                  char **const args)
 {
-	if (!obj) return false;
-
-	bool initialised = false;
-
-	initialised |= DqnArray_Init(&obj->geometryArray, vertexInitCapacity, memAPI);
-	initialised |= DqnArray_Init(&obj->textureArray,  vertexInitCapacity, memAPI);
-	initialised |= DqnArray_Init(&obj->normalArray,   vertexInitCapacity, memAPI);
-	initialised |= DqnArray_Init(&obj->faces,         faceInitCapacity, memAPI);
+	char *keyword;
+	i32 keywordLen = WavefNextToken(&line, lineEnd, &keyword);
+	*args          = line;
 
-	if (!initialised)
+	enum WavefRecordType result = WavefRecordType_Invalid;
+	if (keywordLen == 1)
+	{
+		char identifier = DqnChar_ToLower(keyword[0]);
+		if      (identifier == 'v') result = WavefRecordType_Geometric;
+		else if (identifier == 'f') result = WavefRecordType_Face;
+	}
+	else if (keywordLen == 2 && DqnChar_ToLower(keyword[0]) == 'v')
 	{
-		DqnArray_Free(&obj->geometryArray);
-		DqnArray_Free(&obj->textureArray);
-		DqnArray_Free(&obj->normalArray);
-		DqnArray_Free(&obj->faces);
+		// Vertex Format: v[ |t|n|p] x y z [w]
+		char identifier = DqnChar_ToLower(keyword[1]);
+		if      (identifier == 't') result = WavefRecordType_Texture;
+		else if (identifier == 'n') result = WavefRecordType_Normal;
 	}
 
-	return initialised;
+	return result;
 }
 
-FILE_SCOPE inline WavefModelFace
-WavefModelFaceInit(i32 capacity = 3, DqnMemAPI memAPI = DqnMemAPI_DefaultUseCalloc())
+FILE_SCOPE void WavefParseF32s(char *scan, char *const lineEnd, f32 *const result,
+                               const i32 maxF32s)
 {
-	WavefModelFace result = {};
-	DQN_ASSERT(DqnArray_Init(&result.vertexIndexArray,  capacity, memAPI));
-	DQN_ASSERT(DqnArray_Init(&result.textureIndexArray, capacity, memAPI));
-	DQN_ASSERT(DqnArray_Init(&result.normalIndexArray,  capacity, memAPI));
-
-	return result;
+	char *token;
+	i32 tokenLen;
+	for (i32 i = 0; i < maxF32s && (tokenLen = WavefNextToken(&scan, lineEnd, &token)) > 0; i++)
+		result[i] = Dqn_StrToF32(token, tokenLen);
 }
 
-FILE_SCOPE size_t FindFirstNewlineFeedChar(char *ptr)
+FILE_SCOPE void WavefCountChunk(WavefChunk *const chunk)
 {
-	size_t offset = 0;
-	while (ptr && (*ptr != '\n' && *ptr != '\r'))
+	for (char *line = chunk->start; line < chunk->end;)
 	{
-		offset++;
-		ptr++;
-	}
+		char *lineEnd = WavefFindLineEnd(line, chunk->end);
+		char *args;
+		switch (WavefClassifyLine(line, lineEnd, &args))
+		{
+			case WavefRecordType_Geometric: chunk->numVertexes++; break;
+			case WavefRecordType_Texture:   chunk->numTexUV++;    break;
+			case WavefRecordType_Normal:    chunk->numNormals++;  break;
 
-	return offset;
-}
+			case WavefRecordType_Face:
+			{
+				// NOTE: Polygons are triangulated as a fan, so n vertexes make n - 2 faces
+				u32 numVertexes = 0;
+				char *token;
+				while (WavefNextToken(&args, lineEnd, &token) > 0)
+					numVertexes++;
 
-FILE_SCOPE size_t FindFirstCharNotLinefeedOrSpace(char *ptr)
-{
-	size_t offset = 0;
-	while (ptr && (*ptr == ' ' || *ptr == '\n' || *ptr == '\r'))
-	{
-		offset++;
-		ptr++;
-	}
+				if (numVertexes >= 3) chunk->numFaces += (numVertexes - 2);
+			}
+			break;
 
-	return offset;
+			default: break;
+		}
 
+		line = lineEnd + 1;
+	}
 }
 
-bool DTRAsset_LoadWavefrontObj(const PlatformAPI api, DqnMemStack *const memStack,
-                               DTRMesh *const mesh, const char *const path)
+FILE_SCOPE void WavefParseChunk(WavefChunk *const chunk)
 {
-	if (!memStack || !path || !mesh) return false;
-
-	PlatformFile file = {};
-	if (!api.FileOpen(path, &file, PlatformFilePermissionFlag_Read, PlatformFileAction_OpenOnly))
-		return false; // TODO(doyle): Logging
-
-	WavefModel dummy_ = {};
-	WavefModel *obj   = &dummy_;
+	DTRMesh *const mesh = chunk->mesh;
+	u32 vertexIndex     = chunk->vertexesOffset;
+	u32 texUVIndex      = chunk->texUVOffset;
+	u32 normalIndex     = chunk->normalsOffset;
+	u32 faceIndex       = chunk->facesOffset;
 
-	DqnMemAPI memAPI   = {};
-	memAPI.callback    = DumbDynamicArrayMemAPICallback;
-	memAPI.userContext = memStack;
-
-	bool result = false;
-	DqnMemStackTempRegion tmpAssetRegion;
-	if (!DqnMemStackTempRegion_Begin(&tmpAssetRegion, memStack))
+	for (char *line = chunk->start; line < chunk->end;)
 	{
-		// TODO(doyle): Logging
-		DQN_ASSERT(DQN_INVALID_CODE_PATH);
-		goto cleanup;
-	}
-
-	u8 *rawBytes                         = (u8 *)DqnMemStack_Push(memStack, file.size);
-	size_t bytesRead                     = api.FileRead(&file, rawBytes, file.size);
-	size_t fileSize                      = file.size;
-
-	enum WavefVertexType {
-		WavefVertexType_Invalid,
-		WavefVertexType_Geometric,
-		WavefVertexType_Texture,
-		WavefVertexType_Normal,
-	};
-
-	// TODO(doyle): We should profile, reading it out to WavefModel format and
-	// then copying it over, versus just reading the file twice. First pass is
-	// to count the number of vertexes etc. for each section we need. Then the
-	// second pass we can allocate directly the number we need and reparse it.
-	// I have a feeling that, in general that's a better idea, atleast it gets
-	// rid of alot of stupid copying code and memstack juggling.
-
-	// NOTE(doyle): We pre-process the data into an intermediate format that
-	// more accurately represents the file format. Since there's no metadata
-	// inside Wavefront objects, we don't know how many vertexes/texUV/normals
-	// there are- which makes it hard to allocate "nicely" out of our memory
-	// stack.
-
-	// So we preprocess. Then once we know the final amount, copy over the data
-	// to a new memstack block such that all the data is compacted together in
-	// memory for locality. Then just throw away the intermediate
-	// representation.
-	if (bytesRead != file.size)       goto cleanup;
-	if (!WavefModelInit(obj, memAPI)) goto cleanup;
-
-	for (char *scan = (char *)rawBytes; scan && scan < ((char *)rawBytes + fileSize);)
-	{
-		switch (DqnChar_ToLower(*scan))
+		char *lineEnd = WavefFindLineEnd(line, chunk->end);
+		char *args;
+		switch (WavefClassifyLine(line, lineEnd, &args))
 		{
-			////////////////////////////////////////////////////////////////////
-			// Polygonal Free Form Statement
-			////////////////////////////////////////////////////////////////////
-			// Vertex Format: v[ |t|n|p] x y z [w]
-			case 'v':
+			case WavefRecordType_Geometric:
 			{
-				scan++;
-				DQN_ASSERT(scan);
-
-				enum WavefVertexType type = WavefVertexType_Invalid;
-
-				char identifier = DqnChar_ToLower(*scan);
-				if      (identifier == ' ') type = WavefVertexType_Geometric;
-				else if (identifier == 't' || identifier == 'n')
-				{
-					scan++;
-					if (identifier == 't') type = WavefVertexType_Texture;
-					else                   type = WavefVertexType_Normal;
-				}
-				else DQN_ASSERT(DQN_INVALID_CODE_PATH);
-
-				i32 vIndex = 0;
-				DqnV4 v4   = {0, 0, 0, 1.0f};
-
-				// Progress to first non space character after vertex identifier
-				for (; scan && *scan == ' '; scan++)
-					if (!scan) DQN_ASSERT(DQN_INVALID_CODE_PATH);
-
-				for (;;)
-				{
-					char *f32StartPtr = scan;
-					for (; *scan != ' ' && *scan != '\n' && *scan != '\r';)
-					{
-						DQN_ASSERT(DqnChar_IsDigit(*scan) || (*scan == '.') || (*scan == '-') ||
-						           *scan == 'e');
-						scan++;
-					}
-
-					i32 f32Len     = (i32)((size_t)scan - (size_t)f32StartPtr);
-					v4.e[vIndex++] = Dqn_StrToF32(f32StartPtr, f32Len);
-					DQN_ASSERT(vIndex < DQN_ARRAY_COUNT(v4.e));
-
-					scan += FindFirstCharNotLinefeedOrSpace(scan);
-					if (!scan) break;
-					if (!(DqnChar_IsDigit(*scan) || *scan == '-')) break;
-				}
-
-				DQN_ASSERT(vIndex >= 2 && vIndex <= 4);
-				if (type == WavefVertexType_Geometric)
-				{
-					DqnArray_Push(&obj->geometryArray, v4);
-				}
-				else if (type == WavefVertexType_Texture)
-				{
-					DqnArray_Push(&obj->textureArray, v4.xyz);
-				}
-				else if (type == WavefVertexType_Normal)
-				{
-					DqnArray_Push(&obj->normalArray, v4.xyz);
-				}
-				else
-				{
-					DQN_ASSERT(DQN_INVALID_CODE_PATH);
-				}
+				DqnV4 v4 = DqnV4_4f(0, 0, 0, 1.0f);
+				WavefParseF32s(args, lineEnd, v4.e, DQN_ARRAY_COUNT(v4.e));
+				mesh->vertexes[vertexIndex++] = v4;
 			}
 			break;
 
-			////////////////////////////////////////////////////////////////////
-			// Polygonal Geometry
-			////////////////////////////////////////////////////////////////////
-			// Vertex numbers can be negative to reference a relative offset to
-			// the vertex which means the relative order of the vertices
-			// specified in the file, i.e.
-
-			// v 0.000000 2.000000 2.000000
-			// v 0.000000 0.000000 2.000000
-			// v 2.000000 0.000000 2.000000
-			// v 2.000000 2.000000 2.000000
-			// f -4 -3 -2 -1
-
-			// Point Format: p v1 v2 v3 ...
-			// Each point is one vertex.
-			case 'p':
+			case WavefRecordType_Texture:
 			{
-				DQN_ASSERT(DQN_INVALID_CODE_PATH);
+				DqnV3 v3 = {};
+				WavefParseF32s(args, lineEnd, v3.e, DQN_ARRAY_COUNT(v3.e));
+				mesh->texUV[texUVIndex++] = v3;
 			}
 			break;
 
-			// Line Format: l v1/vt1 v2/vt2 v3/vt3 ...
-			// Texture vertex is optional. Minimum of two vertex numbers, no
-			// limit on maximum.
-			case 'l':
+			case WavefRecordType_Normal:
 			{
-				DQN_ASSERT(DQN_INVALID_CODE_PATH);
+				DqnV3 v3 = {};
+				WavefParseF32s(args, lineEnd, v3.e, DQN_ARRAY_COUNT(v3.e));
+				mesh->normals[normalIndex++] = v3;
 			}
 			break;
 
 			// Face Format: f v1/vt1/vn1 v2/vt2/vn2 v3/vt3/vn3 ...
-			// Minimum of three vertexes, no limit on maximum. vt, vn are
-			// optional. But specification of vt, vn must be consistent if given
-			// across all the vertices for the line.
-
-			// For example, to specify only the vertex and vertex normal
-			// reference numbers, you would enter:
-			
-			// f 1//1 2//2 3//3 4//4
-			case 'f':
+			// Minimum of three vertexes, no limit on maximum. vt, vn are optional, i.e. "f 1//1 2//2 3//3".
+			// Indexes start from 1, negative indexes are relative to the end of the attributes
+			// defined so far in the file, i.e. "f -4 -3 -2 -1" is the last 4 vertexes. Since the
+			// chunk's offsets count everything before it, the running index is that position.
+			case WavefRecordType_Face:
 			{
-				scan++;
-				scan += FindFirstCharNotLinefeedOrSpace(scan);
-				if (!scan) continue;
-
-				WavefModelFace face      = WavefModelFaceInit(3, memAPI);
-				i32 numVertexesParsed    = 0;
-				bool moreVertexesToParse = true;
-				while (moreVertexesToParse)
+				const u32 numDefined[3] = {vertexIndex, texUVIndex, normalIndex};
+				const u32 numTotal[3]   = {mesh->numVertexes, mesh->numTexUV, mesh->numNormals};
+
+				// NOTE: Polygons are triangulated as a fan around their first vertex, every
+				// vertex after the second adds the triangle (first, previous, current).
+				u32 firstVertex[3]    = {};
+				u32 prevVertex[3]     = {};
+				i32 numVertexesParsed = 0;
+
+				char *token;
+				i32 tokenLen;
+				while ((tokenLen = WavefNextToken(&args, lineEnd, &token)) > 0)
 				{
-					enum WavefVertexType type = WavefVertexType_Geometric;
-
 					// Read a vertexes 3 attributes v, vt, vn
-					for (i32 i = 0; i < 3; i++)
+					char *const tokenEnd = token + tokenLen;
+					u32 vertex[3]        = {};
+					for (i32 i = 0; i < 3 && token < tokenEnd; i++)
 					{
-						char *numStartPtr = scan;
-						while (scan && DqnChar_IsDigit(*scan))
-							scan++;
+						char *numStartPtr = token;
+						while (token < tokenEnd && *token != '/')
+							token++;
 
-						i32 numLen = (i32)((size_t)scan - (size_t)numStartPtr);
+						i32 numLen = (i32)(token - numStartPtr);
 						if (numLen > 0)
 						{
-							// NOTE(doyle): Obj format starts indexing from 1,
-							// so offset by -1 to make it zero-based indexes.
-							i32 vertIndex = (i32)Dqn_StrToI64(numStartPtr, numLen) - 1;
-
-							// TODO(doyle): Does not supprot relative vertexes yet
-							DQN_ASSERT(vertIndex >= 0);
+							i64 index = Dqn_StrToI64(numStartPtr, numLen);
+							if (index < 0) index += numDefined[i];
+							else           index -= 1;
 
-							if (type == WavefVertexType_Geometric)
+							if (index < 0 || index >= numTotal[i])
 							{
-								DQN_ASSERT(DqnArray_Push(&face.vertexIndexArray, vertIndex));
-							}
-							else if (type == WavefVertexType_Texture)
-							{
-								DQN_ASSERT(DqnArray_Push(&face.textureIndexArray, vertIndex));
-							}
-							else if (type == WavefVertexType_Normal)
-							{
-								DQN_ASSERT(DqnArray_Push(&face.normalIndexArray, vertIndex));
+								chunk->valid = false;
+								return;
 							}
+							vertex[i] = (u32)index;
 						}
 
-						if (scan) scan++;
-						type = (enum WavefVertexType)((i32)type + 1);
+						token++; // Skip the '/'
 					}
-					numVertexesParsed++;
 
-					if (scan)
+					if (numVertexesParsed == 0)
 					{
-						scan += FindFirstCharNotLinefeedOrSpace(scan);
-
-						// If it isn't a digit, then we've read all the
-						// vertexes for this face
-						if (!scan || (scan && !DqnChar_IsDigit(*scan)))
-						{
-							moreVertexesToParse = false;
-						}
+						for (i32 i = 0; i < 3; i++) firstVertex[i] = vertex[i];
 					}
+					else if (numVertexesParsed >= 2)
+					{
+						DTRMeshFace *face    = &mesh->faces[faceIndex++];
+						face->vertexIndex[0] = firstVertex[0];
+						face->vertexIndex[1] = prevVertex[0];
+						face->vertexIndex[2] = vertex[0];
+						face->texIndex[0]    = firstVertex[1];
+						face->texIndex[1]    = prevVertex[1];
+						face->texIndex[2]    = vertex[1];
+						face->normalIndex[0] = firstVertex[2];
+						face->normalIndex[1] = prevVertex[2];
+						face->normalIndex[2] = vertex[2];
+					}
+
+					for (i32 i = 0; i < 3; i++) prevVertex[i] = vertex[i];
+					numVertexesParsed++;
 				}
-				DQN_ASSERT(numVertexesParsed >= 3);
-				DQN_ASSERT(DqnArray_Push(&obj->faces, face));
 			}
 			break;
 
-			////////////////////////////////////////////////////////////////////
-			// Misc
-			////////////////////////////////////////////////////////////////////
-
-			// Group Name Format: g group_name1 group_name2
-			// This is optional, if multiple groups are specified, then the
-			// following elements belong to all groups. The default group name
-			// is "default"
-			case 'g':
-			{
-				scan++;
-				scan += FindFirstCharNotLinefeedOrSpace(scan);
-				if (!scan) continue;
-
-				// Iterate to end of the name, i.e. move ptr to first space
-				char *namePtr = scan;
-				scan += FindFirstCharNotLinefeedOrSpace(scan);
-
-				if (scan)
-				{
-					i32 nameLen = (i32)((size_t)scan - (size_t)namePtr);
-					DQN_ASSERT(obj->groupNameIndex + 1 < DQN_ARRAY_COUNT(obj->groupName));
-
-					DQN_ASSERT(!obj->groupName[obj->groupNameIndex]);
-					// TODO(doyle): Broken since I don't "copy" it over to our
-					// final DTRMesh. Below I copy over the data so that all the
-					// allocations are compacted together but don't copy this
-					// yet. Which means the name gets trashed atm.
-#if 0
-					obj->groupName[obj->groupNameIndex++] =
-					    (char *)DqnMemStack_Push(memStack, (nameLen + 1) * sizeof(char));
-
-					for (i32 i = 0; i < nameLen; i++)
-						obj->groupName[obj->groupNameIndex - 1][i] = namePtr[i];
-#endif
+			default: break;
+		}
 
-					scan += FindFirstCharNotLinefeedOrSpace(scan);
-				}
-			}
-			break;
+		line = lineEnd + 1;
+	}
 
-			// Smoothing Group: s group_number
-			// Sets the smoothing group for the elements that follow it. If it's
-			// not to be used it can be specified as "off" or a value of 0.
-			case 's':
-			{
-				scan++;
-				scan += FindFirstCharNotLinefeedOrSpace(scan);
+	DQN_ASSERT(vertexIndex == chunk->vertexesOffset + chunk->numVertexes);
+	DQN_ASSERT(texUVIndex  == chunk->texUVOffset + chunk->numTexUV);
+	DQN_ASSERT(normalIndex == chunk->normalsOffset + chunk->numNormals);
+	DQN_ASSERT(faceIndex   == chunk->facesOffset + chunk->numFaces);
+}
 
-				if (scan && DqnChar_IsDigit(*scan))
-				{
-					char *numStartPtr = scan;
-					while (scan && (*scan != ' ' && *scan != '\n' && *scan != '\r'))
-					{
-						DQN_ASSERT(DqnChar_IsDigit(*scan));
-						scan++;
-					}
+void MultiThreadedWavefCountChunk(PlatformJobQueue *const queue, void *const userData)
+{
+	if (!queue || !userData)
+	{
+		DQN_ASSERT(DQN_INVALID_CODE_PATH);
+		return;
+	}
 
-					i32 numLen          = (i32)((size_t)scan - (size_t)numStartPtr);
-					i32 groupSmoothing  = (i32)Dqn_StrToI64(numStartPtr, numLen);
-					obj->groupSmoothing = groupSmoothing;
-				}
+	WavefCountChunk((WavefChunk *)userData);
+}
 
-				scan += FindFirstCharNotLinefeedOrSpace(scan);
-			}
-			break;
+void MultiThreadedWavefParseChunk(PlatformJobQueue *const queue, void *const userData)
+{
+	if (!queue || !userData)
+	{
+		DQN_ASSERT(DQN_INVALID_CODE_PATH);
+		return;
+	}
 
-			// Comment
-			case '#':
-			{
-				scan += FindFirstNewlineFeedChar(scan);
-				scan += FindFirstCharNotLinefeedOrSpace(scan);
-			}
-			break;
+	WavefParseChunk((WavefChunk *)userData);
+}
 
-			default:
-			{
-				// TODO(doyle): Ignore unrecognised items.
-				// DQN_ASSERT(DQN_INVALID_CODE_PATH);
+// Run a job per chunk with callback and wait for them all to complete. Without a job queue the
+// chunks are processed on the calling thread with function.
+FILE_SCOPE void WavefRunChunkJobs(const PlatformAPI api, PlatformJobQueue *const jobQueue,
+                                  PlatformJob_Callback *const callback,
+                                  void (*const function)(WavefChunk *const),
+                                  WavefChunk *const chunks, PlatformJob *const jobList,
+                                  const u32 numChunks)
+{
+	if (!jobQueue)
+	{
+		for (u32 i = 0; i < numChunks; i++)
+			function(&chunks[i]);
+		return;
+	}
 
-				scan += FindFirstNewlineFeedChar(scan);
-				scan += FindFirstCharNotLinefeedOrSpace(scan);
-			}
-			break;
-		}
+	for (u32 i = 0; i < numChunks; i++)
+	{
+		jobList[i].callback = callback;
+		jobList[i].userData = &chunks[i];
 	}
 
-	////////////////////////////////////////////////////////////////////////////
-	// Recompact Allocations
-	////////////////////////////////////////////////////////////////////////////
-	size_t geometrySize      = sizeof(obj->geometryArray.data[0]) * obj->geometryArray.count;
-	size_t textureSize       = sizeof(obj->textureArray.data[0]) * obj->textureArray.count;
-	size_t normalSize        = sizeof(obj->normalArray.data[0]) * obj->normalArray.count;
-	size_t faceSize          = sizeof(obj->faces.data[0]) * obj->faces.count;
-	size_t vertIndexItemSize = sizeof(obj->faces.data[0].vertexIndexArray.data[0]);
-	size_t texIndexItemSize  = sizeof(obj->faces.data[0].textureIndexArray.data[0]);
-	size_t normIndexItemSize = sizeof(obj->faces.data[0].normalIndexArray.data[0]);
+	Platform_QueueAddAllJobs(&api, jobQueue, jobList, numChunks);
+	api.QueueWaitAllJobsComplete(jobQueue);
+}
 
-	size_t totalModelSize = geometrySize + textureSize + normalSize + faceSize;
+// NOTE: Sums six times the signed volume of the tetrahedron from the origin to each face, which is
+// positive if the faces of a closed mesh are counter clockwise when seen from outside of it.
+FILE_SCOPE bool MeshIsClockwiseInternal(const DTRMesh *const mesh)
+{
+	f32 volume6Times = 0;
+	for (u32 i = 0; i < mesh->numFaces; i++)
 	{
-		for (i32 i = 0; i < obj->faces.count; i++)
-		{
-			WavefModelFace *face = &obj->faces.data[i];
+		const DTRMeshFace *face = mesh->faces + i;
+		DqnV3 a = mesh->vertexes[face->vertexIndex[0]].xyz;
+		DqnV3 b = mesh->vertexes[face->vertexIndex[1]].xyz;
+		DqnV3 c = mesh->vertexes[face->vertexIndex[2]].xyz;
+		volume6Times += DqnV3_Dot(a, DqnV3_Cross(b, c));
+	}
 
-			size_t vertIndexSize    = face->vertexIndexArray.count * vertIndexItemSize;
-			size_t texIndexSize     = face->textureIndexArray.count * texIndexItemSize;
-			size_t normIndexSize    = face->normalIndexArray.count * normIndexItemSize;
+	bool result = (volume6Times < 0);
+	return result;
+}
 
-			totalModelSize += (vertIndexSize + texIndexSize + normIndexSize);
-		}
-	}
+// Allocate the mesh arrays for the counts set in mesh in one new block, so that all of the mesh data
+// is together for locality. The block is returned detached from memStack, since the caller is in a
+// temp region that is about to be ended. Returns NULL if out of memory.
+FILE_SCOPE DqnMemStackBlock *WavefAllocMeshInternal(DqnMemStack *const memStack, DTRMesh *const mesh)
+{
+	size_t geometrySize   = sizeof(*mesh->vertexes) * mesh->numVertexes;
+	size_t textureSize    = sizeof(*mesh->texUV) * mesh->numTexUV;
+	size_t normalSize     = sizeof(*mesh->normals) * mesh->numNormals;
+	size_t faceSize       = sizeof(*mesh->faces) * mesh->numFaces;
+	size_t totalModelSize = geometrySize + textureSize + normalSize + faceSize;
 
 	// IMPORTANT(doyle): We always allocate a new block, so each assets owns
 	// their own memory block.
@@ -544,40 +372,8 @@ bool DTRAsset_LoadWavefrontObj(const PlatformAPI api, DqnMemStack *const memStac
 			mesh->normals  = (DqnV3 *)DqnMemStack_Push(memStack, normalSize);
 			mesh->faces    = (DTRMeshFace *)DqnMemStack_Push(memStack, faceSize);
 
-			mesh->numVertexes = (u32)obj->geometryArray.count;
-			mesh->numTexUV    = (u32)obj->textureArray.count;
-			mesh->numNormals  = (u32)obj->normalArray.count;
-			mesh->numFaces    = (u32)obj->faces.count;
-
-			MemcopyInternal((u8 *)mesh->vertexes, (u8 *)obj->geometryArray.data, geometrySize);
-			MemcopyInternal((u8 *)mesh->texUV,    (u8 *)obj->textureArray.data,  textureSize);
-			MemcopyInternal((u8 *)mesh->normals,  (u8 *)obj->normalArray.data,   normalSize);
-			MemcopyInternal((u8 *)mesh->faces,    (u8 *)obj->faces.data,     faceSize);
-
-			for (i32 i = 0; i < obj->faces.count; i++)
-			{
-				WavefModelFace *face     = &obj->faces.data[i];
-				DTRMeshFace *const meshFace = &mesh->faces[i];
-
-				size_t vertIndexSize = face->vertexIndexArray.count * vertIndexItemSize;
-				size_t texIndexSize  = face->textureIndexArray.count * texIndexItemSize;
-				size_t normIndexSize = face->normalIndexArray.count * normIndexItemSize;
-
-				meshFace->vertexIndex = (i32 *)DqnMemStack_Push(memStack, vertIndexSize);
-				meshFace->texIndex    = (i32 *)DqnMemStack_Push(memStack, texIndexSize);
-				meshFace->normalIndex = (i32 *)DqnMemStack_Push(memStack, normIndexSize);
-
-				MemcopyInternal((u8 *)meshFace->vertexIndex, (u8 *)face->vertexIndexArray.data, vertIndexSize);
-				MemcopyInternal((u8 *)meshFace->texIndex,    (u8 *)face->textureIndexArray.data, texIndexSize);
-				MemcopyInternal((u8 *)meshFace->normalIndex, (u8 *)face->normalIndexArray.data, normIndexSize);
-
-				meshFace->numVertexIndex = (u32)face->vertexIndexArray.count;
-				meshFace->numTexIndex    = (u32)face->textureIndexArray.count;
-				meshFace->numNormalIndex = (u32)face->normalIndexArray.count;
-			}
-
 			// NOTE: Detach the block, because the stack is in a temp region.
-			// End the temp region and reattach the compact model block.
+			// End the temp region and reattach the model block.
 			DqnMemStack_DetachBlock(memStack, modelBlock);
 		}
 		else
@@ -585,6 +381,8 @@ bool DTRAsset_LoadWavefrontObj(const PlatformAPI api, DqnMemStack *const memStac
 			// TODO(doyle): Stack can't attach block, i.e. invalid args or
 			// stack is configured to be nonexpandable
 			DQN_ASSERT(DQN_INVALID_CODE_PATH);
+			DqnMemStack_FreeDetachedBlock(modelBlock);
+			modelBlock = NULL;
 		}
 	}
 	else
@@ -593,24 +391,324 @@ bool DTRAsset_LoadWavefrontObj(const PlatformAPI api, DqnMemStack *const memStac
 		DQN_ASSERT(DQN_INVALID_CODE_PATH);
 	}
 
+	return modelBlock;
+}
+
+bool DTRAsset_LoadWavefrontObj(const PlatformAPI api, PlatformJobQueue *const jobQueue,
+                               DqnMemStack *const memStack, DTRMesh *const mesh,
+                               const char *const path)
+{
+	if (!memStack || !path || !mesh) return false;
+
+	PlatformFile file = {};
+	if (!api.FileOpen(path, &file, PlatformFilePermissionFlag_Read, PlatformFileAction_OpenOnly))
+		return false; // TODO(doyle): Logging
+
+	// NOTE: Declared before any "goto cleanup" so we never jump over their initialisation.
+	bool result                  = false;
+	DqnMemStackBlock *modelBlock = NULL;
+	DTRMesh newMesh              = *mesh;
+	u32 numChunks                = 0;
+	u32 maxChunks                = (u32)((file.size + WAVEF_CHUNK_SIZE - 1) / WAVEF_CHUNK_SIZE);
+	u8 *rawBytes                 = NULL;
+	WavefChunk *chunks           = NULL;
+	PlatformJob *jobList         = NULL;
+	char *fileEnd                = NULL;
+
+	DqnMemStackTempRegion tmpAssetRegion;
+	if (!DqnMemStackTempRegion_Begin(&tmpAssetRegion, memStack))
+	{
+		// TODO(doyle): Logging
+		DQN_ASSERT(DQN_INVALID_CODE_PATH);
+		api.FileClose(&file);
+		return false;
+	}
+
+	rawBytes = (u8 *)DqnMemStack_Push(memStack, file.size);
+	chunks   = (WavefChunk *)DqnMemStack_Push(memStack, sizeof(*chunks) * maxChunks);
+	jobList  = (PlatformJob *)DqnMemStack_Push(memStack, sizeof(*jobList) * maxChunks);
+	if (file.size == 0 || !rawBytes || !chunks || !jobList) goto cleanup;
+	if (api.FileRead(&file, rawBytes, file.size) != file.size) goto cleanup;
+
+	////////////////////////////////////////////////////////////////////////////
+	// Split into chunks on line boundaries
+	////////////////////////////////////////////////////////////////////////////
+	fileEnd = (char *)rawBytes + file.size;
+	for (char *chunkStart = (char *)rawBytes; chunkStart < fileEnd;)
+	{
+		char *chunkEnd = fileEnd;
+		if ((size_t)(fileEnd - chunkStart) > WAVEF_CHUNK_SIZE)
+			chunkEnd = WavefFindLineEnd(chunkStart + WAVEF_CHUNK_SIZE - 1, fileEnd) + 1;
+
+		DQN_ASSERT(numChunks < maxChunks);
+		WavefChunk *chunk = &chunks[numChunks++];
+		*chunk            = {};
+		chunk->start      = chunkStart;
+		chunk->end        = DQN_MIN(chunkEnd, fileEnd);
+		chunk->mesh       = &newMesh;
+		chunk->valid      = true;
+		chunkStart        = chunk->end;
+	}
+
+	////////////////////////////////////////////////////////////////////////////
+	// Count, prefix sum the counts into offsets then parse
+	////////////////////////////////////////////////////////////////////////////
+	WavefRunChunkJobs(api, jobQueue, MultiThreadedWavefCountChunk, WavefCountChunk, chunks,
+	                  jobList, numChunks);
+
+	newMesh.numVertexes = 0;
+	newMesh.numTexUV    = 0;
+	newMesh.numNormals  = 0;
+	newMesh.numFaces    = 0;
+	for (u32 i = 0; i < numChunks; i++)
+	{
+		WavefChunk *chunk     = &chunks[i];
+		chunk->vertexesOffset = newMesh.numVertexes;
+		chunk->texUVOffset    = newMesh.numTexUV;
+		chunk->normalsOffset  = newMesh.numNormals;
+		chunk->facesOffset    = newMesh.numFaces;
+
+		newMesh.numVertexes += chunk->numVertexes;
+		newMesh.numTexUV    += chunk->numTexUV;
+		newMesh.numNormals  += chunk->numNormals;
+		newMesh.numFaces    += chunk->numFaces;
+	}
+
+	modelBlock = WavefAllocMeshInternal(memStack, &newMesh);
+	if (!modelBlock) goto cleanup;
+
+	WavefRunChunkJobs(api, jobQueue, MultiThreadedWavefParseChunk, WavefParseChunk, chunks,
+	                  jobList, numChunks);
+
+	result = true;
+	for (u32 i = 0; i < numChunks; i++)
+		result &= chunks[i].valid;
+
+cleanup:
+	api.FileClose(&file);
 	DqnMemStackTempRegion_End(tmpAssetRegion);
-	if (modelBlock)
+
+	if (result)
 	{
-		result = true;
 		DqnMemStackBlock *firstBlock = memStack->block;
 		DqnMemStack_DetachBlock(memStack, memStack->block);
 
 		DqnMemStack_AttachBlock(memStack, modelBlock);
 		DqnMemStack_AttachBlock(memStack, firstBlock);
+		newMesh.clockwise = MeshIsClockwiseInternal(&newMesh);
+		*mesh             = newMesh;
+	}
+	else if (modelBlock)
+	{
+		DqnMemStack_FreeDetachedBlock(modelBlock);
 	}
 
-cleanup:
-	api.FileClose(&file);
-	if(!result) DqnMemStackTempRegion_End(tmpAssetRegion);
+	return result;
+}
 
+////////////////////////////////////////////////////////////////////////////////
+// Binary Mesh File
+////////////////////////////////////////////////////////////////////////////////
+// NOTE: A mesh file is a DTRMeshFileHeader followed by the DTRMesh arrays back to back, each aligned
+// to DTRMESH_FILE_ALIGNMENT. Faces hold their indexes inline so the arrays are used in place.
+#define DTRMESH_FILE_MAGIC     0x4D525444 // "DTRM" in little endian
+#define DTRMESH_FILE_VERSION   3
+#define DTRMESH_FILE_ALIGNMENT 16
+
+typedef struct DTRMeshFileHeader
+{
+	u32 magic;
+	u32 version;
+	u32 faceSize; // sizeof(DTRMeshFace) of the build that compiled it
+	u32 numVertexes;
+	u32 numTexUV;
+	u32 numNormals;
+	u32 numFaces;
+	u32 unused;
+	u64 sourceSize;
+	u64 sourceHash; // MeshFileSourceHashInternal() of the obj's bytes
+
+	u64 vertexesOffset;
+	u64 texUVOffset;
+	u64 normalsOffset;
+	u64 facesOffset;
+} DTRMeshFileHeader;
+
+// NOTE: 64 bit FNV-1a, the size alone misses edits that don't change the length of the obj
+FILE_SCOPE u64 MeshFileSourceHashInternal(const u8 *const bytes, const size_t size)
+{
+	u64 result = 0xcbf29ce484222325;
+	for (size_t i = 0; i < size; i++)
+	{
+		result ^= bytes[i];
+		result *= 0x100000001b3;
+	}
+	return result;
+}
+
+FILE_SCOPE inline bool MeshFileArrayInBoundsInternal(const size_t fileSize, const u64 offset,
+                                                     const u64 count, const size_t itemSize)
+{
+	if (offset > fileSize || (offset % DTRMESH_FILE_ALIGNMENT) != 0) return false;
+	bool result = (count <= ((fileSize - offset) / itemSize));
 	return result;
 }
 
+bool DTRAsset_LoadMeshFile(const PlatformAPI api, DTRMesh *const mesh, const char *const path,
+                           const u64 sourceSize, const u64 sourceHash)
+{
+	if (!mesh || !path) return false;
+
+	PlatformFileMap map = {};
+	if (!api.FileMap(path, &map)) return false;
+
+	////////////////////////////////////////////////////////////////////////////
+	// Validate Header
+	////////////////////////////////////////////////////////////////////////////
+	const DTRMeshFileHeader *header = (DTRMeshFileHeader *)map.memory;
+	if (map.size < sizeof(*header) || header->magic != DTRMESH_FILE_MAGIC ||
+	    header->version != DTRMESH_FILE_VERSION || header->faceSize != sizeof(DTRMeshFace) ||
+	    header->sourceSize != sourceSize || header->sourceHash != sourceHash ||
+	    !MeshFileArrayInBoundsInternal(map.size, header->vertexesOffset, header->numVertexes, sizeof(*mesh->vertexes)) ||
+	    !MeshFileArrayInBoundsInternal(map.size, header->texUVOffset,    header->numTexUV,    sizeof(*mesh->texUV))    ||
+	    !MeshFileArrayInBoundsInternal(map.size, header->normalsOffset,  header->numNormals,  sizeof(*mesh->normals))  ||
+	    !MeshFileArrayInBoundsInternal(map.size, header->facesOffset,    header->numFaces,    sizeof(*mesh->faces)))
+	{
+		api.FileUnmap(&map);
+		return false;
+	}
+
+	////////////////////////////////////////////////////////////////////////////
+	// Validate Indexes
+	////////////////////////////////////////////////////////////////////////////
+	const DTRMeshFace *const faces = (DTRMeshFace *)(map.memory + header->facesOffset);
+	for (u32 i = 0; i < header->numFaces; i++)
+	{
+		const DTRMeshFace *face = faces + i;
+		for (u32 j = 0; j < DQN_ARRAY_COUNT(face->vertexIndex); j++)
+		{
+			if (face->vertexIndex[j] >= header->numVertexes ||
+			    (header->numTexUV > 0 && face->texIndex[j] >= header->numTexUV) ||
+			    (header->numNormals > 0 && face->normalIndex[j] >= header->numNormals))
+			{
+				api.FileUnmap(&map);
+				return false;
+			}
+		}
+	}
+
+	// NOTE: The mapping is never unmapped, the mesh points into it for the rest of the program
+	DTRMesh result     = *mesh;
+	result.vertexes    = (DqnV4 *)(map.memory + header->vertexesOffset);
+	result.texUV       = (DqnV3 *)(map.memory + header->texUVOffset);
+	result.normals     = (DqnV3 *)(map.memory + header->normalsOffset);
+	result.faces       = (DTRMeshFace *)faces;
+	result.numVertexes = header->numVertexes;
+	result.numTexUV    = header->numTexUV;
+	result.numNormals  = header->numNormals;
+	result.numFaces    = header->numFaces;
+	result.clockwise   = MeshIsClockwiseInternal(&result);
+	*mesh              = result;
+	return true;
+}
+
+bool DTRAsset_CompileMeshFile(const PlatformAPI api, DqnMemStack *const tmpMemStack,
+                              const DTRMesh *const mesh, const char *const path,
+                              const u64 sourceSize, const u64 sourceHash)
+{
+	if (!tmpMemStack || !mesh || !path) return false;
+
+	////////////////////////////////////////////////////////////////////////////
+	// Layout
+	////////////////////////////////////////////////////////////////////////////
+	DTRMeshFileHeader header = {};
+	header.magic             = DTRMESH_FILE_MAGIC;
+	header.version           = DTRMESH_FILE_VERSION;
+	header.faceSize          = sizeof(DTRMeshFace);
+	header.numVertexes       = mesh->numVertexes;
+	header.numTexUV          = mesh->numTexUV;
+	header.numNormals        = mesh->numNormals;
+	header.numFaces          = mesh->numFaces;
+	header.sourceSize        = sourceSize;
+	header.sourceHash        = sourceHash;
+
+	size_t fileSize       = DQN_ALIGN_POW_N(sizeof(header), DTRMESH_FILE_ALIGNMENT);
+	header.vertexesOffset = fileSize;
+	fileSize              = DQN_ALIGN_POW_N(fileSize + (sizeof(*mesh->vertexes) * header.numVertexes), DTRMESH_FILE_ALIGNMENT);
+	header.texUVOffset    = fileSize;
+	fileSize              = DQN_ALIGN_POW_N(fileSize + (sizeof(*mesh->texUV) * header.numTexUV), DTRMESH_FILE_ALIGNMENT);
+	header.normalsOffset  = fileSize;
+	fileSize              = DQN_ALIGN_POW_N(fileSize + (sizeof(*mesh->normals) * header.numNormals), DTRMESH_FILE_ALIGNMENT);
+	header.facesOffset    = fileSize;
+	fileSize              = fileSize + (sizeof(*mesh->faces) * header.numFaces);
+
+	bool regionValid;
+	auto tmpMemRegion = DqnMemStackTempRegionGuard(tmpMemStack, &regionValid);
+	if (!regionValid) return false;
+
+	u8 *buf = (u8 *)DqnMemStack_Push(tmpMemStack, fileSize);
+	if (!buf) return false;
+
+	for (size_t i = 0; i < fileSize; i++)
+		buf[i] = 0;
+
+	MemcopyInternal(buf, (u8 *)&header, sizeof(header));
+	MemcopyInternal(buf + header.vertexesOffset, (u8 *)mesh->vertexes, sizeof(*mesh->vertexes) * header.numVertexes);
+	MemcopyInternal(buf + header.texUVOffset,    (u8 *)mesh->texUV,    sizeof(*mesh->texUV) * header.numTexUV);
+	MemcopyInternal(buf + header.normalsOffset,  (u8 *)mesh->normals,  sizeof(*mesh->normals) * header.numNormals);
+	MemcopyInternal(buf + header.facesOffset,    (u8 *)mesh->faces,    sizeof(*mesh->faces) * header.numFaces);
+
+	PlatformFile file = {};
+	if (!api.FileOpen(path, &file, PlatformFilePermissionFlag_Write, PlatformFileAction_ClearIfExist))
+		return false; // TODO(doyle): Logging
+
+	size_t bytesWritten = api.FileWrite(&file, buf, fileSize);
+	api.FileClose(&file);
+	return (bytesWritten == fileSize);
+}
+
+bool DTRAsset_LoadMesh(const PlatformAPI api, PlatformJobQueue *const jobQueue,
+                       DqnMemStack *const memStack, DqnMemStack *const tmpMemStack,
+                       DTRMesh *const mesh, const char *const objPath)
+{
+	if (!memStack || !tmpMemStack || !mesh || !objPath) return false;
+
+	char meshPath[1024] = {};
+	if (Dqn_snprintf(meshPath, DQN_ARRAY_COUNT(meshPath), "%s.dtrm", objPath) >= DQN_ARRAY_COUNT(meshPath))
+		return false;
+
+	// NOTE: Without the obj there's nothing to check against, the compiled mesh is used as is
+	u64 sourceSize         = 0;
+	u64 sourceHash         = 0;
+	PlatformFileMap objMap = {};
+	if (api.FileMap(objPath, &objMap))
+	{
+		sourceSize = objMap.size;
+		sourceHash = MeshFileSourceHashInternal(objMap.memory, objMap.size);
+		api.FileUnmap(&objMap);
+	}
+	else
+	{
+		PlatformFileMap map = {};
+		if (!api.FileMap(meshPath, &map)) return false;
+
+		const DTRMeshFileHeader *header = (DTRMeshFileHeader *)map.memory;
+		if (map.size >= sizeof(*header))
+		{
+			sourceSize = header->sourceSize;
+			sourceHash = header->sourceHash;
+		}
+		api.FileUnmap(&map);
+	}
+
+	if (DTRAsset_LoadMeshFile(api, mesh, meshPath, sourceSize, sourceHash)) return true;
+	if (!DTRAsset_LoadWavefrontObj(api, jobQueue, memStack, mesh, objPath)) return false;
+
+	// NOTE: Failing to compile isn't fatal, the mesh is loaded, it's just parsed again next run
+	DTRAsset_CompileMeshFile(api, tmpMemStack, mesh, meshPath, sourceSize, sourceHash);
+	return true;
+}
+
 bool DTRAsset_LoadFontToBitmap(const PlatformAPI api, DqnMemStack *const memStack,
                                DqnMemStack *const tmpMemStack, DTRFont *const font,
                                const char *const path, const DqnV2i bitmapDim,
@@ -634,6 +732,8 @@ bool DTRAsset_LoadFontToBitmap(const PlatformAPI api, DqnMemStack *const memStac
 	stbtt_pack_context fontPackContext = {};
 
 	bool result       = false;
+	u8 *rawBytes      = NULL;
+	size_t bytesRead  = 0;
 	bool regionValid;
 	auto tmpMemRegion = DqnMemStackTempRegionGuard(tmpMemStack, &regionValid);
 	if (!regionValid)
@@ -643,8 +743,8 @@ bool DTRAsset_LoadFontToBitmap(const PlatformAPI api, DqnMemStack *const memStac
 		goto cleanup;
 	}
 
-	u8 *rawBytes                 = (u8 *)DqnMemStack_Push(tmpMemStack, file.size);
-	size_t bytesRead             = api.FileRead(&file, rawBytes, file.size);
+	rawBytes  = (u8 *)DqnMemStack_Push(tmpMemStack, file.size);
+	bytesRead = api.FileRead(&file, rawBytes, file.size);
 
 	if (bytesRead != file.size || stbtt_InitFont(&fontInfo, rawBytes, 0) == 0)
 	{
@@ -688,15 +788,11 @@ bool DTRAsset_LoadFontToBitmap(const PlatformAPI api, DqnMemStack *const memStac
 			// NOTE: Bitmap from stb_truetype is 1BPP. So the actual color
 			// value represents its' alpha value but also its' color.
 			u32 index = x + (y * bitmapDim.w);
-			f32 alpha = (f32)(loadedFont.bitmap[index]) / 255.0f;
-			f32 color = alpha;
-
-			color = DTRRender_SRGB1ToLinearSpacef(color);
-			color = color * alpha;
-			color = DTRRender_LinearToSRGB1Spacef(color) * 255.0f;
-			DQN_ASSERT(color >= 0.0f && color <= 255.0f);
+			u8 value  = loadedFont.bitmap[index];
+			f32 alpha = (f32)value / 255.0f;
+			f32 color = DTRRender_SRGB255ToLinear1(value) * alpha;
 
-			loadedFont.bitmap[index] = (u8)color;
+			loadedFont.bitmap[index] = (u8)DTRRender_Linear1ToSRGB255(color);
 		}
 	}
 
@@ -757,8 +853,215 @@ FILE_SCOPE void *STBImageMalloc(size_t size)
 #define STB_IMAGE_IMPLEMENTATION
 #include "external/stb_image.h"
 
+// Premultiply the straight SRGB8 texels of bitmap in place. Colour is premultiplied in linear space
+// then stored back as SRGB.
+FILE_SCOPE void BitmapPremultiplySRGB8Internal(DTRBitmap *const bitmap)
+{
+	DQN_ASSERT(bitmap->format == DTRBitmapFormat_SRGB8 && bitmap->bytesPerPixel == sizeof(u32));
+	u32 *const pixels = (u32 *)bitmap->memory;
+	for (i32 i = 0; i < bitmap->dim.w * bitmap->dim.h; i++)
+	{
+		u32 pixel = pixels[i];
+		f32 alpha = (f32)(pixel >> 24) * DTRRENDER_INV_255;
+		u32 r     = DTRRender_Linear1ToSRGB255(DTRRender_SRGB255ToLinear1((pixel >> 0) & 0xFF) * alpha);
+		u32 g     = DTRRender_Linear1ToSRGB255(DTRRender_SRGB255ToLinear1((pixel >> 8) & 0xFF) * alpha);
+		u32 b     = DTRRender_Linear1ToSRGB255(DTRRender_SRGB255ToLinear1((pixel >> 16) & 0xFF) * alpha);
+		u32 a     = (u32)(alpha * 255.0f);
+		pixels[i] = ((a << 24) | (b << 16) | (g << 8) | (r << 0));
+	}
+}
+
+// Box filter src down to the half size dest, averaging 2x2 texels per dest texel. Odd dimensions
+// clamp the last column/row. Texels are premultiplied but stored as SRGB8 by DTRAsset_LoadBitmap(),
+// so colour is decoded to linear space, averaged then encoded back. Alpha is linear already.
+FILE_SCOPE void BitmapBoxFilterHalfSRGB8Internal(const DTRBitmap *const src, DTRBitmap *const dest)
+{
+	DQN_ASSERT(src->bytesPerPixel == sizeof(u32) && dest->bytesPerPixel == sizeof(u32));
+	DQN_ASSERT(src->layout == DTRBitmapLayout_RowMajor && dest->layout == DTRBitmapLayout_RowMajor);
+	const u32 *const srcPixels = (u32 *)src->memory;
+	u32 *const destPixels      = (u32 *)dest->memory;
+
+	for (i32 y = 0; y < dest->dim.h; y++)
+	{
+		const u32 *const srcRow1 = srcPixels + (DQN_MIN(y * 2, src->dim.h - 1) * src->dim.w);
+		const u32 *const srcRow2 = srcPixels + (DQN_MIN((y * 2) + 1, src->dim.h - 1) * src->dim.w);
+		u32 *const destRow       = destPixels + (y * dest->dim.w);
+
+		for (i32 x = 0; x < dest->dim.w; x++)
+		{
+			const i32 srcX1 = DQN_MIN(x * 2, src->dim.w - 1);
+			const i32 srcX2 = DQN_MIN((x * 2) + 1, src->dim.w - 1);
+			const u32 texels[4] = {srcRow1[srcX1], srcRow1[srcX2], srcRow2[srcX1], srcRow2[srcX2]};
+
+			// Texel Format: AA BB GG RR
+			f32 r = 0, g = 0, b = 0;
+			u32 a = 2;
+			for (i32 i = 0; i < DQN_ARRAY_COUNT(texels); i++)
+			{
+				r += DTRRender_SRGB255ToLinear1((texels[i] >> 0) & 0xFF);
+				g += DTRRender_SRGB255ToLinear1((texels[i] >> 8) & 0xFF);
+				b += DTRRender_SRGB255ToLinear1((texels[i] >> 16) & 0xFF);
+				a += texels[i] >> 24;
+			}
+
+			destRow[x] = ((a >> 2) << 24) |
+			             (DTRRender_Linear1ToSRGB255(b * 0.25f) << 16) |
+			             (DTRRender_Linear1ToSRGB255(g * 0.25f) << 8) |
+			             (DTRRender_Linear1ToSRGB255(r * 0.25f) << 0);
+		}
+	}
+}
+
+// Same as BitmapBoxFilterHalfSRGB8Internal() for Linear16 texels, every channel is linear so each
+// is averaged as is.
+FILE_SCOPE void BitmapBoxFilterHalfLinear16Internal(const DTRBitmap *const src, DTRBitmap *const dest)
+{
+	DQN_ASSERT(src->bytesPerPixel == sizeof(u64) && dest->bytesPerPixel == sizeof(u64));
+	DQN_ASSERT(src->layout == DTRBitmapLayout_RowMajor && dest->layout == DTRBitmapLayout_RowMajor);
+	const u64 *const srcPixels = (u64 *)src->memory;
+	u64 *const destPixels      = (u64 *)dest->memory;
+
+	for (i32 y = 0; y < dest->dim.h; y++)
+	{
+		const u64 *const srcRow1 = srcPixels + (DQN_MIN(y * 2, src->dim.h - 1) * src->dim.w);
+		const u64 *const srcRow2 = srcPixels + (DQN_MIN((y * 2) + 1, src->dim.h - 1) * src->dim.w);
+		u64 *const destRow       = destPixels + (y * dest->dim.w);
+
+		for (i32 x = 0; x < dest->dim.w; x++)
+		{
+			const i32 srcX1 = DQN_MIN(x * 2, src->dim.w - 1);
+			const i32 srcX2 = DQN_MIN((x * 2) + 1, src->dim.w - 1);
+			const u64 texels[4] = {srcRow1[srcX1], srcRow1[srcX2], srcRow2[srcX1], srcRow2[srcX2]};
+
+			u64 result = 0;
+			for (u32 shift = 0; shift < 64; shift += 16)
+			{
+				u64 channel = 2;
+				for (i32 i = 0; i < DQN_ARRAY_COUNT(texels); i++)
+					channel += (texels[i] >> shift) & 0xFFFF;
+				result |= (channel >> 2) << shift;
+			}
+			destRow[x] = result;
+		}
+	}
+}
+
+// Allocate and box filter the mip chain of bitmap from memStack. Returns false if out of memory, in
+// which case the bitmap is left without mips.
+FILE_SCOPE bool BitmapBuildMipsInternal(DqnMemStack *const memStack, DTRBitmap *const bitmap)
+{
+	bitmap->mips    = NULL;
+	bitmap->numMips = 0;
+
+	i32 numMips = 0;
+	for (DqnV2i dim = bitmap->dim; dim.w > 1 || dim.h > 1; numMips++)
+		dim = DqnV2i_2i(DQN_MAX(dim.w / 2, 1), DQN_MAX(dim.h / 2, 1));
+
+	if (numMips == 0) return true;
+	DTRBitmap *mips = (DTRBitmap *)DqnMemStack_Push(memStack, sizeof(*mips) * numMips);
+	if (!mips) return false;
+
+	const DTRBitmap *prevLevel = bitmap;
+	for (i32 i = 0; i < numMips; i++)
+	{
+		DTRBitmap *level     = &mips[i];
+		*level               = {};
+		level->dim           = DqnV2i_2i(DQN_MAX(prevLevel->dim.w / 2, 1), DQN_MAX(prevLevel->dim.h / 2, 1));
+		level->bytesPerPixel = bitmap->bytesPerPixel;
+		level->format        = bitmap->format;
+		level->memory        = (u8 *)DqnMemStack_Push(memStack, level->dim.w * level->dim.h * level->bytesPerPixel);
+		if (!level->memory) return false;
+
+		if (level->format == DTRBitmapFormat_Linear16) BitmapBoxFilterHalfLinear16Internal(prevLevel, level);
+		else                                           BitmapBoxFilterHalfSRGB8Internal(prevLevel, level);
+		prevLevel = level;
+	}
+
+	bitmap->mips    = mips;
+	bitmap->numMips = numMips;
+	return true;
+}
+
+// Reorder the row major texels of bitmap into 4x4 tiles. The tiled texels are written in place if
+// the size doesn't need padding, otherwise they're pushed onto memStack and the padding repeats the
+// last column/row. Returns false if out of memory, in which case the bitmap is left row major.
+FILE_SCOPE bool BitmapTileInternal(DqnMemStack *const memStack, DqnMemStack *const tempStack,
+                                   DTRBitmap *const bitmap)
+{
+	DQN_ASSERT(bitmap->layout == DTRBitmapLayout_RowMajor);
+	DQN_ASSERT(bitmap->bytesPerPixel == sizeof(u32) || bitmap->bytesPerPixel == sizeof(u64));
+
+	DTRBitmap tiled        = *bitmap;
+	tiled.layout           = DTRBitmapLayout_Tiled4x4;
+	const i32 bpp          = bitmap->bytesPerPixel;
+	const i32 tiledW       = DTRAsset_BitmapPitch(&tiled);
+	const i32 tiledH       = (bitmap->dim.h + 3) & ~3;
+	const size_t size      = bitmap->dim.w * bitmap->dim.h * bpp;
+	const size_t tiledSize = tiledW * tiledH * bpp;
+
+	bool regionValid;
+	auto tmpMemRegion = DqnMemStackTempRegionGuard(tempStack, &regionValid);
+	if (!regionValid) return false;
+
+	u8 *const rowMajor = (u8 *)DqnMemStack_Push(tempStack, size);
+	if (!rowMajor) return false;
+	MemcopyInternal(rowMajor, bitmap->memory, size);
+
+	if (tiledSize != size)
+	{
+		tiled.memory = (u8 *)DqnMemStack_Push(memStack, tiledSize);
+		if (!tiled.memory) return false;
+	}
+
+	for (i32 y = 0; y < tiledH; y++)
+	{
+		const i32 srcY = DQN_MIN(y, bitmap->dim.h - 1);
+		for (i32 x = 0; x < tiledW; x++)
+		{
+			const i32 srcX = DQN_MIN(x, bitmap->dim.w - 1);
+			u8 *const dest = tiled.memory + (DTRAsset_BitmapTexelIndex(&tiled, x, y) * bpp);
+			MemcopyInternal(dest, rowMajor + ((srcX + (srcY * bitmap->dim.w)) * bpp), bpp);
+		}
+	}
+
+	*bitmap = tiled;
+	return true;
+}
+
+// Convert the straight (not premultiplied) SRGB8 texels of bitmap to premultiplied Linear16 so
+// samplers don't have to convert every fetch. Colour is premultiplied in float from the source
+// texel so it keeps 16 bits of precision. Returns false if out of memory, in which case the bitmap
+// is left as straight SRGB8.
+FILE_SCOPE bool BitmapConvertToLinear16Internal(DqnMemStack *const memStack, DTRBitmap *const bitmap)
+{
+	DQN_ASSERT(bitmap->format == DTRBitmapFormat_SRGB8 && bitmap->layout == DTRBitmapLayout_RowMajor);
+	DQN_ASSERT(bitmap->bytesPerPixel == sizeof(u32));
+
+	const i32 numTexels = bitmap->dim.w * bitmap->dim.h;
+	u64 *const linear   = (u64 *)DqnMemStack_Push(memStack, numTexels * sizeof(u64));
+	if (!linear) return false;
+
+	const u32 *const srgb = (u32 *)bitmap->memory;
+	for (i32 i = 0; i < numTexels; i++)
+	{
+		u32 texel = srgb[i];
+		f32 alpha = (f32)(texel >> 24) * DTRRENDER_INV_255 * 65535.0f;
+		u64 r     = (u64)(DTRRender_SRGB255ToLinear1((texel >> 0) & 0xFF) * alpha + 0.5f);
+		u64 g     = (u64)(DTRRender_SRGB255ToLinear1((texel >> 8) & 0xFF) * alpha + 0.5f);
+		u64 b     = (u64)(DTRRender_SRGB255ToLinear1((texel >> 16) & 0xFF) * alpha + 0.5f);
+		u64 a     = (u64)(texel >> 24) * 257; // NOTE: 255 * 257 == 65535
+		linear[i] = (a << 48) | (b << 32) | (g << 16) | (r << 0);
+	}
+
+	bitmap->memory        = (u8 *)linear;
+	bitmap->bytesPerPixel = sizeof(u64);
+	bitmap->format        = DTRBitmapFormat_Linear16;
+	return true;
+}
+
 bool DTRAsset_LoadBitmap(const PlatformAPI api, DqnMemStack *const memStack,
-                         DqnMemStack *const tempStack, DTRBitmap *bitmap, const char *const path)
+                         DqnMemStack *const tempStack, DTRBitmap *bitmap, const char *const path,
+                         const enum DTRBitmapLayout layout, const enum DTRBitmapFormat format)
 {
 	if (!bitmap || !memStack || !tempStack) return false;
 
@@ -767,6 +1070,9 @@ bool DTRAsset_LoadBitmap(const PlatformAPI api, DqnMemStack *const memStack,
 	if (!api.FileOpen(path, &file, PlatformFilePermissionFlag_Read, PlatformFileAction_OpenOnly))
 		return result;
 
+	const u32 FORCE_4_BPP = 4;
+	u8 *pixels            = NULL;
+
 	DqnMemStackTempRegionGuard tmpMemRegion = tempStack->TempRegionGuard();
 	u8 *const rawData = (u8 *)DqnMemStack_Push(tempStack, file.size);
 	size_t bytesRead  = api.FileRead(&file, rawData, file.size);
@@ -779,9 +1085,10 @@ bool DTRAsset_LoadBitmap(const PlatformAPI api, DqnMemStack *const memStack,
 	// TODO(doyle): We don't need this atm since we are still using a temp stack in this code.
 	// size_t usageBeforeSTB   = memStack->block->used;
 
-	const u32 FORCE_4_BPP = 4;
 	bitmap->bytesPerPixel = FORCE_4_BPP;
-	u8 *pixels = stbi_load_from_memory(rawData, (i32)file.size, &bitmap->dim.w, &bitmap->dim.h,
+	bitmap->layout        = DTRBitmapLayout_RowMajor;
+	bitmap->format        = DTRBitmapFormat_SRGB8;
+	pixels = stbi_load_from_memory(rawData, (i32)file.size, &bitmap->dim.w, &bitmap->dim.h,
 	                                   NULL, FORCE_4_BPP);
 	if (!pixels)
 	{
@@ -813,33 +1120,21 @@ bool DTRAsset_LoadBitmap(const PlatformAPI api, DqnMemStack *const memStack,
 
 	bitmap->memory = pixels;
 
-	const i32 pitch = bitmap->dim.w * bitmap->bytesPerPixel;
-	for (i32 y = 0; y < bitmap->dim.h; y++)
+	// NOTE: Linear16 is premultiplied straight from the source texels. If that runs out of memory
+	// the bitmap falls back to SRGB8, samplers handle either.
+	if (format != DTRBitmapFormat_Linear16 || !BitmapConvertToLinear16Internal(memStack, bitmap))
+		BitmapPremultiplySRGB8Internal(bitmap);
+
+	// NOTE: Not fatal, without mips the triangle sampler just uses the full size bitmap
+	BitmapBuildMipsInternal(memStack, bitmap);
+
+	// NOTE: Mips are box filtered row major, so they're tiled after the whole chain is built. A
+	// level that fails to tile is left row major, samplers handle either.
+	if (layout == DTRBitmapLayout_Tiled4x4)
 	{
-		u8 *const srcRow = bitmap->memory + (y * pitch);
-		for (i32 x = 0; x < bitmap->dim.w; x++)
-		{
-			u32 *pixelPtr = (u32 *)srcRow;
-			u32 pixel     = pixelPtr[x];
-
-			DqnV4 color = {};
-			color.a     = (f32)(pixel >> 24);
-			color.b     = (f32)((pixel >> 16) & 0xFF);
-			color.g     = (f32)((pixel >> 8) & 0xFF);
-			color.r     = (f32)((pixel >> 0) & 0xFF);
-
-			DqnV4 preMulColor = color;
-			preMulColor *= DTRRENDER_INV_255;
-			preMulColor = DTRRender_PreMultiplyAlphaSRGB1WithLinearConversion(preMulColor);
-			preMulColor *= 255.0f;
-
-			pixel = (((u32)preMulColor.a << 24) |
-			         ((u32)preMulColor.b << 16) |
-			         ((u32)preMulColor.g << 8) |
-			         ((u32)preMulColor.r << 0));
-
-			pixelPtr[x] = pixel;
-		}
+		BitmapTileInternal(memStack, tempStack, bitmap);
+		for (i32 i = 0; i < bitmap->numMips; i++)
+			BitmapTileInternal(memStack, tempStack, &bitmap->mips[i]);
 	}
 
 cleanup:
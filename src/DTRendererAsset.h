@@ -6,23 +6,46 @@
 #include "dqn.h"
 #include "external/stb_truetype.h"
 
+// RowMajor:  Texels are stored row by row.
+// Tiled4x4:  Texels are stored in 4x4 tiles of 16 texels, tiles and the texels in them are row
+//            major. Texels near each other in any direction are near each other in memory so fetch
+//            locality doesn't depend on the direction a texture is sampled. The width and height
+//            are padded up to a multiple of 4.
+enum DTRBitmapLayout
+{
+	DTRBitmapLayout_RowMajor,
+	DTRBitmapLayout_Tiled4x4,
+};
+
+// Texels are always premultiplied in linear space, the format decides how they're stored.
+enum DTRBitmapFormat
+{
+	DTRBitmapFormat_SRGB8,    // u32 texels, AA BB GG RR. Colour is converted back to SRGB for storage.
+	DTRBitmapFormat_Linear16, // u64 texels, AAAA BBBB GGGG RRRR. Samplers use the channels as is.
+};
+
 typedef struct DTRBitmap
 {
 	u8    *memory;
 	DqnV2i dim;
 	i32    bytesPerPixel;
+	enum DTRBitmapLayout layout;
+	enum DTRBitmapFormat format;
+
+	// Mip chain, each level is half the size of the one before it down to 1x1, mips[0] is half the
+	// size of this bitmap. NULL if the bitmap has no mips, the mips have no mips of their own.
+	struct DTRBitmap *mips;
+	i32               numMips;
 } DTRBitmap;
 
+// Faces are triangles, polygons are triangulated on load. Each face holds its indexes inline, so
+// the faces of a mesh are one contiguous index stream scanned linearly when rendering. Attributes
+// a face doesn't specify in the obj reference index 0.
 typedef struct DTRMeshFace
 {
-	i32 *vertexIndex;
-	u32 numVertexIndex;
-
-	i32 *texIndex;
-	u32 numTexIndex;
-
-	i32 *normalIndex;
-	u32  numNormalIndex;
+	u32 vertexIndex[3];
+	u32 texIndex[3];
+	u32 normalIndex[3];
 } DTRMeshFace;
 
 typedef struct DTRMesh
@@ -39,6 +62,10 @@ typedef struct DTRMesh
 	DTRMeshFace *faces;
 	u32          numFaces;
 	DTRBitmap    tex;
+
+	// Set on load, true if the faces are clockwise when seen from outside the mesh. Meshes cull
+	// faces by the side of the mesh they show instead of by winding, see DTRRenderCullMode.
+	bool clockwise;
 } DTRMesh;
 
 typedef struct DTRFont
@@ -51,8 +78,37 @@ typedef struct DTRFont
 	stbtt_packedchar *atlas;
 } DTRFont;
 
+// Texels per row of memory, rows of tiles hold pitch * 4 texels for tiled bitmaps
+inline i32 DTRAsset_BitmapPitch(const DTRBitmap *const bitmap)
+{
+	i32 result = (bitmap->layout == DTRBitmapLayout_Tiled4x4) ? ((bitmap->dim.w + 3) & ~3) : bitmap->dim.w;
+	return result;
+}
+
+// Index in texels of the texel at (x, y) in bitmap->memory
+inline i32 DTRAsset_BitmapTexelIndex(const DTRBitmap *const bitmap, const i32 x, const i32 y)
+{
+	i32 pitch = DTRAsset_BitmapPitch(bitmap);
+	if (bitmap->layout == DTRBitmapLayout_Tiled4x4)
+	{
+		i32 result = ((y & ~3) * pitch) + ((x & ~3) << 2) + ((y & 3) << 2) + (x & 3);
+		return result;
+	}
+
+	i32 result = x + (y * pitch);
+	return result;
+}
+
 void DTRAsset_InitGlobalState ();
-bool DTRAsset_LoadWavefrontObj(const PlatformAPI api, DqnMemStack *const memStack, DTRMesh *const mesh, const char *const path);
+bool DTRAsset_LoadWavefrontObj(const PlatformAPI api, PlatformJobQueue *const jobQueue, DqnMemStack *const memStack, DTRMesh *const mesh, const char *const path);
 bool DTRAsset_LoadFontToBitmap(const PlatformAPI api, DqnMemStack *const memStack, DqnMemStack *const tmpMemStack, DTRFont *const font, const char *const path, const DqnV2i bitmapDim, const DqnV2i codepointRange, const f32 sizeInPt);
-bool DTRAsset_LoadBitmap      (const PlatformAPI api, DqnMemStack *const memStack, DqnMemStack *const transMemStack, DTRBitmap *bitmap, const char *const path);
+bool DTRAsset_LoadBitmap      (const PlatformAPI api, DqnMemStack *const memStack, DqnMemStack *const transMemStack, DTRBitmap *bitmap, const char *const path, const enum DTRBitmapLayout layout = DTRBitmapLayout_RowMajor, const enum DTRBitmapFormat format = DTRBitmapFormat_SRGB8);
+
+// Binary mesh files hold the final DTRMesh arrays and load by memory mapping the file, no parsing.
+// sourceSize and sourceHash are the size and FNV-1a hash of the obj the file is compiled from, a file
+// with a different size or hash is stale and fails to load. LoadMesh loads "<objPath>.dtrm" if it's up to date, otherwise it parses
+// the obj and compiles it to "<objPath>.dtrm" for the next run.
+bool DTRAsset_LoadMesh        (const PlatformAPI api, PlatformJobQueue *const jobQueue, DqnMemStack *const memStack, DqnMemStack *const tmpMemStack, DTRMesh *const mesh, const char *const objPath);
+bool DTRAsset_LoadMeshFile    (const PlatformAPI api, DTRMesh *const mesh, const char *const path, const u64 sourceSize, const u64 sourceHash);
+bool DTRAsset_CompileMeshFile (const PlatformAPI api, DqnMemStack *const tmpMemStack, const DTRMesh *const mesh, const char *const path, const u64 sourceSize, const u64 sourceHash);
 #endif
@@ -24,11 +24,11 @@ void DTRDebug_TestMeshFaceAndVertexParser(DTRMesh *const mesh)
 			std::vector<i32> correctFace = tmpModel.face(i);
 			DTRMeshFace *myFace          = &mesh->faces[i];
 
-			DQN_ASSERT(myFace->numVertexIndex == correctFace.size());
-			for (i32 j = 0; j < (i32)myFace->numVertexIndex; j++)
+			DQN_ASSERT(DQN_ARRAY_COUNT(myFace->vertexIndex) == correctFace.size());
+			for (i32 j = 0; j < DQN_ARRAY_COUNT(myFace->vertexIndex); j++)
 			{
 				// Ensure the vertex index references are correct per face
-				DQN_ASSERT(myFace->vertexIndex[j] == correctFace[j]);
+				DQN_ASSERT(myFace->vertexIndex[j] == (u32)correctFace[j]);
 
 				Vec3f tmp           = tmpModel.vert(correctFace[j]);
 				DqnV3 correctVertex = DqnV3_3f(tmp[0], tmp[1], tmp[2]);
@@ -42,7 +42,7 @@ void DTRDebug_TestMeshFaceAndVertexParser(DTRMesh *const mesh)
 				}
 			}
 
-			for (i32 j = 0; j < (i32)myFace->numNormalIndex; j++)
+			for (i32 j = 0; j < DQN_ARRAY_COUNT(myFace->normalIndex); j++)
 			{
 				Vec3f tmp           = tmpModel.norm(i, j);
 				DqnV3 correctNormal = DqnV3_3f(tmp[0], tmp[1], tmp[2]);
@@ -59,6 +59,73 @@ void DTRDebug_TestMeshFaceAndVertexParser(DTRMesh *const mesh)
 	}
 }
 
+// Culling the back faces of a closed mesh drawn with a depth test must not change a pixel. Draw the
+// mesh at a few rotations with DTRRenderCullMode_None and DTRRenderCullMode_Back and compare.
+void DTRDebug_TestMeshBackFaceCulling(DTRMesh *const mesh, PlatformAPI *const api,
+                                      PlatformJobQueue *const jobQueue, DqnMemStack *const tempStack)
+{
+	if (DTR_DEBUG)
+	{
+		if (!mesh || !api || !jobQueue || !tempStack) DQN_ASSERT(DQN_INVALID_CODE_PATH);
+		if (mesh->numFaces == 0) return;
+
+		bool regionValid;
+		auto memRegion = DqnMemStackTempRegionGuard(tempStack, &regionValid);
+		if (!regionValid) return;
+
+		const i32 DIM         = 128;
+		const i32 PIXEL_BYTES = DIM * DIM * 4;
+		u8 *pixels[2]         = {};
+		for (i32 i = 0; i < DQN_ARRAY_COUNT(pixels); i++)
+		{
+			pixels[i] = (u8 *)DqnMemStack_Push(tempStack, PIXEL_BYTES);
+			if (!pixels[i]) return;
+		}
+
+		f32 *zBuffer = (f32 *)DqnMemStack_Push(tempStack, DIM * DIM * sizeof(*zBuffer));
+		if (!zBuffer) return;
+
+		DTRRenderLight lighting = {};
+		lighting.mode           = DTRRenderShadingMode_Gouraud;
+		lighting.vector         = DqnV3_Normalise(DqnV3_3f(1, -1, 1.0f));
+		lighting.color          = DqnV4_4f(1, 1, 1, 1);
+
+		DTRRenderTransform transform = DTRRender_DefaultTransform();
+		transform.scale              = DqnV3_1f(1);
+		transform.anchor             = DqnV3_3f(0, 1, 0);
+
+		const f32 ROTATIONS[] = {0, 90, 180, 270};
+		for (i32 rotationIndex = 0; rotationIndex < DQN_ARRAY_COUNT(ROTATIONS); rotationIndex++)
+		{
+			transform.rotation = ROTATIONS[rotationIndex];
+			for (i32 i = 0; i < DQN_ARRAY_COUNT(pixels); i++)
+			{
+				DTRRenderBuffer renderBuffer = {};
+				renderBuffer.width           = DIM;
+				renderBuffer.height          = DIM;
+				renderBuffer.bytesPerPixel   = 4;
+				renderBuffer.memory          = pixels[i];
+				renderBuffer.zBuffer         = zBuffer;
+				renderBuffer.depthFormat     = DTRRenderDepthFormat_F32;
+
+				DTRRenderContext context = {};
+				context.renderBuffer     = &renderBuffer;
+				context.tempStack        = tempStack;
+				context.api              = api;
+				context.jobQueue         = jobQueue;
+				context.blendMode        = DTRRenderBlendMode_Opaque;
+				context.cullMode         = (i == 0) ? DTRRenderCullMode_None : DTRRenderCullMode_Back;
+
+				DTRRender_Clear(context, DqnV3_1f(0), DTRRenderClearFlag_Color | DTRRenderClearFlag_Depth);
+				DTRRender_Mesh(context, jobQueue, mesh, lighting, DqnV3_1f(0), transform);
+			}
+
+			for (i32 i = 0; i < PIXEL_BYTES; i++)
+				DQN_ASSERT(pixels[0][i] == pixels[1][i]);
+		}
+	}
+}
+
 void DTRDebug_DumpZBuffer(DTRRenderBuffer *const renderBuffer, DqnMemStack *const tempStack)
 {
 	if (DTR_DEBUG)
@@ -87,7 +154,15 @@ void DTRDebug_DumpZBuffer(DTRRenderBuffer *const renderBuffer, DqnMemStack *cons
 			for (i32 i = 0; i < renderBuffer->width * renderBuffer->height; i++)
 			{
 
-				f32 zValue = renderBuffer->zBuffer[i];
+				const i32 blockX = (i % renderBuffer->width) / DTRRENDER_DEPTH_BLOCK_SIZE;
+				const i32 blockY = (i / renderBuffer->width) / DTRRENDER_DEPTH_BLOCK_SIZE;
+				if (DTRRender_DepthBlockIsStale(
+				        renderBuffer, blockX + (blockY * DTRRender_DepthBlockPitch(renderBuffer))))
+				{
+					continue;
+				}
+
+				f32 zValue = DTRRender_GetDepth(renderBuffer, i);
 				if (zValue == DQN_F32_MIN) continue;
 				i32 chWritten = Dqn_sprintf(bufPtr, "index %06d: %05.5f\n", i, zValue);
 				if ((bufPtr + chWritten) > (bufString + bufSize))
@@ -241,12 +316,16 @@ void DTRDebug_Update(DTRState *const state,
 		DTRDebug_PushText("");
 
 		DTRDebug_PushText("SSE2Support: %s", (globalDTRPlatformFlags.canUseSSE2) ? "true" : "false");
+		DTRDebug_PushText("AVX2Support: %s", (globalDTRPlatformFlags.canUseAVX2) ? "true" : "false");
 		DTRDebug_PushText("RDTSCSupport: %s", (globalDTRPlatformFlags.canUseRdtsc) ? "true" : "false");
 		DTRDebug_PushText("");
 
 		DTRDebug_PushText("TotalSetPixels: %'lld",    debug->totalSetPixels);
 		DTRDebug_PushText("SetPixelsPerFrame: %'lld", debug->counter[DTRDebugCounter_SetPixels]);
 		DTRDebug_PushText("TrianglesRendered: %'lld", debug->counter[DTRDebugCounter_RenderTriangle]);
+		DTRDebug_PushText("TrianglesCulledBackFace: %'lld", debug->counter[DTRDebugCounter_CulledBackFace]);
+		DTRDebug_PushText("TrianglesCulledZeroArea: %'lld", debug->counter[DTRDebugCounter_CulledZeroArea]);
+		DTRDebug_PushText("TrianglesCulledOffScreen: %'lld", debug->counter[DTRDebugCounter_CulledOffScreen]);
 		DTRDebug_PushText("");
 
 		DTRDebugCycles emptyDebugCycles = {};
@@ -36,6 +36,9 @@ enum DTRDebugCounter
 {
 	DTRDebugCounter_SetPixels,
 	DTRDebugCounter_RenderTriangle,
+	DTRDebugCounter_CulledBackFace,
+	DTRDebugCounter_CulledZeroArea,
+	DTRDebugCounter_CulledOffScreen,
 	DTRDebugCounter_Count,
 };
 
@@ -105,6 +108,7 @@ typedef struct DTRDebug
 extern DTRDebug globalDebug;
 
 void        DTRDebug_TestMeshFaceAndVertexParser(struct DTRMesh *const mesh);
+void        DTRDebug_TestMeshBackFaceCulling    (struct DTRMesh *const mesh, struct PlatformAPI *const api, struct PlatformJobQueue *const jobQueue, struct DqnMemStack *const tempStack);
 void        DTRDebug_DumpZBuffer                (struct DTRRenderBuffer *const renderBuffer, struct DqnMemStack *const transMemStack);
 void        DTRDebug_RunTinyRenderer            ();
 void        DTRDebug_PushText                   (const char *const formatStr, ...);
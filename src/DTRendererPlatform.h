@@ -2,7 +2,12 @@
 #define DRENDERER_PLATFORM_H
 
 #include "dqn.h"
-#include <intrin.h>
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#else
+	#include <x86intrin.h>
+#endif
 
 typedef void PlatformAPI_DieGracefully();
 
@@ -29,11 +34,21 @@ typedef struct PlatformFile
 	u32     permissionFlags;
 } PlatformFile;
 
+// A whole file mapped into memory. Writes to memory are copy on write, they're private to the
+// process and never reach the file, so loaders can patch the data in place.
+typedef struct PlatformFileMap
+{
+	u8     *memory;
+	size_t  size;
+} PlatformFileMap;
+
 // File I/O API
 typedef bool   PlatformAPI_FileOpen (const char *const path, PlatformFile *const file, const u32 permissionFlags, const enum PlatformFileAction actionFlags);
 typedef size_t PlatformAPI_FileRead (PlatformFile *const file, u8 *const buf, const size_t bytesToRead);     // Return bytes read
 typedef size_t PlatformAPI_FileWrite(PlatformFile *const file, u8 *const buf, const size_t numBytesToWrite); // Return bytes read
 typedef void   PlatformAPI_FileClose(PlatformFile *const file);
+typedef bool   PlatformAPI_FileMap  (const char *const path, PlatformFileMap *const map);
+typedef void   PlatformAPI_FileUnmap(PlatformFileMap *const map);
 typedef void   PlatformAPI_Print    (const char *const string);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -51,9 +66,15 @@ typedef struct PlatformJob
 } PlatformJob;
 
 // Multithreading API
-typedef bool PlatformAPI_QueueAddJob           (PlatformJobQueue *const queue, const PlatformJob job);
-typedef bool PlatformAPI_QueueTryExecuteNextJob(PlatformJobQueue *const queue);
-typedef bool PlatformAPI_QueueAllJobsComplete  (PlatformJobQueue *const queue);
+// Jobs can only be added by the main thread. QueueAddJobs publishes as many of the jobs as fit in
+// the queue with one wake up of the workers and returns the number added. QueueTryExecuteNextJob
+// returns true if the calling thread executed a job and QueueWaitAllJobsComplete executes jobs until
+// there are none left to take, then sleeps until the jobs in flight on other threads have completed.
+typedef bool PlatformAPI_QueueAddJob             (PlatformJobQueue *const queue, const PlatformJob job);
+typedef u32  PlatformAPI_QueueAddJobs            (PlatformJobQueue *const queue, const PlatformJob *const jobs, const u32 numJobs);
+typedef bool PlatformAPI_QueueTryExecuteNextJob  (PlatformJobQueue *const queue);
+typedef bool PlatformAPI_QueueAllJobsComplete    (PlatformJobQueue *const queue);
+typedef void PlatformAPI_QueueWaitAllJobsComplete(PlatformJobQueue *const queue);
 
 typedef u32  PlatformAPI_AtomicCompareSwap(u32 volatile *dest, u32 swapVal, u32 compareVal);
 
@@ -76,12 +97,16 @@ typedef struct PlatformAPI
 	PlatformAPI_FileRead    *FileRead;
 	PlatformAPI_FileWrite   *FileWrite;
 	PlatformAPI_FileClose   *FileClose;
+	PlatformAPI_FileMap     *FileMap;
+	PlatformAPI_FileUnmap   *FileUnmap;
 	PlatformAPI_Print       *Print;
 
-	PlatformAPI_QueueAddJob            *QueueAddJob;
-	PlatformAPI_QueueTryExecuteNextJob *QueueTryExecuteNextJob;
-	PlatformAPI_QueueAllJobsComplete   *QueueAllJobsComplete;
-	PlatformAPI_AtomicCompareSwap      *AtomicCompareSwap;
+	PlatformAPI_QueueAddJob              *QueueAddJob;
+	PlatformAPI_QueueAddJobs             *QueueAddJobs;
+	PlatformAPI_QueueTryExecuteNextJob   *QueueTryExecuteNextJob;
+	PlatformAPI_QueueAllJobsComplete     *QueueAllJobsComplete;
+	PlatformAPI_QueueWaitAllJobsComplete *QueueWaitAllJobsComplete;
+	PlatformAPI_AtomicCompareSwap        *AtomicCompareSwap;
 
 	PlatformAPI_LockInit    *LockInit;
 	PlatformAPI_LockAcquire *LockAcquire;
@@ -91,6 +116,20 @@ typedef struct PlatformAPI
 	PlatformAPI_DieGracefully *DieGracefully;
 } PlatformAPI;
 
+// Add all the jobs to the queue in as few batches as possible, the calling thread executes jobs
+// whilst the queue is full.
+inline void Platform_QueueAddAllJobs(const PlatformAPI *const api, PlatformJobQueue *const queue,
+                                     const PlatformJob *const jobs, const u32 numJobs)
+{
+	u32 numAdded = 0;
+	for (;;)
+	{
+		numAdded += api->QueueAddJobs(queue, jobs + numAdded, numJobs - numAdded);
+		if (numAdded >= numJobs) break;
+		api->QueueTryExecuteNextJob(queue);
+	}
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Platform Input
 ////////////////////////////////////////////////////////////////////////////////
@@ -144,6 +183,7 @@ typedef struct PlatformFlags
 	bool executableReloaded;
 	bool canUseRdtsc;
 	bool canUseSSE2;
+	bool canUseAVX2;
 } PlatformFlags;
 
 typedef struct PlatformInput
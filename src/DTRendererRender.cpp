@@ -7,21 +7,30 @@
 #include "external/stb_rect_pack.h"
 #include "external/stb_truetype.h"
 
-#include <intrin.h>
-
 FILE_SCOPE const f32 COLOR_EPSILON = 0.9f;
 
+// NOTE: MSVC allows AVX2 intrinsics in any function, GCC/Clang need the function to opt in. Only call
+// these functions if globalDTRPlatformFlags.canUseAVX2 is set.
+#if defined(_MSC_VER)
+	#define DTR_TARGET_AVX2
+#else
+	#define DTR_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
 typedef struct RenderLightInternal
 {
 	enum DTRRenderShadingMode mode;
 	DqnV3 vector;
 
-	DqnV3 normals[4];
-	u32 numNormals;
+	// NOTE: Gouraud only, the light intensity of each vertex, i.e. dot(normal, vector), which the
+	// mesh vertex stage calculates once per vertex instead of once per face.
+	f32 intensities[4];
+	u32 numIntensities;
 } RenderLightInternal;
 
 
-inline void Make3PointsClockwise(DqnV3 *p1, DqnV3 *p2, DqnV3 *p3)
+// Returns true if p2 and p3 were swapped, the caller must swap their attributes to match.
+inline bool Make3PointsClockwise(DqnV3 *p1, DqnV3 *p2, DqnV3 *p3)
 {
 	f32 area2Times = ((p2->x - p1->x) * (p2->y + p1->y)) +
 	                 ((p3->x - p2->x) * (p3->y + p2->y)) +
@@ -30,7 +39,10 @@ inline void Make3PointsClockwise(DqnV3 *p1, DqnV3 *p2, DqnV3 *p3)
 	{
 		// Clockwise swap any point to make it clockwise
 		DQN_SWAP(DqnV3, *p2, *p3);
+		return true;
 	}
+
+	return false;
 }
 
 FILE_SCOPE inline DqnV4 PreMultiplyAlpha1(const DqnV4 color)
@@ -120,6 +132,135 @@ inline DqnV4 DTRRender_PreMultiplyAlphaSRGB1WithLinearConversion(DqnV4 color)
 	return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Color Conversion Tables
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// NOTE: Linear [0->1] is encoded back to 8 bit SRGB by bucketing the bits of the float. Each bucket
+// spans 1/128th of a power of 2 in [2^-16, 1) which is narrow enough to hold at most 1 step between
+// consecutive 8 bit values, so storing the value at the start of the bucket and the point it steps
+// up reproduces (u32)(sqrt(x) * 255) exactly. Anything below 2^-16 encodes to 0 since 1/(255^2) is
+// the smallest value that encodes to 1.
+#define COLOR_ENCODE_MANTISSA_BITS 7
+#define COLOR_ENCODE_BUCKET_SHIFT  (23 - COLOR_ENCODE_MANTISSA_BITS)
+#define COLOR_ENCODE_FIRST_BUCKET  (111 << COLOR_ENCODE_MANTISSA_BITS) // Biased exponent of 2^-16
+#define COLOR_ENCODE_NUM_BUCKETS   ((127 << COLOR_ENCODE_MANTISSA_BITS) - COLOR_ENCODE_FIRST_BUCKET)
+#define COLOR_ENCODE_ONE_F32_BITS  0x3F800000
+
+typedef struct ColorTablesInternal
+{
+	f32 srgb255ToLinear1[256];
+
+	// Format: (threshold << 8) | base, threshold is the low 16 bits of the float at which the bucket
+	// encodes to (base + 1), or 0x10000 if it never does.
+	u32 linear1ToSRGB255[COLOR_ENCODE_NUM_BUCKETS];
+	bool init;
+} ColorTablesInternal;
+
+FILE_SCOPE ColorTablesInternal globalColorTables;
+
+FILE_SCOPE inline f32 F32FromBitsInternal(const u32 bits)
+{
+	f32 result;
+	memcpy(&result, &bits, sizeof(result));
+	return result;
+}
+
+FILE_SCOPE inline u32 LinearToSRGB255ReferenceInternal(const f32 val)
+{
+	f32 result = DqnMath_Sqrtf(val) * 255.0f;
+	if (result > 255.0f) result = 255.0f;
+	return (u32)result;
+}
+
+void DTRRender_InitColorTables()
+{
+	if (globalColorTables.init) return;
+
+	for (u32 i = 0; i < DQN_ARRAY_COUNT(globalColorTables.srgb255ToLinear1); i++)
+		globalColorTables.srgb255ToLinear1[i] = DTRRender_SRGB1ToLinearSpacef((f32)i * DTRRENDER_INV_255);
+
+	const u32 BUCKET_SIZE = (1 << COLOR_ENCODE_BUCKET_SHIFT);
+	for (u32 bucket = 0; bucket < COLOR_ENCODE_NUM_BUCKETS; bucket++)
+	{
+		u32 start = (COLOR_ENCODE_FIRST_BUCKET + bucket) << COLOR_ENCODE_BUCKET_SHIFT;
+		u32 base  = LinearToSRGB255ReferenceInternal(F32FromBitsInternal(start));
+
+		// NOTE: Binary search for the first float in the bucket that steps up to the next value
+		u32 lo = start;
+		u32 hi = start + BUCKET_SIZE;
+		while (lo < hi)
+		{
+			u32 mid = lo + ((hi - lo) / 2);
+			if (LinearToSRGB255ReferenceInternal(F32FromBitsInternal(mid)) > base) hi = mid;
+			else                                                                     lo = mid + 1;
+		}
+
+		DQN_ASSERT(LinearToSRGB255ReferenceInternal(F32FromBitsInternal(start + BUCKET_SIZE - 1)) <= base + 1);
+		globalColorTables.linear1ToSRGB255[bucket] = ((lo - start) << 8) | base;
+	}
+
+	globalColorTables.init = true;
+}
+
+inline f32 DTRRender_SRGB255ToLinear1(const u32 val)
+{
+	DQN_ASSERT(globalColorTables.init && val <= 255);
+	f32 result = globalColorTables.srgb255ToLinear1[val];
+	return result;
+}
+
+inline u32 DTRRender_Linear1ToSRGB255(const f32 val)
+{
+	DQN_ASSERT(globalColorTables.init);
+	i32 bits;
+	memcpy(&bits, &val, sizeof(bits));
+	if (bits >= COLOR_ENCODE_ONE_F32_BITS) return 255;
+
+	i32 bucket = (bits >> COLOR_ENCODE_BUCKET_SHIFT) - COLOR_ENCODE_FIRST_BUCKET;
+	if (bucket < 0) return 0;
+
+	u32 entry  = globalColorTables.linear1ToSRGB255[bucket];
+	u32 result = (entry & 0xFF) + (((u32)bits & 0xFFFF) >= (entry >> 8));
+	return result;
+}
+
+// Texel Format: AA BB GG RR, returns RGB in linear space and alpha in [0->1]
+FILE_SCOPE inline DqnV4 TexelToLinear1Internal(const u32 texel)
+{
+	DqnV4 result;
+	result.a = (f32)(texel >> 24) * DTRRENDER_INV_255;
+	result.b = DTRRender_SRGB255ToLinear1((texel >> 16) & 0xFF);
+	result.g = DTRRender_SRGB255ToLinear1((texel >> 8) & 0xFF);
+	result.r = DTRRender_SRGB255ToLinear1((texel >> 0) & 0xFF);
+	return result;
+}
+
+// Returns the texel at index in bitmap->memory with RGB in linear space and alpha in [0->1]
+FILE_SCOPE inline DqnV4 BitmapTexelToLinear1Internal(const DTRBitmap *const bitmap, const i32 index)
+{
+	if (bitmap->format == DTRBitmapFormat_SRGB8)
+		return TexelToLinear1Internal(((u32 *)bitmap->memory)[index]);
+
+	// Texel Format: AAAA BBBB GGGG RRRR
+	DQN_ASSERT(bitmap->format == DTRBitmapFormat_Linear16);
+	u64 texel = ((u64 *)bitmap->memory)[index];
+	DqnV4 result;
+	result.a = (f32)((texel >> 48) & 0xFFFF) * DTRRENDER_INV_65535;
+	result.b = (f32)((texel >> 32) & 0xFFFF) * DTRRENDER_INV_65535;
+	result.g = (f32)((texel >> 16) & 0xFFFF) * DTRRENDER_INV_65535;
+	result.r = (f32)((texel >> 0) & 0xFFFF) * DTRRENDER_INV_65535;
+	return result;
+}
+
+// Convert the color of a draw call to linear space and premultiply it unless the blend mode of the
+// context says it's premultiplied already.
+FILE_SCOPE inline DqnV4 DrawColorToLinearInternal(const DTRRenderContext context, const DqnV4 color)
+{
+	DqnV4 result = DTRRender_SRGB1ToLinearSpaceV4(color);
+	if (context.blendMode != DTRRenderBlendMode_PreMultiplied) result = PreMultiplyAlpha1(result);
+	return result;
+}
+
 // IMPORTANT(doyle): Color is expected to be premultiplied already
 FILE_SCOPE inline void SetPixel(DTRRenderContext context, const i32 x, const i32 y,
                                 DqnV4 color, const enum ColorSpace colorSpace = ColorSpace_SRGB)
@@ -133,58 +274,38 @@ FILE_SCOPE inline void SetPixel(DTRRenderContext context, const i32 x, const i32
 	u32 *const bitmapPtr = (u32 *)renderBuffer->memory;
 	const u32 pitchInU32 = (renderBuffer->width * renderBuffer->bytesPerPixel) / 4;
 
-	// If some alpha is involved, we need to apply gamma correction, but if the
-	// new pixel is totally opaque or invisible then we're just flat out
-	// overwriting/keeping the state of the pixel so we can save cycles by skipping.
-	bool needGammaFix = (color.a > 0.0f || color.a < 1.0f + COLOR_EPSILON) && (colorSpace == ColorSpace_SRGB);
-	if (needGammaFix) color = DTRRender_SRGB1ToLinearSpaceV4(color);
-
-	u32 src = bitmapPtr[x + (y * pitchInU32)];
-	f32 srcR = (f32)((src >> 16) & 0xFF) * DTRRENDER_INV_255;
-	f32 srcG = (f32)((src >> 8) & 0xFF)  * DTRRENDER_INV_255;
-	f32 srcB = (f32)((src >> 0) & 0xFF)  * DTRRENDER_INV_255;
-
-	srcR = DTRRender_SRGB1ToLinearSpacef(srcR);
-	srcG = DTRRender_SRGB1ToLinearSpacef(srcG);
-	srcB = DTRRender_SRGB1ToLinearSpacef(srcB);
-
-	// NOTE(doyle): AlphaBlend equations is (alpha * new) + (1 - alpha) * src.
-	// IMPORTANT(doyle): We pre-multiply so we can take out the (alpha * new)
-	f32 invANorm = 1 - color.a;
-	f32 destR    = color.r + (invANorm * srcR);
-	f32 destG    = color.g + (invANorm * srcG);
-	f32 destB    = color.b + (invANorm * srcB);
-
-	destR = DTRRender_LinearToSRGB1Spacef(destR) * 255.0f;
-	destG = DTRRender_LinearToSRGB1Spacef(destG) * 255.0f;
-	destB = DTRRender_LinearToSRGB1Spacef(destB) * 255.0f;
-
-	if (DTR_DEBUG)
-	{
-		DQN_ASSERT((destR - 255.0f) < COLOR_EPSILON);
-		DQN_ASSERT((destG - 255.0f) < COLOR_EPSILON);
-		DQN_ASSERT((destB - 255.0f) < COLOR_EPSILON);
-	}
-
-	if (destR > 255.0f)
-	{
-		destR = 255;
-	}
+	if (colorSpace == ColorSpace_SRGB) color = DTRRender_SRGB1ToLinearSpaceV4(color);
 
-	if (destG > 255.0f)
+	f32 destR = color.r;
+	f32 destG = color.g;
+	f32 destB = color.b;
+	if (context.blendMode != DTRRenderBlendMode_Opaque)
 	{
-		destG = 255;
+		u32 src  = bitmapPtr[x + (y * pitchInU32)];
+		f32 srcR = DTRRender_SRGB255ToLinear1((src >> 16) & 0xFF);
+		f32 srcG = DTRRender_SRGB255ToLinear1((src >> 8) & 0xFF);
+		f32 srcB = DTRRender_SRGB255ToLinear1((src >> 0) & 0xFF);
+
+		// NOTE(doyle): AlphaBlend equations is (alpha * new) + (1 - alpha) * src.
+		// IMPORTANT(doyle): We pre-multiply so we can take out the (alpha * new)
+		f32 invANorm = (context.blendMode == DTRRenderBlendMode_Additive) ? 1.0f : 1 - color.a;
+		destR        = color.r + (invANorm * srcR);
+		destG        = color.g + (invANorm * srcG);
+		destB        = color.b + (invANorm * srcB);
 	}
 
-	if (destB > 255.0f)
+	// NOTE: Additive blending saturates, the encode clamps to 255
+	if (DTR_DEBUG && context.blendMode != DTRRenderBlendMode_Additive)
 	{
-		destB = 255;
+		DQN_ASSERT((destR - 1.0f) < COLOR_EPSILON);
+		DQN_ASSERT((destG - 1.0f) < COLOR_EPSILON);
+		DQN_ASSERT((destB - 1.0f) < COLOR_EPSILON);
 	}
 
-	u32 pixel = // ((u32)(destA) << 24 |
-	             (u32)(destR) << 16 |
-	             (u32)(destG) << 8 |
-	             (u32)(destB) << 0;
+	u32 pixel = // (DTRRender_Linear1ToSRGB255(destA) << 24 |
+	             DTRRender_Linear1ToSRGB255(destR) << 16 |
+	             DTRRender_Linear1ToSRGB255(destG) << 8 |
+	             DTRRender_Linear1ToSRGB255(destB) << 0;
 	bitmapPtr[x + (y * pitchInU32)] = pixel;
 
 	DTRDebug_CounterIncrement(DTRDebugCounter_SetPixels);
@@ -204,8 +325,7 @@ void DTRRender_Text(DTRRenderContext context,
 	if (len == -1) len = DqnStr_Len(text);
 
 	i32 index = 0;
-	color = DTRRender_SRGB1ToLinearSpaceV4(color);
-	color = PreMultiplyAlpha1(color);
+	color = DrawColorToLinearInternal(context, color);
 	while (index < len)
 	{
 		if (text[index] < font.codepointRange.min &&
@@ -298,8 +418,7 @@ void DTRRender_Line(DTRRenderContext context, DqnV2i a,
 	if (!renderBuffer) return;
 	DTR_DEBUG_EP_TIMED_FUNCTION();
 
-	color = DTRRender_SRGB1ToLinearSpaceV4(color);
-	color = PreMultiplyAlpha1(color);
+	color = DrawColorToLinearInternal(context, color);
 
 	bool yTallerThanX = false;
 	if (DQN_ABS(a.x - b.x) < DQN_ABS(a.y - b.y))
@@ -412,6 +531,224 @@ FILE_SCOPE DqnRect GetBoundingBox(const DqnV2 *const pList, const i32 numP)
 	return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Quad Row Bands
+////////////////////////////////////////////////////////////////////////////////
+// NOTE: Rectangles and bitmaps are setup once, then drawn in bands of rows. Big quads in a
+// multithreaded context draw each band as a job, every band owns its rows so no pixel is shared.
+// Small quads aren't worth the dispatch and are drawn inline.
+#define RENDER_QUAD_ROWS_PER_JOB         32
+#define RENDER_QUAD_MULTITHREAD_MIN_AREA (128 * 128)
+
+typedef struct RenderQuadSetup
+{
+	RectPoints rectPoints;
+	DqnV2i     min; // The clipped pixel bounds to draw in, max is exclusive
+	DqnV2i     max;
+	DqnV4      color; // Linear, see DrawColorToLinearInternal()
+	bool       rotated;
+
+	// Bitmaps only, maps a pixel back to its texel
+	DTRBitmap *bitmap;
+	DqnV2      rectBasis;
+	DqnV2      xAxisRelToBasis;
+	DqnV2      yAxisRelToBasis;
+	f32        invXAxisLenSq;
+	f32        invYAxisLenSq;
+} RenderQuadSetup;
+
+// Draw the rows [startY, endY) of the quad
+typedef void RenderQuadRowsCallback(DTRRenderContext context, const RenderQuadSetup *const quad,
+                                    const i32 startY, const i32 endY);
+
+typedef struct RenderQuadRowsJob
+{
+	DTRRenderContext        context;
+	const RenderQuadSetup  *quad;
+	RenderQuadRowsCallback *callback;
+	i32                     startY;
+	i32                     endY;
+} RenderQuadRowsJob;
+
+void MultiThreadedQuadRows(PlatformJobQueue *const queue, void *const userData)
+{
+	if (!queue || !userData)
+	{
+		DQN_ASSERT(DQN_INVALID_CODE_PATH);
+		return;
+	}
+
+	RenderQuadRowsJob *job = (RenderQuadRowsJob *)userData;
+	job->callback(job->context, job->quad, job->startY, job->endY);
+}
+
+// Draw all the rows of the quad with callback, split into jobs if the quad is big enough.
+FILE_SCOPE void DrawQuadRowsInternal(DTRRenderContext context, const RenderQuadSetup *const quad,
+                                     RenderQuadRowsCallback *const callback)
+{
+	const i32 numRows = quad->max.y - quad->min.y;
+	const i32 area    = (quad->max.x - quad->min.x) * numRows;
+	if (numRows <= 0 || area <= 0) return;
+
+	const i32 numJobs = (numRows + RENDER_QUAD_ROWS_PER_JOB - 1) / RENDER_QUAD_ROWS_PER_JOB;
+	if (!context.multithread || !context.jobQueue || !context.tempStack || numJobs <= 1 ||
+	    area < RENDER_QUAD_MULTITHREAD_MIN_AREA)
+	{
+		callback(context, quad, quad->min.y, quad->max.y);
+		return;
+	}
+
+	bool regionValid;
+	auto tempRegion = DqnMemStackTempRegionGuard(context.tempStack, &regionValid);
+	RenderQuadRowsJob *jobDataList = (regionValid) ? (RenderQuadRowsJob *)DqnMemStack_Push(context.tempStack, sizeof(*jobDataList) * numJobs) : NULL;
+	PlatformJob *jobList           = (regionValid) ? (PlatformJob *)DqnMemStack_Push(context.tempStack, sizeof(*jobList) * numJobs) : NULL;
+	if (!jobDataList || !jobList)
+	{
+		callback(context, quad, quad->min.y, quad->max.y);
+		return;
+	}
+
+	for (i32 i = 0; i < numJobs; i++)
+	{
+		RenderQuadRowsJob *jobData = &jobDataList[i];
+		jobData->context           = context;
+		jobData->quad              = quad;
+		jobData->callback          = callback;
+		jobData->startY            = quad->min.y + (i * RENDER_QUAD_ROWS_PER_JOB);
+		jobData->endY              = DQN_MIN(jobData->startY + RENDER_QUAD_ROWS_PER_JOB, quad->max.y);
+
+		jobList[i].callback = MultiThreadedQuadRows;
+		jobList[i].userData = jobData;
+	}
+
+	Platform_QueueAddAllJobs(context.api, context.jobQueue, jobList, numJobs);
+	context.api->QueueWaitAllJobsComplete(context.jobQueue);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Quad Spans
+////////////////////////////////////////////////////////////////////////////////
+// NOTE: A pixel p is inside a quad if dot(line, p - origin) >= 0 for all of its edges. Along a
+// row that is linear in x, so every edge bounds the row from one side and the covered pixels form
+// a single span. The row terms are stepped incrementally and the span ends are nudged onto the
+// exact inside test, so only covered pixels are ever visited.
+typedef struct QuadSpanEdges
+{
+	DqnV2 originList[4];
+	DqnV2 lineList[4];
+	f32   rowDotList[4]; // dot(line, (0, y) - origin) of the current row, steps by line.y per row
+} QuadSpanEdges;
+
+FILE_SCOPE QuadSpanEdges QuadSpanEdgesInternal(const RectPoints *const rectPoints, const i32 y)
+{
+	QuadSpanEdges result      = {};
+	const i32 RECT_PLIST_SIZE = DQN_ARRAY_COUNT(rectPoints->pList);
+	DQN_ASSERT(RECT_PLIST_SIZE == DQN_ARRAY_COUNT(result.lineList));
+
+	for (i32 i = 0; i < RECT_PLIST_SIZE; i++)
+	{
+		result.originList[i] = rectPoints->pList[i];
+		result.lineList[i]   = rectPoints->pList[(i + 1) % RECT_PLIST_SIZE] - result.originList[i];
+		result.rowDotList[i] = DqnV2_Dot(result.lineList[i], DqnV2_2i(0, y) - result.originList[i]);
+	}
+
+	return result;
+}
+
+FILE_SCOPE inline bool QuadSpanIsInsideInternal(const QuadSpanEdges *const edges, const i32 x,
+                                                const i32 y)
+{
+	for (i32 i = 0; i < DQN_ARRAY_COUNT(edges->lineList); i++)
+	{
+		DqnV2 axis = DqnV2_2i(x, y) - edges->originList[i];
+		if (DqnV2_Dot(edges->lineList[i], axis) < 0) return false;
+	}
+
+	return true;
+}
+
+// Get the covered span [spanMinX, spanMaxX) of row y clipped to [minX, maxX) and step the edges to
+// the row after. Returns false if no pixel of the row is covered.
+FILE_SCOPE bool QuadSpanNextRowInternal(QuadSpanEdges *const edges, const i32 y, const i32 minX,
+                                        const i32 maxX, i32 *const spanMinX, i32 *const spanMaxX)
+{
+	f32 spanMinXf  = (f32)minX;
+	f32 spanMaxXf  = (f32)maxX;
+	bool rowCulled = false;
+	for (i32 i = 0; i < DQN_ARRAY_COUNT(edges->lineList); i++)
+	{
+		const DqnV2 line  = edges->lineList[i];
+		const f32 rowDot  = edges->rowDotList[i];
+		edges->rowDotList[i] += line.y;
+
+		// NOTE: Solve (line.x * x) + rowDot >= 0 for x. Edges parallel to the row are either
+		// entirely in or out, evaluate them exactly since x does not contribute.
+		if (line.x > 0)
+		{
+			spanMinXf = DQN_MAX(spanMinXf, ceilf(-rowDot / line.x));
+		}
+		else if (line.x < 0)
+		{
+			spanMaxXf = DQN_MIN(spanMaxXf, floorf(-rowDot / line.x) + 1);
+		}
+		else if (DqnV2_Dot(line, DqnV2_2i(minX, y) - edges->originList[i]) < 0)
+		{
+			rowCulled = true;
+		}
+	}
+	if (rowCulled) return false;
+
+	i32 startX = (i32)DqnMath_Clampf(spanMinXf, (f32)minX, (f32)maxX);
+	i32 endX   = (i32)DqnMath_Clampf(spanMaxXf, (f32)minX, (f32)maxX);
+	if (endX < startX) endX = startX;
+
+	// NOTE: Rounding (and the incremental row terms) can leave the span a pixel off the exact test.
+	// Shrink it onto covered pixels, then grow it across any covered neighbours.
+	while (startX < endX && !QuadSpanIsInsideInternal(edges, startX, y))   startX++;
+	while (endX > startX && !QuadSpanIsInsideInternal(edges, endX - 1, y)) endX--;
+	if (startX == endX)
+	{
+		if (startX < maxX && QuadSpanIsInsideInternal(edges, startX, y))
+		{
+			endX = startX + 1;
+		}
+		else if (startX > minX && QuadSpanIsInsideInternal(edges, startX - 1, y))
+		{
+			startX--;
+			endX = startX + 1;
+		}
+		else
+		{
+			return false;
+		}
+	}
+	while (startX > minX && QuadSpanIsInsideInternal(edges, startX - 1, y)) startX--;
+	while (endX < maxX   && QuadSpanIsInsideInternal(edges, endX, y))       endX++;
+
+	*spanMinX = startX;
+	*spanMaxX = endX;
+	return true;
+}
+
+FILE_SCOPE void RectangleRowsInternal(DTRRenderContext context, const RenderQuadSetup *const quad,
+                                      const i32 startY, const i32 endY)
+{
+	QuadSpanEdges edges = QuadSpanEdgesInternal(&quad->rectPoints, startY);
+	for (i32 bufferY = startY; bufferY < endY; bufferY++)
+	{
+		i32 spanMinX = quad->min.x;
+		i32 spanMaxX = quad->max.x;
+		if (quad->rotated &&
+		    !QuadSpanNextRowInternal(&edges, bufferY, quad->min.x, quad->max.x, &spanMinX, &spanMaxX))
+		{
+			continue;
+		}
+
+		for (i32 bufferX = spanMinX; bufferX < spanMaxX; bufferX++)
+			SetPixel(context, bufferX, bufferY, quad->color, ColorSpace_Linear);
+	}
+}
+
 void DTRRender_Rectangle(DTRRenderContext context, DqnV2 min, DqnV2 max,
                          DqnV4 color, const DTRRenderTransform transform)
 {
@@ -422,8 +759,7 @@ void DTRRender_Rectangle(DTRRenderContext context, DqnV2 min, DqnV2 max,
 	////////////////////////////////////////////////////////////////////////////
 	// Transform vertexes
 	////////////////////////////////////////////////////////////////////////////
-	color = DTRRender_SRGB1ToLinearSpaceV4(color);
-	color = PreMultiplyAlpha1(color);
+	color = DrawColorToLinearInternal(context, color);
 
 	RectPoints rectPoints     = TransformRectPoints(min, max, transform);
 	DqnV2 *const pList        = &rectPoints.pList[0];
@@ -445,46 +781,15 @@ void DTRRender_Rectangle(DTRRenderContext context, DqnV2 min, DqnV2 max,
 	////////////////////////////////////////////////////////////////////////////
 	// Render
 	////////////////////////////////////////////////////////////////////////////
-	if (transform.rotation != 0)
-	{
-		for (i32 y = 0; y < clippedSize.w; y++)
-		{
-			i32 bufferY = (i32)clippedRect.min.y + y;
-			for (i32 x = 0; x < clippedSize.h; x++)
-			{
-				i32 bufferX = (i32)clippedRect.min.x + x;
-				bool pIsInside = true;
-
-				for (i32 pIndex = 0; pIndex < RECT_PLIST_SIZE; pIndex++)
-				{
-					DqnV2 origin  = pList[pIndex];
-					DqnV2 line    = pList[(pIndex + 1) % RECT_PLIST_SIZE] - origin;
-					DqnV2 axis    = DqnV2_2i(bufferX, bufferY) - origin;
-					f32 dotResult = DqnV2_Dot(line, axis);
-
-					if (dotResult < 0)
-					{
-						pIsInside = false;
-						break;
-					}
-				}
-
-				if (pIsInside) SetPixel(context, bufferX, bufferY, color, ColorSpace_Linear);
-			}
-		}
-	}
-	else
-	{
-		for (i32 y = 0; y < clippedSize.h; y++)
-		{
-			i32 bufferY = (i32)clippedRect.min.y + y;
-			for (i32 x = 0; x < clippedSize.w; x++)
-			{
-				i32 bufferX = (i32)clippedRect.min.x + x;
-				SetPixel(context, bufferX, bufferY, color, ColorSpace_Linear);
-			}
-		}
-	}
+	// NOTE: Partial pixels at the max edge are drawn, i.e. the size rounds up
+	RenderQuadSetup quad = {};
+	quad.rectPoints      = rectPoints;
+	quad.min             = DqnV2i_2i((i32)clippedRect.min.x, (i32)clippedRect.min.y);
+	quad.max             = DqnV2i_2i(quad.min.x + (i32)ceilf(clippedSize.w),
+	                                 quad.min.y + (i32)ceilf(clippedSize.h));
+	quad.color           = color;
+	quad.rotated         = (transform.rotation != 0);
+	DrawQuadRowsInternal(context, &quad, RectangleRowsInternal);
 
 	////////////////////////////////////////////////////////////////////////////
 	// Debug
@@ -566,32 +871,6 @@ FILE_SCOPE inline __m128 SIMDSRGB1ToLinearSpace(__m128 color)
 	return result;
 }
 
-// color: _mm_set_ps(a, b, g, r) ie. 0=r, 1=g, 2=b, 3=a
-FILE_SCOPE inline __m128 SIMDSRGB255ToLinearSpace1(__m128 color)
-{
-	LOCAL_PERSIST const __m128 INV255_4X = _mm_set_ps1(DTRRENDER_INV_255);
-	color                                = _mm_mul_ps(color, INV255_4X);
-
-	f32 preserveAlpha   = ((f32 *)&color)[3];
-	__m128 result       = _mm_mul_ps(color, color);
-	((f32 *)&result)[3] = preserveAlpha;
-
-	return result;
-}
-
-// color: _mm_set_ps(a, b, g, r) ie. 0=r, 1=g, 2=b, 3=a
-FILE_SCOPE inline __m128 SIMDLinearSpace1ToSRGB1(__m128 color)
-{
-	DebugSIMDAssertColorInRange(color, 0.0f, 1.0f);
-
-	f32 preserveAlpha   = ((f32 *)&color)[3];
-	__m128 result       = _mm_sqrt_ps(color);
-	((f32 *)&result)[3] = preserveAlpha;
-
-	return result;
-}
-
-
 // color: _mm_set_ps(a, b, g, r) ie. 0=r, 1=g, 2=b, 3=a
 FILE_SCOPE inline __m128 SIMDPreMultiplyAlpha1(__m128 color)
 {
@@ -630,43 +909,40 @@ FILE_SCOPE inline void SIMDSetPixel(DTRRenderContext context, const i32 x, const
 	DTR_DEBUG_EP_TIMED_FUNCTION();
 	DebugSIMDAssertColorInRange(color, 0.0f, 1.0f);
 
-	// If some alpha is involved, we need to apply gamma correction, but if the
-	// new pixel is totally opaque or invisible then we're just flat out
-	// overwriting/keeping the state of the pixel so we can save cycles by skipping.
-	f32 alpha = ((f32 *)&color)[3];
-	bool needGammaFix =
-	    (alpha > 0.0f || alpha < (1.0f + COLOR_EPSILON)) && (colorSpace == ColorSpace_SRGB);
-	if (needGammaFix) color = SIMDSRGB1ToLinearSpace(color);
+	if (colorSpace == ColorSpace_SRGB) color = SIMDSRGB1ToLinearSpace(color);
 
 	// Format: u32 == (XX, RR, GG, BB)
 	u32 *const bitmapPtr = (u32 *)renderBuffer->memory;
 	const u32 pitchInU32 = (renderBuffer->width * renderBuffer->bytesPerPixel) / 4;
 
-	u32 srcPixel = bitmapPtr[x + (y * pitchInU32)];
-	__m128 src   = _mm_set_ps(0, (f32)((srcPixel >> 0) & 0xFF),
-	                             (f32)((srcPixel >> 8) & 0xFF),
-	                             (f32)((srcPixel >> 16) & 0xFF));
-	src = SIMDSRGB255ToLinearSpace1(src);
-
-	f32 invA       = 1 - alpha;
-	__m128 invA_4x = _mm_set_ps1(invA);
-
-	// PreAlphaMulColor + (1 - Alpha) * Src
-	__m128 oneMinusAlphaSrc = _mm_mul_ps(invA_4x, src);
-	__m128 dest             = _mm_add_ps(color, oneMinusAlphaSrc);
-	dest                    = SIMDLinearSpace1ToSRGB1(dest);
-	dest                    = _mm_mul_ps(dest, _mm_set_ps1(255.0f)); // to 0->255 range
+	__m128 dest = color;
+	if (context.blendMode != DTRRenderBlendMode_Opaque)
+	{
+		u32 srcPixel = bitmapPtr[x + (y * pitchInU32)];
+		__m128 src   = _mm_set_ps(0, DTRRender_SRGB255ToLinear1((srcPixel >> 0) & 0xFF),
+		                             DTRRender_SRGB255ToLinear1((srcPixel >> 8) & 0xFF),
+		                             DTRRender_SRGB255ToLinear1((srcPixel >> 16) & 0xFF));
+
+		f32 alpha      = ((f32 *)&color)[3];
+		f32 invA       = (context.blendMode == DTRRenderBlendMode_Additive) ? 1.0f : 1 - alpha;
+		__m128 invA_4x = _mm_set_ps1(invA);
+
+		// PreAlphaMulColor + (1 - Alpha) * Src
+		__m128 oneMinusAlphaSrc = _mm_mul_ps(invA_4x, src);
+		dest                    = _mm_add_ps(color, oneMinusAlphaSrc);
+	}
 
-	DebugSIMDAssertColorInRange(dest, 0.0f, 255.0f);
+	// NOTE: Additive blending saturates, the encode clamps to 255
+	if (context.blendMode != DTRRenderBlendMode_Additive) DebugSIMDAssertColorInRange(dest, 0.0f, 1.0f);
 
 	f32 destR = ((f32 *)&dest)[0];
 	f32 destG = ((f32 *)&dest)[1];
 	f32 destB = ((f32 *)&dest)[2];
 
-	u32 pixel = // ((u32)(destA) << 24 |
-	            (u32)(destR) << 16 |
-	            (u32)(destG) << 8  |
-	            (u32)(destB) << 0;
+	u32 pixel = // (DTRRender_Linear1ToSRGB255(destA) << 24 |
+	            DTRRender_Linear1ToSRGB255(destR) << 16 |
+	            DTRRender_Linear1ToSRGB255(destG) << 8  |
+	            DTRRender_Linear1ToSRGB255(destB) << 0;
 	bitmapPtr[x + (y * pitchInU32)] = pixel;
 }
 
@@ -679,8 +955,6 @@ FILE_SCOPE __m128 SIMDSampleTextureForTriangle(const DTRBitmap *const texture, c
 	DTRDebug_BeginCycleCount("SIMDTexturedTriangle_SampleTexture",
 	                         DTRDebugCycleCount_SIMDTexturedTriangle_SampleTexture);
 
-	LOCAL_PERSIST const __m128 INV255_4X = _mm_set_ps1(1.0f / 255.0f);
-
 	const f32 barycentricP2 = ((f32 *)&barycentric)[1];
 	const f32 barycentricP3 = ((f32 *)&barycentric)[2];
 	DqnV2 uv                = uv1 + (uv2SubUv1 * barycentricP2) + (uv3SubUv1 * barycentricP3);
@@ -699,16 +973,8 @@ FILE_SCOPE __m128 SIMDSampleTextureForTriangle(const DTRBitmap *const texture, c
 	i32 texelX = (i32)texelXf;
 	i32 texelY = (i32)texelYf;
 
-	const u32 texturePitch     = texture->bytesPerPixel * texture->dim.w;
-	const u8 *const texturePtr = texture->memory;
-	u32 texel1 = *(u32 *)(texturePtr + (texelX * texture->bytesPerPixel) + (texelY * texturePitch));
-
-	__m128 color = _mm_set_ps((f32)(texel1 >> 24),
-	                          (f32)((texel1 >> 16) & 0xFF),
-	                          (f32)((texel1 >> 8) & 0xFF),
-	                          (f32)((texel1 >> 0) & 0xFF));
-
-	color = SIMDSRGB255ToLinearSpace1(color);
+	DqnV4 texel1 = BitmapTexelToLinear1Internal(texture, DTRAsset_BitmapTexelIndex(texture, texelX, texelY));
+	__m128 color = _mm_set_ps(texel1.a, texel1.b, texel1.g, texel1.r);
 	DTRDebug_EndCycleCount(DTRDebugCycleCount_SIMDTexturedTriangle_SampleTexture);
 	return color;
 }
@@ -770,72 +1036,241 @@ FILE_SCOPE void DebugRenderMarkers(DTRRenderContext context, const DqnV2 *const
 	}
 }
 
-FILE_SCOPE inline f32 GetCurrZDepth(DTRRenderContext context, i32 posX, i32 posY)
+////////////////////////////////////////////////////////////////////////////////
+// Depth Formats
+////////////////////////////////////////////////////////////////////////////////
+// Scale from depth to the stored unorm, before the bias of 1, see DTRRENDER_DEPTH_RANGE.
+FILE_SCOPE inline f32 DepthToUnormScaleInternal(const enum DTRRenderDepthFormat format)
 {
-	DTRRenderBuffer *renderBuffer = context.renderBuffer;
-	DQN_ASSERT(renderBuffer);
-	const u32 zBufferPitch        = renderBuffer->width;
+	const u32 unormMax = DTRRender_DepthUnormMax(format);
+	f32 result         = (unormMax) ? ((f32)(unormMax - 1) / DTRRENDER_DEPTH_RANGE) : 0;
+	return result;
+}
 
-	i32 zBufferIndex = posX + (posY * zBufferPitch);
-	DQN_ASSERT(zBufferIndex < (renderBuffer->width * renderBuffer->height));
+// The bits a cleared depth is stored as, every format's clear is a repeated u32 pattern.
+FILE_SCOPE inline u32 DepthClearBitsInternal(const enum DTRRenderDepthFormat format)
+{
+	if (format != DTRRenderDepthFormat_F32) return 0;
 
-	context.api->LockAcquire(renderBuffer->renderLock);
-	f32 currZDepth = renderBuffer->zBuffer[zBufferIndex];
-	context.api->LockRelease(renderBuffer->renderLock);
-	return currZDepth;
+	const f32 CLEAR_DEPTH = DQN_F32_MIN;
+	u32 result;
+	memcpy(&result, &CLEAR_DEPTH, sizeof(result));
+	return result;
 }
 
-FILE_SCOPE inline void SetCurrZDepth(DTRRenderContext context, i32 posX, i32 posY, f32 newZDepth)
+FILE_SCOPE inline u32 DepthToUnormInternal(const f32 depth, const f32 unormScale)
 {
-	DTRRenderBuffer *renderBuffer = context.renderBuffer;
-	DQN_ASSERT(renderBuffer);
-	const u32 zBufferPitch        = renderBuffer->width;
+	f32 clamped = DqnMath_Clampf(depth, 0.0f, DTRRENDER_DEPTH_RANGE);
+	u32 result  = 1 + (u32)((clamped * unormScale) + 0.5f);
+	return result;
+}
 
-	i32 zBufferIndex = posX + (posY * zBufferPitch);
-	DQN_ASSERT(zBufferIndex < (renderBuffer->width * renderBuffer->height));
+FILE_SCOPE inline u32 DepthLoadUnormInternal(const DTRRenderBuffer *const renderBuffer, const i32 index)
+{
+	u32 result = (renderBuffer->depthFormat == DTRRenderDepthFormat_Unorm16)
+	                 ? ((volatile u16 *)renderBuffer->zBuffer)[index]
+	                 : ((volatile u32 *)renderBuffer->zBuffer)[index];
+	return result;
+}
 
-	context.api->LockAcquire(renderBuffer->renderLock);
-	renderBuffer->zBuffer[zBufferIndex] = newZDepth;
-	context.api->LockRelease(renderBuffer->renderLock);
+FILE_SCOPE inline void DepthStoreUnormInternal(DTRRenderBuffer *const renderBuffer, const i32 index,
+                                               const u32 value)
+{
+	if (renderBuffer->depthFormat == DTRRenderDepthFormat_Unorm16)
+		((volatile u16 *)renderBuffer->zBuffer)[index] = (u16)value;
+	else
+		((volatile u32 *)renderBuffer->zBuffer)[index] = value;
 }
 
-#define DEBUG_SIMD_AUTO_CHOOSE_BEGIN_CYCLE_COUNT(type)                                             \
-	do                                                                                             \
-	{                                                                                              \
-		if (texture)                                                                               \
-			DTRDebug_BeginCycleCount("SIMDTextured" #type, DTRDebugCycleCount_SIMDTextured##type); \
-		else                                                                                       \
-			DTRDebug_BeginCycleCount("SIMD" #type, DTRDebugCycleCount_SIMD##type);                 \
-	} while (0)
+// Write the depth if it's nearer than the zBuffer's, returns true if it was written.
+FILE_SCOPE inline bool DepthTestAndWriteInternal(DTRRenderBuffer *const renderBuffer,
+                                                 const i32 index, const f32 depth)
+{
+	if (renderBuffer->depthFormat == DTRRenderDepthFormat_F32)
+	{
+		volatile f32 *const zBuffer = (volatile f32 *)renderBuffer->zBuffer;
+		if (depth <= zBuffer[index]) return false;
+		zBuffer[index] = depth;
+		return true;
+	}
 
-#define DEBUG_SIMD_AUTO_CHOOSE_END_CYCLE_COUNT(type)                                               \
-	do                                                                                             \
-	{                                                                                              \
-		if (texture)                                                                               \
-			DTRDebug_EndCycleCount(DTRDebugCycleCount_SIMDTextured##type);                                 \
-		else                                                                                       \
-			DTRDebug_EndCycleCount(DTRDebugCycleCount_SIMD##type);                                 \
-	} while (0)
+	const u32 value =
+	    DepthToUnormInternal(depth, DepthToUnormScaleInternal(renderBuffer->depthFormat));
+	if (value <= DepthLoadUnormInternal(renderBuffer, index)) return false;
+	DepthStoreUnormInternal(renderBuffer, index, value);
+	return true;
+}
 
-FILE_SCOPE void
-SIMDRasteriseTrianglePixel(DTRRenderContext context, const DTRBitmap *const texture, const i32 posX,
-                           const i32 posY, const i32 maxX, const DqnV2 uv1, const DqnV2 uv2SubUv1,
-                           const DqnV2 uv3SubUv1, const __m128 simdColor, const __m128 triangleZ,
-                           const __m128 signedArea, const __m128 invSignedAreaParallelogram_4x,
-                           const f32 preserveAlpha, const bool ignoreLight, const __m128 p1Light,
-                           const __m128 p2Light, const __m128 p3Light)
+// Load 4 unorm depths from index of the zBuffer as 32 bit integers, only numLanes are read.
+FILE_SCOPE inline __m128i SIMDDepthLoadUnorm(const DTRRenderBuffer *const renderBuffer,
+                                             const i32 index, const i32 numLanes)
 {
-	DTRRenderBuffer *const renderBuffer = context.renderBuffer;
-	const __m128 ZERO_4X                = _mm_set_ps1(0.0f);
-	const u32 IS_GREATER_MASK           = 0xF;
-	const u32 zBufferPitch              = renderBuffer->width;
-
-	// Rasterise buffer(X, Y) pixel
+	if (numLanes == 4)
 	{
-		__m128 isGreater    = _mm_cmpge_ps(signedArea, ZERO_4X);
-		i32 isGreaterResult = _mm_movemask_ps(isGreater);
-
-		if ((isGreaterResult & IS_GREATER_MASK) == IS_GREATER_MASK && posX < maxX)
+		if (renderBuffer->depthFormat == DTRRenderDepthFormat_Unorm16)
+		{
+			__m128i depth16 = _mm_loadl_epi64((__m128i *)((u16 *)renderBuffer->zBuffer + index));
+			return _mm_unpacklo_epi16(depth16, _mm_setzero_si128());
+		}
+
+		return _mm_loadu_si128((__m128i *)((u32 *)renderBuffer->zBuffer + index));
+	}
+
+	u32 lanes[4] = {};
+	for (i32 lane = 0; lane < numLanes; lane++)
+		lanes[lane] = DepthLoadUnormInternal(renderBuffer, index + lane);
+	return _mm_loadu_si128((__m128i *)lanes);
+}
+
+// Store the lanes of 4 unorm depths set in writeMask to index of the zBuffer.
+FILE_SCOPE inline void SIMDDepthStoreUnorm(DTRRenderBuffer *const renderBuffer, const i32 index,
+                                           const __m128i depth, const i32 writeMask)
+{
+	if (writeMask == 0xF)
+	{
+		if (renderBuffer->depthFormat == DTRRenderDepthFormat_Unorm16)
+		{
+			// NOTE: SSE2 only packs with signed saturation, so shift the range into an i16 and back
+			const __m128i BIAS_32_4X = _mm_set1_epi32(0x8000);
+			const __m128i BIAS_16_8X = _mm_set1_epi16((i16)0x8000);
+			__m128i biased  = _mm_sub_epi32(depth, BIAS_32_4X);
+			__m128i depth16 = _mm_xor_si128(_mm_packs_epi32(biased, biased), BIAS_16_8X);
+			_mm_storel_epi64((__m128i *)((u16 *)renderBuffer->zBuffer + index), depth16);
+		}
+		else
+		{
+			_mm_storeu_si128((__m128i *)((u32 *)renderBuffer->zBuffer + index), depth);
+		}
+		return;
+	}
+
+	u32 lanes[4];
+	_mm_storeu_si128((__m128i *)lanes, depth);
+	for (i32 lane = 0; lane < 4; lane++)
+	{
+		if (writeMask & (1 << lane)) DepthStoreUnormInternal(renderBuffer, index + lane, lanes[lane]);
+	}
+}
+
+// AVX2 versions of SIMDDepthLoadUnorm and SIMDDepthStoreUnorm for 8 depths.
+DTR_TARGET_AVX2 FILE_SCOPE inline __m256i SIMDDepthLoadUnormAVX2(const DTRRenderBuffer *const renderBuffer,
+                                                                 const i32 index, const i32 numLanes)
+{
+	if (numLanes == 8)
+	{
+		if (renderBuffer->depthFormat == DTRRenderDepthFormat_Unorm16)
+			return _mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i *)((u16 *)renderBuffer->zBuffer + index)));
+
+		return _mm256_loadu_si256((__m256i *)((u32 *)renderBuffer->zBuffer + index));
+	}
+
+	u32 lanes[8] = {};
+	for (i32 lane = 0; lane < numLanes; lane++)
+		lanes[lane] = DepthLoadUnormInternal(renderBuffer, index + lane);
+	return _mm256_loadu_si256((__m256i *)lanes);
+}
+
+DTR_TARGET_AVX2 FILE_SCOPE inline void SIMDDepthStoreUnormAVX2(DTRRenderBuffer *const renderBuffer,
+                                                               const i32 index, const __m256i depth,
+                                                               const i32 writeMask)
+{
+	if (writeMask == 0xFF)
+	{
+		if (renderBuffer->depthFormat == DTRRenderDepthFormat_Unorm16)
+		{
+			__m128i depth16 = _mm_packus_epi32(_mm256_castsi256_si128(depth),
+			                                   _mm256_extracti128_si256(depth, 1));
+			_mm_storeu_si128((__m128i *)((u16 *)renderBuffer->zBuffer + index), depth16);
+		}
+		else
+		{
+			_mm256_storeu_si256((__m256i *)((u32 *)renderBuffer->zBuffer + index), depth);
+		}
+		return;
+	}
+
+	u32 lanes[8];
+	_mm256_storeu_si256((__m256i *)lanes, depth);
+	for (i32 lane = 0; lane < 8; lane++)
+	{
+		if (writeMask & (1 << lane)) DepthStoreUnormInternal(renderBuffer, index + lane, lanes[lane]);
+	}
+}
+
+FILE_SCOPE inline f32 GetCurrZDepth(DTRRenderContext context, i32 posX, i32 posY)
+{
+	DTRRenderBuffer *renderBuffer = context.renderBuffer;
+	DQN_ASSERT(renderBuffer);
+	const u32 zBufferPitch        = renderBuffer->width;
+
+	i32 zBufferIndex = posX + (posY * zBufferPitch);
+	DQN_ASSERT(zBufferIndex < (renderBuffer->width * renderBuffer->height));
+
+	context.api->LockAcquire(renderBuffer->renderLock);
+	f32 currZDepth = DTRRender_GetDepth(renderBuffer, zBufferIndex);
+	context.api->LockRelease(renderBuffer->renderLock);
+	return currZDepth;
+}
+
+FILE_SCOPE inline void SetCurrZDepth(DTRRenderContext context, i32 posX, i32 posY, f32 newZDepth)
+{
+	DTRRenderBuffer *renderBuffer = context.renderBuffer;
+	DQN_ASSERT(renderBuffer);
+	const u32 zBufferPitch        = renderBuffer->width;
+
+	i32 zBufferIndex = posX + (posY * zBufferPitch);
+	DQN_ASSERT(zBufferIndex < (renderBuffer->width * renderBuffer->height));
+
+	context.api->LockAcquire(renderBuffer->renderLock);
+	if (renderBuffer->depthFormat == DTRRenderDepthFormat_F32)
+	{
+		((volatile f32 *)renderBuffer->zBuffer)[zBufferIndex] = newZDepth;
+	}
+	else
+	{
+		const f32 unormScale = DepthToUnormScaleInternal(renderBuffer->depthFormat);
+		DepthStoreUnormInternal(renderBuffer, zBufferIndex, DepthToUnormInternal(newZDepth, unormScale));
+	}
+	context.api->LockRelease(renderBuffer->renderLock);
+}
+
+#define DEBUG_SIMD_AUTO_CHOOSE_BEGIN_CYCLE_COUNT(type)                                             \
+	do                                                                                             \
+	{                                                                                              \
+		if (texture)                                                                               \
+			DTRDebug_BeginCycleCount("SIMDTextured" #type, DTRDebugCycleCount_SIMDTextured##type); \
+		else                                                                                       \
+			DTRDebug_BeginCycleCount("SIMD" #type, DTRDebugCycleCount_SIMD##type);                 \
+	} while (0)
+
+#define DEBUG_SIMD_AUTO_CHOOSE_END_CYCLE_COUNT(type)                                               \
+	do                                                                                             \
+	{                                                                                              \
+		if (texture)                                                                               \
+			DTRDebug_EndCycleCount(DTRDebugCycleCount_SIMDTextured##type);                                 \
+		else                                                                                       \
+			DTRDebug_EndCycleCount(DTRDebugCycleCount_SIMD##type);                                 \
+	} while (0)
+
+FILE_SCOPE void
+SIMDRasteriseTrianglePixel(DTRRenderContext context, const DTRBitmap *const texture, const i32 posX,
+                           const i32 posY, const i32 maxX, const DqnV2 uv1, const DqnV2 uv2SubUv1,
+                           const DqnV2 uv3SubUv1, const __m128 simdColor, const __m128 triangleZ,
+                           const __m128 signedArea, const __m128 invSignedAreaParallelogram_4x,
+                           const f32 preserveAlpha, const bool ignoreLight, const __m128 p1Light,
+                           const __m128 p2Light, const __m128 p3Light)
+{
+	DTRRenderBuffer *const renderBuffer = context.renderBuffer;
+	const __m128 ZERO_4X                = _mm_set_ps1(0.0f);
+	const u32 IS_GREATER_MASK           = 0xF;
+	const u32 zBufferPitch              = renderBuffer->width;
+
+	// Rasterise buffer(X, Y) pixel
+	{
+		__m128 isGreater    = _mm_cmpge_ps(signedArea, ZERO_4X);
+		i32 isGreaterResult = _mm_movemask_ps(isGreater);
+
+		if ((isGreaterResult & IS_GREATER_MASK) == IS_GREATER_MASK && posX < maxX)
 		{
 			DEBUG_SIMD_AUTO_CHOOSE_BEGIN_CYCLE_COUNT(Triangle_RasterisePixel);
 			{
@@ -846,10 +1281,9 @@ SIMDRasteriseTrianglePixel(DTRRenderContext context, const DTRBitmap *const text
 				                  ((f32 *)&barycentricZ)[2];
 
 				i32 zBufferIndex  = posX + (posY * zBufferPitch);
-				if (pixelZDepth > renderBuffer->zBuffer[zBufferIndex])
+				if (DepthTestAndWriteInternal(renderBuffer, zBufferIndex, pixelZDepth))
 				{
-					renderBuffer->zBuffer[zBufferIndex] = pixelZDepth;
-					__m128 finalColor                   = simdColor;
+					__m128 finalColor = simdColor;
 					if (!ignoreLight)
 					{
 						__m128 barycentricA_4x = _mm_set_ps1(((f32 *)&barycentric)[0]);
@@ -882,186 +1316,1230 @@ SIMDRasteriseTrianglePixel(DTRRenderContext context, const DTRBitmap *const text
 	}
 }
 
-FILE_SCOPE void SIMDTriangle(DTRRenderContext context, const DqnV3 p1, const DqnV3 p2,
-                             const DqnV3 p3, const DqnV2 uv1, const DqnV2 uv2, const DqnV2 uv3,
-                             const f32 lightIntensity1, const f32 lightIntensity2,
-                             const f32 lightIntensity3, const bool ignoreLight,
-                             DTRBitmap *const texture, DqnV4 color, const DqnV2i min,
-                             const DqnV2i max)
+// NOTE: Vertices are rounded to fixed point with 4 bits of sub-pixel precision (28.4) before the
+// edge functions are setup. Edge functions are then exact integers, so stepping them never drifts
+// and triangles sharing an edge agree on every pixel along it, regardless of the order or width
+// they're evaluated in.
+FILE_SCOPE const i32 TRIANGLE_SUB_PIXEL_BITS = 4;
+
+// NOTE: An edge function is the product of 2 fixed point distances, which must stay under 2^14 for
+// the product to fit in a i32 with room to step past the bounds, i.e. triangles must be under 1024
+// pixels wide. Bigger triangles are clipped to a guard band first, see RasteriseTriangleInternal().
+FILE_SCOPE const i32 TRIANGLE_MAX_FIXED_EXTENT = (1 << 14);
+
+// NOTE: The guard band of a cell of the screen is the cell padded by the margin on each side. Cells
+// are aligned to the screen, not the triangle, so every triangle drawing into a cell is clipped
+// against the same band and triangles sharing an edge clip it to the same vertexes.
+#define TRIANGLE_GUARD_BAND_CELL_SIZE 128
+#define TRIANGLE_GUARD_BAND_MARGIN    384
+DQN_COMPILE_ASSERT(((TRIANGLE_GUARD_BAND_CELL_SIZE + (2 * TRIANGLE_GUARD_BAND_MARGIN)) << TRIANGLE_SUB_PIXEL_BITS) < TRIANGLE_MAX_FIXED_EXTENT);
+
+// The edge functions are the signed area of a pixel against the edge opposite p1, p2 and p3 in
+// fixed point, evaluated at origin and stepped per pixel. Pixels are sampled at their integer
+// coordinate.
+typedef struct TriangleEdges
+{
+	DqnV2i origin;
+	i32    start [3];
+	i32    deltaX[3];
+	i32    deltaY[3];
+
+	// NOTE: A pixel is inside an edge if its value is > bias. Top-left edges have a bias of -1 so
+	// pixels exactly on them are drawn, the rest have 0 so pixels on an edge shared by 2 triangles
+	// are only drawn by one of them.
+	i32    bias[3];
+	i32    signedAreaParallelogram;
+} TriangleEdges;
+
+FILE_SCOPE inline i32 TriangleEdgesSetupEdgeInternal(TriangleEdges *const edges, const i32 edgeIndex,
+                                                     const DqnV2i a, const DqnV2i b,
+                                                     const DqnV2i origin, const i32 subPixelBits)
+{
+	const i32 edgeX = b.x - a.x;
+	const i32 edgeY = b.y - a.y;
+	edges->start [edgeIndex] = (edgeX * (origin.y - a.y)) - (edgeY * (origin.x - a.x));
+	edges->deltaX[edgeIndex] = -edgeY << subPixelBits;
+	edges->deltaY[edgeIndex] = edgeX << subPixelBits;
+
+	const bool isTopLeft    = (edgeY < 0) || (edgeY == 0 && edgeX > 0);
+	edges->bias[edgeIndex]  = (isTopLeft) ? -1 : 0;
+	return edges->start[edgeIndex];
+}
+
+// p1, p2, p3 must be clockwise, see Make3PointsClockwise(). Returns false if the triangle has no
+// area once rounded to fixed point, or has non-finite vertexes.
+FILE_SCOPE bool TriangleEdgesSetupInternal(const DqnV2 p1, const DqnV2 p2, const DqnV2 p3,
+                                           const DqnV2i origin, TriangleEdges *const result)
+{
+	const f32 extentX = DQN_MAX(DQN_MAX(p1.x, p2.x), p3.x) - DQN_MIN(DQN_MIN(p1.x, p2.x), p3.x);
+	const f32 extentY = DQN_MAX(DQN_MAX(p1.y, p2.y), p3.y) - DQN_MIN(DQN_MIN(p1.y, p2.y), p3.y);
+	const f32 extent  = DQN_MAX(extentX, extentY);
+
+	// NOTE: Guard band clipping keeps triangles in range, this only rejects non-finite vertexes
+	const i32 subPixelBits = TRIANGLE_SUB_PIXEL_BITS;
+	if (!(extent * (f32)(1 << subPixelBits) < (f32)TRIANGLE_MAX_FIXED_EXTENT)) return false;
+
+	const f32 toFixed = (f32)(1 << subPixelBits);
+	DqnV2i fixedP1 = DqnV2i_2i((i32)floorf((p1.x * toFixed) + 0.5f), (i32)floorf((p1.y * toFixed) + 0.5f));
+	DqnV2i fixedP2 = DqnV2i_2i((i32)floorf((p2.x * toFixed) + 0.5f), (i32)floorf((p2.y * toFixed) + 0.5f));
+	DqnV2i fixedP3 = DqnV2i_2i((i32)floorf((p3.x * toFixed) + 0.5f), (i32)floorf((p3.y * toFixed) + 0.5f));
+	DqnV2i fixedOrigin = DqnV2i_2i(origin.x << subPixelBits, origin.y << subPixelBits);
+
+	result->origin = origin;
+	i32 signedAreaParallelogram = 0;
+	signedAreaParallelogram += TriangleEdgesSetupEdgeInternal(result, 0, fixedP2, fixedP3, fixedOrigin, subPixelBits);
+	signedAreaParallelogram += TriangleEdgesSetupEdgeInternal(result, 1, fixedP3, fixedP1, fixedOrigin, subPixelBits);
+	signedAreaParallelogram += TriangleEdgesSetupEdgeInternal(result, 2, fixedP1, fixedP2, fixedOrigin, subPixelBits);
+
+	// NOTE: Rounding can collapse or flip tiny triangles, neither covers any pixel
+	result->signedAreaParallelogram = signedAreaParallelogram;
+	return (signedAreaParallelogram > 0);
+}
+
+FILE_SCOPE inline i32 TriangleEdgesEvaluate(const TriangleEdges *const edges, const i32 edgeIndex,
+                                            const i32 x, const i32 y)
+{
+	i32 result = edges->start[edgeIndex] + ((y - edges->origin.y) * edges->deltaY[edgeIndex]) +
+	             ((x - edges->origin.x) * edges->deltaX[edgeIndex]);
+	return result;
+}
 
+// Per triangle constants shared by the 4 and 8 wide rasterisers.
+typedef struct SIMDTriangleSetup
+{
+	TriangleEdges edges;
+	f32           invSignedAreaParallelogram;
+	f32           z[3];
+
+	DqnV4 color;     // Linear space and premultiplied
+	DqnV3 pLight[3]; // color.rgb * max(0, lightIntensity) of each vertex
+	DqnV2 uv2SubUv1;
+	DqnV2 uv3SubUv1;
+} SIMDTriangleSetup;
+
+// Returns false if the triangle has no area and nothing should be rasterised, see
+// TriangleEdgesSetupInternal(). color is expected in linear space and premultiplied, see
+// DrawColorToLinearInternal().
+FILE_SCOPE bool SIMDTriangleSetupInternal(const DqnV3 p1, const DqnV3 p2, const DqnV3 p3,
+                                          const DqnV2 uv1, const DqnV2 uv2, const DqnV2 uv3,
+                                          const f32 lightIntensity1, const f32 lightIntensity2,
+                                          const f32 lightIntensity3, const DqnV4 color,
+                                          const DqnV2i min, SIMDTriangleSetup *const result)
 {
 	DTR_DEBUG_EP_TIMED_FUNCTION();
-	DEBUG_SIMD_AUTO_CHOOSE_BEGIN_CYCLE_COUNT(Triangle);
+	if (!TriangleEdgesSetupInternal(p1.xy, p2.xy, p3.xy, min, &result->edges)) return false;
+	result->invSignedAreaParallelogram = 1.0f / (f32)result->edges.signedAreaParallelogram;
 
-	DEBUG_SIMD_AUTO_CHOOSE_BEGIN_CYCLE_COUNT(Triangle_Preamble);
+	result->z[0] = p1.z;
+	result->z[1] = p2.z;
+	result->z[2] = p3.z;
 
-	DTRRenderBuffer *const renderBuffer = context.renderBuffer;
-	////////////////////////////////////////////////////////////////////////////
-	// Convert color
-	////////////////////////////////////////////////////////////////////////////
-	__m128 simdColor  = _mm_set_ps(color.a, color.b, color.g, color.r);
-	simdColor         = SIMDSRGB1ToLinearSpace(simdColor);
-	simdColor         = SIMDPreMultiplyAlpha1(simdColor);
-	f32 preserveAlpha = ((f32 *)&simdColor)[3];
+	result->color = color;
 
-	const __m128 ZERO_4X       = _mm_set_ps1(0.0f);
-	__m128 simdLightIntensity1 = _mm_set_ps1(lightIntensity1);
-	__m128 simdLightIntensity2 = _mm_set_ps1(lightIntensity2);
-	__m128 simdLightIntensity3 = _mm_set_ps1(lightIntensity3);
+	result->pLight[0] = color.rgb * DQN_MAX(0, lightIntensity1);
+	result->pLight[1] = color.rgb * DQN_MAX(0, lightIntensity2);
+	result->pLight[2] = color.rgb * DQN_MAX(0, lightIntensity3);
 
-	simdLightIntensity1 = _mm_max_ps(simdLightIntensity1, ZERO_4X);
-	simdLightIntensity2 = _mm_max_ps(simdLightIntensity2, ZERO_4X);
-	simdLightIntensity3 = _mm_max_ps(simdLightIntensity3, ZERO_4X);
+	result->uv2SubUv1 = uv2 - uv1;
+	result->uv3SubUv1 = uv3 - uv1;
+	return true;
+}
 
-	__m128 p1Light = _mm_mul_ps(simdColor, simdLightIntensity1);
-	__m128 p2Light = _mm_mul_ps(simdColor, simdLightIntensity2);
-	__m128 p3Light = _mm_mul_ps(simdColor, simdLightIntensity3);
+// NOTE: Pad depth ranges tested against the depth blocks, pixel depths are interpolated in a
+// different order than the range and may land a few ulps outside of it.
+FILE_SCOPE const f32 DEPTH_BLOCK_EPSILON = 0.001f;
 
-	////////////////////////////////////////////////////////////////////////////
-	// Setup SIMD data
-	////////////////////////////////////////////////////////////////////////////
-	const u32 NUM_X_PIXELS_TO_SIMD = 1;
-	const u32 NUM_Y_PIXELS_TO_SIMD = 1;
+// Unorm depths are also padded by a quantisation step, depths closer than that may be stored equal.
+FILE_SCOPE inline f32 DepthBlockEpsilonInternal(const DTRRenderBuffer *const renderBuffer)
+{
+	const f32 unormScale = DepthToUnormScaleInternal(renderBuffer->depthFormat);
+	f32 result           = DEPTH_BLOCK_EPSILON + ((unormScale > 0) ? (1.0f / unormScale) : 0);
+	return result;
+}
+
+// Triangles with smaller bounds (in pixels) are not tested against the depth blocks individually.
+FILE_SCOPE const i32 DEPTH_BLOCK_WALK_MIN_AREA = 4 * DTRRENDER_DEPTH_BLOCK_SIZE * DTRRENDER_DEPTH_BLOCK_SIZE;
+
+typedef struct DepthBlockTest
+{
+	bool isOutside;      // No pixel of the rect is inside the triangle
+	bool isFullyCovered; // Every pixel of the rect is inside the triangle
+	f32  minZ;           // Depth range of the triangle's plane over the rect
+	f32  maxZ;
+} DepthBlockTest;
+
+// Coarse test of the triangle against a rect of pixels, where max is exclusive. Edge functions and
+// depth are linear over the rect so their extremes are found at the 4 corner pixels.
+FILE_SCOPE DepthBlockTest SIMDTriangleTestRect(const SIMDTriangleSetup *const setup,
+                                               const DqnV2i min, const DqnV2i max,
+                                               const f32 epsilon)
+{
+	const i32 cornerX[4] = {min.x, max.x - 1, min.x,     max.x - 1};
+	const i32 cornerY[4] = {min.y, min.y,     max.y - 1, max.y - 1};
+
+	DepthBlockTest result = {};
+	result.isFullyCovered = true;
+	result.minZ           = DQN_F32_MAX;
+	result.maxZ           = -DQN_F32_MAX;
 
-	// SignedArea: _mm_set_ps(unused, p3, p2, p1) ie 0=p1, 1=p1, 2=p3, 3=unused
-	__m128 signedAreaPixel1 = _mm_set_ps1(0);
-	// __m128 signedAreaPixel2 = _mm_set_ps1(0);
+	i32 edge[4][3];
+	for (i32 edgeIndex = 0; edgeIndex < 3; edgeIndex++)
+	{
+		i32 numCornersOutside = 0;
+		for (i32 corner = 0; corner < 4; corner++)
+		{
+			edge[corner][edgeIndex] =
+			    TriangleEdgesEvaluate(&setup->edges, edgeIndex, cornerX[corner], cornerY[corner]);
+			if (edge[corner][edgeIndex] <= setup->edges.bias[edgeIndex]) numCornersOutside++;
+		}
+
+		if (numCornersOutside == 4) result.isOutside = true;
+		if (numCornersOutside > 0) result.isFullyCovered = false;
+	}
+
+	for (i32 corner = 0; corner < 4; corner++)
+	{
+		f32 barycentricA = (f32)edge[corner][0] * setup->invSignedAreaParallelogram;
+		f32 barycentricB = (f32)edge[corner][1] * setup->invSignedAreaParallelogram;
+		f32 barycentricC = (f32)edge[corner][2] * setup->invSignedAreaParallelogram;
+		f32 z            = ((setup->z[0] * barycentricA) + (setup->z[1] * barycentricB)) +
+		                   (setup->z[2] * barycentricC);
+		result.minZ = DQN_MIN(result.minZ, z);
+		result.maxZ = DQN_MAX(result.maxZ, z);
+	}
 
-	__m128 signedAreaPixelDeltaX         = _mm_set_ps1(0);
-	__m128 signedAreaPixelDeltaY         = _mm_set_ps1(0);
-	__m128 invSignedAreaParallelogram_4x = _mm_set_ps1(0);
+	result.minZ -= epsilon;
+	result.maxZ += epsilon;
+	return result;
+}
 
-	__m128 triangleZ = _mm_set_ps(0, p3.z, p2.z, p1.z);
+// Stamp of a depth block that a thread is lazily clearing, see DTRRenderBuffer.
+#define DEPTH_BLOCK_STAMP_CLEARING 0xFFFFFFFF
+
+// Clear every stale depth block overlapping the region, where max is exclusive. Blocks may be
+// shared with threads rasterising with lockPixels, so a block is claimed by swapping its stamp to
+// DEPTH_BLOCK_STAMP_CLEARING and the other threads spin until it's been cleared.
+FILE_SCOPE void DepthBlocksLazyClearRect(DTRRenderContext context, const DqnV2i min,
+                                         const DqnV2i max)
+{
+	DTRRenderBuffer *const renderBuffer = context.renderBuffer;
+	if (!renderBuffer->zBufferBlockStamps || min.x >= max.x || min.y >= max.y) return;
+
+	const u32 stamp      = renderBuffer->depthStamp;
+	const i32 blockPitch = DTRRender_DepthBlockPitch(renderBuffer);
+	const i32 depthBytes = DTRRender_DepthBytesPerPixel(renderBuffer->depthFormat);
+	const u32 clearBits  = DepthClearBitsInternal(renderBuffer->depthFormat);
+	for (i32 blockY = min.y / DTRRENDER_DEPTH_BLOCK_SIZE;
+	     blockY <= (max.y - 1) / DTRRENDER_DEPTH_BLOCK_SIZE; blockY++)
 	{
-		DEBUG_SIMD_AUTO_CHOOSE_BEGIN_CYCLE_COUNT(Triangle_Preamble_SArea);
-		DTR_DEBUG_EP_TIMED_BLOCK("SIMDTriangle_Preamble_SArea");
-		DqnV2 startP          = DqnV2_V2i(min);
-		f32 signedArea1Start  = Triangle2TimesSignedArea(p2.xy, p3.xy, startP);
-		f32 signedArea1DeltaX = p2.y - p3.y;
-		f32 signedArea1DeltaY = p3.x - p2.x;
+		for (i32 blockX = min.x / DTRRENDER_DEPTH_BLOCK_SIZE;
+		     blockX <= (max.x - 1) / DTRRENDER_DEPTH_BLOCK_SIZE; blockX++)
+		{
+			const i32 blockIndex          = blockX + (blockY * blockPitch);
+			volatile u32 *const blockStamp = renderBuffer->zBufferBlockStamps + blockIndex;
+
+			u32 oldStamp;
+			while ((oldStamp = *blockStamp) != stamp)
+			{
+				if (oldStamp == DEPTH_BLOCK_STAMP_CLEARING)
+				{
+					// NOTE: Another thread owns the block, back off the cache line until it's done
+					_mm_pause();
+					continue;
+				}
+				if (context.api->AtomicCompareSwap(blockStamp, DEPTH_BLOCK_STAMP_CLEARING,
+				                                   oldStamp) != oldStamp)
+				{
+					continue;
+				}
+
+				const i32 pixelX = blockX * DTRRENDER_DEPTH_BLOCK_SIZE;
+				const i32 pixelY = blockY * DTRRENDER_DEPTH_BLOCK_SIZE;
+				const i32 endX   = DQN_MIN(pixelX + DTRRENDER_DEPTH_BLOCK_SIZE, renderBuffer->width);
+				const i32 endY   = DQN_MIN(pixelY + DTRRENDER_DEPTH_BLOCK_SIZE, renderBuffer->height);
+				for (i32 y = pixelY; y < endY; y++)
+				{
+					const i32 rowIndex = y * renderBuffer->width;
+					if (depthBytes == sizeof(u16))
+					{
+						volatile u16 *const zBufferRow = (volatile u16 *)renderBuffer->zBuffer + rowIndex;
+						for (i32 x = pixelX; x < endX; x++)
+							zBufferRow[x] = (u16)clearBits;
+					}
+					else
+					{
+						volatile u32 *const zBufferRow = (volatile u32 *)renderBuffer->zBuffer + rowIndex;
+						for (i32 x = pixelX; x < endX; x++)
+							zBufferRow[x] = clearBits;
+					}
+				}
 
-		f32 signedArea2Start  = Triangle2TimesSignedArea(p3.xy, p1.xy, startP);
-		f32 signedArea2DeltaX = p3.y - p1.y;
-		f32 signedArea2DeltaY = p1.x - p3.x;
+				if (renderBuffer->zBufferBlocks)
+				{
+					renderBuffer->zBufferBlocks[blockIndex].min = DQN_F32_MIN;
+					renderBuffer->zBufferBlocks[blockIndex].max = DQN_F32_MIN;
+				}
 
-		f32 signedArea3Start  = Triangle2TimesSignedArea(p1.xy, p2.xy, startP);
-		f32 signedArea3DeltaX = p1.y - p2.y;
-		f32 signedArea3DeltaY = p2.x - p1.x;
-		DTR_DEBUG_EP_TIMED_END_BLOCK();
-		DEBUG_SIMD_AUTO_CHOOSE_END_CYCLE_COUNT(Triangle_Preamble_SArea);
+				// NOTE: Publish with a compare swap, it orders the clear before the stamp
+				context.api->AtomicCompareSwap(blockStamp, stamp, DEPTH_BLOCK_STAMP_CLEARING);
+			}
+		}
+	}
+}
 
-		DEBUG_SIMD_AUTO_CHOOSE_BEGIN_CYCLE_COUNT(Triangle_Preamble_SIMDStep);
-		f32 signedAreaParallelogram = signedArea1Start + signedArea2Start + signedArea3Start;
-		if (signedAreaParallelogram == 0) return;
+// Raise the max of every block overlapping the region, where max is exclusive. Rasterisers that
+// don't maintain the depth blocks pass DQN_F32_MAX before writing to the zBuffer, it makes the
+// blocks in the region conservative again so they never skip a depth test they shouldn't.
+FILE_SCOPE void RaiseDepthBlocksMax(DTRRenderBuffer *const renderBuffer, const DqnV2i min,
+                                    const DqnV2i max, const f32 maxZ)
+{
+	if (!renderBuffer->zBufferBlocks || min.x >= max.x || min.y >= max.y) return;
+
+	const i32 blockPitch = DTRRender_DepthBlockPitch(renderBuffer);
+	const i32 minBlockX  = min.x / DTRRENDER_DEPTH_BLOCK_SIZE;
+	const i32 minBlockY  = min.y / DTRRENDER_DEPTH_BLOCK_SIZE;
+	const i32 maxBlockX  = (max.x - 1) / DTRRENDER_DEPTH_BLOCK_SIZE;
+	const i32 maxBlockY  = (max.y - 1) / DTRRENDER_DEPTH_BLOCK_SIZE;
+	for (i32 blockY = minBlockY; blockY <= maxBlockY; blockY++)
+	{
+		for (i32 blockX = minBlockX; blockX <= maxBlockX; blockX++)
+		{
+			// NOTE: Nothing was written to stale blocks, they're reset when lazily cleared
+			const i32 blockIndex = blockX + (blockY * blockPitch);
+			if (DTRRender_DepthBlockIsStale(renderBuffer, blockIndex)) continue;
 
-		f32 invSignedAreaParallelogram = 1.0f / signedAreaParallelogram;
-		invSignedAreaParallelogram_4x  = _mm_set_ps1(invSignedAreaParallelogram);
+			DTRRenderDepthBlock *block = renderBuffer->zBufferBlocks + blockIndex;
+			block->max                 = DQN_MAX(block->max, maxZ);
+		}
+	}
+}
 
-		// NOTE: Order is important here!
-		signedAreaPixelDeltaX = _mm_set_ps(0, signedArea3DeltaX, signedArea2DeltaX, signedArea1DeltaX);
-		signedAreaPixelDeltaY = _mm_set_ps(0, signedArea3DeltaY, signedArea2DeltaY, signedArea1DeltaY);
+// Scan the zBuffer for the min depth of the block starting at blockMin, which must be a whole block.
+FILE_SCOPE f32 DepthBlockReadMin(const DTRRenderBuffer *const renderBuffer, const DqnV2i blockMin)
+{
+	if (renderBuffer->depthFormat == DTRRenderDepthFormat_F32)
+	{
+		f32 result = DQN_F32_MAX;
+		for (i32 y = blockMin.y; y < blockMin.y + DTRRENDER_DEPTH_BLOCK_SIZE; y++)
+		{
+			const f32 *zBufferRow = (const f32 *)renderBuffer->zBuffer + blockMin.x + (y * renderBuffer->width);
+			for (i32 x = 0; x < DTRRENDER_DEPTH_BLOCK_SIZE; x++)
+				result = DQN_MIN(result, zBufferRow[x]);
+		}
 
-		signedAreaPixel1 = _mm_set_ps(0, signedArea3Start, signedArea2Start, signedArea1Start);
-		// signedAreaPixel2 = _mm_add_ps(signedAreaPixel1, signedAreaPixelDeltaX);
+		return result;
+	}
 
-		// NOTE: Increase step size to the number of pixels rasterised with SIMD
+	// NOTE: Unorms are monotonic in depth so the min is found in the stored values
+	i32 minIndex = blockMin.x + (blockMin.y * renderBuffer->width);
+	u32 minUnorm = DepthLoadUnormInternal(renderBuffer, minIndex);
+	for (i32 y = blockMin.y; y < blockMin.y + DTRRENDER_DEPTH_BLOCK_SIZE; y++)
+	{
+		for (i32 x = blockMin.x; x < blockMin.x + DTRRENDER_DEPTH_BLOCK_SIZE; x++)
 		{
-			const __m128 STEP_X_4X = _mm_set_ps1((f32)NUM_X_PIXELS_TO_SIMD);
-			const __m128 STEP_Y_4X = _mm_set_ps1((f32)NUM_Y_PIXELS_TO_SIMD);
+			const i32 index = x + (y * renderBuffer->width);
+			const u32 value = DepthLoadUnormInternal(renderBuffer, index);
+			if (value < minUnorm)
+			{
+				minUnorm = value;
+				minIndex = index;
+			}
+		}
+	}
+
+	f32 result = DTRRender_GetDepth(renderBuffer, minIndex);
+	return result;
+}
 
-			signedAreaPixelDeltaX = _mm_mul_ps(signedAreaPixelDeltaX, STEP_X_4X);
-			signedAreaPixelDeltaY = _mm_mul_ps(signedAreaPixelDeltaY, STEP_Y_4X);
+// Returns true if nothing with a depth of at most maxZ can pass the depth test in the region.
+FILE_SCOPE bool DepthBlocksRejectRect(const DTRRenderBuffer *const renderBuffer, const DqnV2i min,
+                                      const DqnV2i max, const f32 maxZ)
+{
+	const i32 blockPitch = DTRRender_DepthBlockPitch(renderBuffer);
+	for (i32 blockY = min.y / DTRRENDER_DEPTH_BLOCK_SIZE;
+	     blockY <= (max.y - 1) / DTRRENDER_DEPTH_BLOCK_SIZE; blockY++)
+	{
+		for (i32 blockX = min.x / DTRRENDER_DEPTH_BLOCK_SIZE;
+		     blockX <= (max.x - 1) / DTRRENDER_DEPTH_BLOCK_SIZE; blockX++)
+		{
+			// NOTE: Stale blocks read as cleared, which anything can pass
+			const i32 blockIndex = blockX + (blockY * blockPitch);
+			if (DTRRender_DepthBlockIsStale(renderBuffer, blockIndex)) return false;
+			if (maxZ > renderBuffer->zBufferBlocks[blockIndex].min) return false;
 		}
-		DEBUG_SIMD_AUTO_CHOOSE_END_CYCLE_COUNT(Triangle_Preamble_SIMDStep);
 	}
 
-	const DqnV2 uv2SubUv1 = uv2 - uv1;
-	const DqnV2 uv3SubUv1 = uv3 - uv1;
+	return true;
+}
+
+FILE_SCOPE inline void AcquirePixelLock(DTRRenderContext context, const i32 zBufferIndex)
+{
+	DTRRenderBuffer *const renderBuffer = context.renderBuffer;
+	bool currLockValue;
+	do
+	{
+		currLockValue = (bool)context.api->AtomicCompareSwap(
+		    (u32 *)&renderBuffer->pixelLockTable[zBufferIndex], (u32) true, (u32) false);
+	} while (currLockValue != false);
+}
+
+// Rasterises 4 horizontally adjacent pixels per iteration. Every lane holds 1 pixel, i.e. the edge
+// functions, depth, lighting and texture of the 4 pixels are evaluated together. Pixels are only
+// ever written if they pass the coverage and depth test so neighbouring pixels are left untouched.
+//
+// The bounds are walked in depth blocks. Unless pixels are locked, blocks the triangle misses or
+// is entirely behind are rejected with one compare, and fully covered blocks that the triangle is
+// entirely in front of skip the per-pixel depth test.
+FILE_SCOPE void SIMDTriangle(DTRRenderContext context, const DqnV3 p1, const DqnV3 p2,
+                             const DqnV3 p3, const DqnV2 uv1, const DqnV2 uv2, const DqnV2 uv3,
+                             const f32 lightIntensity1, const f32 lightIntensity2,
+                             const f32 lightIntensity3, const bool ignoreLight,
+                             DTRBitmap *const texture, DqnV4 color, const DqnV2i min,
+                             const DqnV2i max, const bool lockPixels)
+
+{
+	DTR_DEBUG_EP_TIMED_FUNCTION();
+	DEBUG_SIMD_AUTO_CHOOSE_BEGIN_CYCLE_COUNT(Triangle);
+	DEBUG_SIMD_AUTO_CHOOSE_BEGIN_CYCLE_COUNT(Triangle_Preamble);
+
+	DTRRenderBuffer *const renderBuffer = context.renderBuffer;
+	const i32 NUM_X_PIXELS_TO_SIMD      = 4;
+	const i32 ALL_LANES_MASK            = 0xF;
+	const i32 BLOCK_SIZE                = DTRRENDER_DEPTH_BLOCK_SIZE;
+
+	////////////////////////////////////////////////////////////////////////////
+	// Setup SIMD data
+	////////////////////////////////////////////////////////////////////////////
+	DEBUG_SIMD_AUTO_CHOOSE_BEGIN_CYCLE_COUNT(Triangle_Preamble_SArea);
+	SIMDTriangleSetup setup = {};
+	bool hasArea = SIMDTriangleSetupInternal(p1, p2, p3, uv1, uv2, uv3, lightIntensity1,
+	                                         lightIntensity2, lightIntensity3,
+	                                         DrawColorToLinearInternal(context, color), min, &setup);
+	DEBUG_SIMD_AUTO_CHOOSE_END_CYCLE_COUNT(Triangle_Preamble_SArea);
+	if (!hasArea)
+	{
+		DEBUG_SIMD_AUTO_CHOOSE_END_CYCLE_COUNT(Triangle_Preamble);
+		DEBUG_SIMD_AUTO_CHOOSE_END_CYCLE_COUNT(Triangle);
+		return;
+	}
+
+	DEBUG_SIMD_AUTO_CHOOSE_BEGIN_CYCLE_COUNT(Triangle_Preamble_SIMDStep);
+	const bool blendOpaque      = (context.blendMode == DTRRenderBlendMode_Opaque);
+	const bool blendAdditive    = (context.blendMode == DTRRenderBlendMode_Additive);
+	const __m128 ZERO_4X        = _mm_set_ps1(0.0f);
+	const __m128 ONE_4X         = _mm_set_ps1(1.0f);
+	const __m128 INV255_4X      = _mm_set_ps1(DTRRENDER_INV_255);
+	const __m128 MAX_255_4X     = _mm_set_ps1(255.0f);
+	const __m128i MASK_FF_4X    = _mm_set1_epi32(0xFF);
+	const __m128 LANE_OFFSET_4X = _mm_set_ps(3, 2, 1, 0);
+
+	// NOTE: Edges are integers so they're stepped by a whole span at a time without drifting
+	i32 edgeLaneOffset[3][4];
+	for (i32 edgeIndex = 0; edgeIndex < 3; edgeIndex++)
+	{
+		for (i32 lane = 0; lane < NUM_X_PIXELS_TO_SIMD; lane++)
+			edgeLaneOffset[edgeIndex][lane] = setup.edges.deltaX[edgeIndex] * lane;
+	}
 
+	const __m128i edge1LaneOffset_4x = _mm_loadu_si128((__m128i *)edgeLaneOffset[0]);
+	const __m128i edge2LaneOffset_4x = _mm_loadu_si128((__m128i *)edgeLaneOffset[1]);
+	const __m128i edge3LaneOffset_4x = _mm_loadu_si128((__m128i *)edgeLaneOffset[2]);
+	const __m128i edge1Step_4x       = _mm_set1_epi32(setup.edges.deltaX[0] * NUM_X_PIXELS_TO_SIMD);
+	const __m128i edge2Step_4x       = _mm_set1_epi32(setup.edges.deltaX[1] * NUM_X_PIXELS_TO_SIMD);
+	const __m128i edge3Step_4x       = _mm_set1_epi32(setup.edges.deltaX[2] * NUM_X_PIXELS_TO_SIMD);
+	const __m128i edge1Bias_4x       = _mm_set1_epi32(setup.edges.bias[0]);
+	const __m128i edge2Bias_4x       = _mm_set1_epi32(setup.edges.bias[1]);
+	const __m128i edge3Bias_4x       = _mm_set1_epi32(setup.edges.bias[2]);
+
+	const __m128 invSignedAreaParallelogram_4x = _mm_set_ps1(setup.invSignedAreaParallelogram);
+	const __m128 p1Z_4x = _mm_set_ps1(p1.z);
+	const __m128 p2Z_4x = _mm_set_ps1(p2.z);
+	const __m128 p3Z_4x = _mm_set_ps1(p3.z);
+
+	const __m128 colorR_4x = _mm_set_ps1(setup.color.r);
+	const __m128 colorG_4x = _mm_set_ps1(setup.color.g);
+	const __m128 colorB_4x = _mm_set_ps1(setup.color.b);
+	const __m128 colorA_4x = _mm_set_ps1(setup.color.a);
+
+	const __m128 p1LightR_4x = _mm_set_ps1(setup.pLight[0].r);
+	const __m128 p1LightG_4x = _mm_set_ps1(setup.pLight[0].g);
+	const __m128 p1LightB_4x = _mm_set_ps1(setup.pLight[0].b);
+	const __m128 p2LightR_4x = _mm_set_ps1(setup.pLight[1].r);
+	const __m128 p2LightG_4x = _mm_set_ps1(setup.pLight[1].g);
+	const __m128 p2LightB_4x = _mm_set_ps1(setup.pLight[1].b);
+	const __m128 p3LightR_4x = _mm_set_ps1(setup.pLight[2].r);
+	const __m128 p3LightG_4x = _mm_set_ps1(setup.pLight[2].g);
+	const __m128 p3LightB_4x = _mm_set_ps1(setup.pLight[2].b);
+
+	const __m128 uv1X_4x       = _mm_set_ps1(uv1.x);
+	const __m128 uv1Y_4x       = _mm_set_ps1(uv1.y);
+	const __m128 uv2SubUv1X_4x = _mm_set_ps1(setup.uv2SubUv1.x);
+	const __m128 uv2SubUv1Y_4x = _mm_set_ps1(setup.uv2SubUv1.y);
+	const __m128 uv3SubUv1X_4x = _mm_set_ps1(setup.uv3SubUv1.x);
+	const __m128 uv3SubUv1Y_4x = _mm_set_ps1(setup.uv3SubUv1.y);
+
+	const bool texLinear16      = (texture && texture->format == DTRBitmapFormat_Linear16);
+	const u32 *const texturePtr = (texture) ? (u32 *)texture->memory : NULL;
+	const u64 *const texture16  = (texLinear16) ? (u64 *)texture->memory : NULL;
+	const __m128 INV65535_4X    = _mm_set_ps1(DTRRENDER_INV_65535);
+	const __m128i MASK_FFFF_4X  = _mm_set1_epi32(0xFFFF);
+	const __m128 texMaxX_4x     = _mm_set_ps1((texture) ? (f32)(texture->dim.w - 1) : 0);
+	const __m128 texMaxY_4x     = _mm_set_ps1((texture) ? (f32)(texture->dim.h - 1) : 0);
+	const __m128 texDimW_4x     = _mm_set_ps1((texture) ? (f32)texture->dim.w : 0);
+	const __m128 texDimH_4x     = _mm_set_ps1((texture) ? (f32)texture->dim.h : 0);
+	if (texture) DQN_ASSERT(texture->bytesPerPixel == ((texLinear16) ? sizeof(u64) : sizeof(u32)));
+
+	const i32 zBufferPitch = renderBuffer->width;
+	const i32 pitchInU32   = (renderBuffer->width * renderBuffer->bytesPerPixel) / 4;
+
+	// NOTE: Unorm depths are quantised and tested as integers, they're at most 24 bits so the
+	// signed compare is fine. Truncating after adding a half rounds the same as the slow path.
+	const bool depthUnorm             = (renderBuffer->depthFormat != DTRRenderDepthFormat_F32);
+	const f32 depthBlockEpsilon       = DepthBlockEpsilonInternal(renderBuffer);
+	const __m128 depthToUnorm_4x      = _mm_set_ps1(DepthToUnormScaleInternal(renderBuffer->depthFormat));
+	const __m128 DEPTH_RANGE_4X       = _mm_set_ps1(DTRRENDER_DEPTH_RANGE);
+	const __m128 HALF_4X              = _mm_set_ps1(0.5f);
+	const __m128i DEPTH_UNORM_BIAS_4X = _mm_set1_epi32(1);
+
+	// NOTE: Depth blocks are only safe to read and update when no other thread can write to them
+	DTRRenderDepthBlock *const depthBlocks = (lockPixels) ? NULL : renderBuffer->zBufferBlocks;
+	const i32 depthBlockPitch              = DTRRender_DepthBlockPitch(renderBuffer);
+
+	// NOTE: Small triangles aren't worth testing block by block, they're rasterised as one rect.
+	// The whole triangle has already been tested against the blocks by the caller.
+	const bool walkBlocks =
+	    depthBlocks && ((max.x - min.x) * (max.y - min.y)) >= DEPTH_BLOCK_WALK_MIN_AREA;
+	const i32 stepX  = (walkBlocks) ? BLOCK_SIZE : (max.x - min.x);
+	const i32 stepY  = (walkBlocks) ? BLOCK_SIZE : (max.y - min.y);
+	const i32 startX = (walkBlocks) ? (min.x - (min.x % BLOCK_SIZE)) : min.x;
+	const i32 startY = (walkBlocks) ? (min.y - (min.y % BLOCK_SIZE)) : min.y;
+	DEBUG_SIMD_AUTO_CHOOSE_END_CYCLE_COUNT(Triangle_Preamble_SIMDStep);
 	DEBUG_SIMD_AUTO_CHOOSE_END_CYCLE_COUNT(Triangle_Preamble);
-	const u32 IS_GREATER_MASK = 0xF;
-	const u32 zBufferPitch    = renderBuffer->width;
 
 	////////////////////////////////////////////////////////////////////////////
 	// Scan and Render
 	////////////////////////////////////////////////////////////////////////////
 	DEBUG_SIMD_AUTO_CHOOSE_BEGIN_CYCLE_COUNT(Triangle_Rasterise);
-	for (i32 bufferY = min.y; bufferY < max.y; bufferY += NUM_Y_PIXELS_TO_SIMD)
+	for (i32 blockY = startY; blockY < max.y; blockY += stepY)
 	{
-		__m128 signedArea1 = signedAreaPixel1;
-		// __m128 signedArea2 = signedAreaPixel2;
-
-		for (i32 bufferX = min.x; bufferX < max.x; bufferX += NUM_X_PIXELS_TO_SIMD)
+		for (i32 blockX = startX; blockX < max.x; blockX += stepX)
 		{
-			// Rasterise buffer(X, Y) pixel
+			////////////////////////////////////////////////////////////////////
+			// Coarse Test
+			////////////////////////////////////////////////////////////////////
+			DqnV2i rectMin = DqnV2i_2i(DQN_MAX(blockX, min.x), DQN_MAX(blockY, min.y));
+			DqnV2i rectMax = DqnV2i_2i(DQN_MIN(blockX + stepX, max.x), DQN_MIN(blockY + stepY, max.y));
+
+			DepthBlockTest blockTest        = {};
+			DTRRenderDepthBlock *depthBlock = NULL;
+			bool skipDepthTest              = false;
+			bool coversWholeBlock           = false;
+			if (walkBlocks)
+			{
+				blockTest = SIMDTriangleTestRect(&setup, rectMin, rectMax, depthBlockEpsilon);
+				if (blockTest.isOutside) continue;
+			}
+
+			DepthBlocksLazyClearRect(context, rectMin, rectMax);
+			if (walkBlocks)
 			{
-				__m128 checkArea    = signedArea1;
-				__m128 isGreater    = _mm_cmpge_ps(checkArea, ZERO_4X);
-				i32 isGreaterResult = _mm_movemask_ps(isGreater);
-				i32 posX            = bufferX;
-				i32 posY            = bufferY;
+				depthBlock = depthBlocks + (blockX / BLOCK_SIZE) + ((blockY / BLOCK_SIZE) * depthBlockPitch);
+
+				// NOTE: Triangle is behind every pixel in the block
+				if (blockTest.maxZ <= depthBlock->min) continue;
+				skipDepthTest    = blockTest.isFullyCovered && blockTest.minZ > depthBlock->max;
+				coversWholeBlock = blockTest.isFullyCovered &&
+				                   rectMin.x == blockX && rectMax.x == blockX + BLOCK_SIZE &&
+				                   rectMin.y == blockY && rectMax.y == blockY + BLOCK_SIZE;
+			}
+
+			for (i32 bufferY = rectMin.y; bufferY < rectMax.y; bufferY++)
+			{
+				__m128i edge1Span = _mm_add_epi32(_mm_set1_epi32(TriangleEdgesEvaluate(&setup.edges, 0, rectMin.x, bufferY)), edge1LaneOffset_4x);
+				__m128i edge2Span = _mm_add_epi32(_mm_set1_epi32(TriangleEdgesEvaluate(&setup.edges, 1, rectMin.x, bufferY)), edge2LaneOffset_4x);
+				__m128i edge3Span = _mm_add_epi32(_mm_set1_epi32(TriangleEdgesEvaluate(&setup.edges, 2, rectMin.x, bufferY)), edge3LaneOffset_4x);
 
-				if ((isGreaterResult & IS_GREATER_MASK) == IS_GREATER_MASK)
+				f32 *const zBufferRow = (f32 *)renderBuffer->zBuffer + (bufferY * zBufferPitch);
+				u32 *const pixelRow   = (u32 *)renderBuffer->memory + (bufferY * pitchInU32);
+				for (i32 bufferX = rectMin.x; bufferX < rectMax.x; bufferX += NUM_X_PIXELS_TO_SIMD)
 				{
+					const __m128i edge1 = edge1Span;
+					const __m128i edge2 = edge2Span;
+					const __m128i edge3 = edge3Span;
+					edge1Span           = _mm_add_epi32(edge1Span, edge1Step_4x);
+					edge2Span           = _mm_add_epi32(edge2Span, edge2Step_4x);
+					edge3Span           = _mm_add_epi32(edge3Span, edge3Step_4x);
+
+					__m128 isInside = _mm_castsi128_ps(
+					    _mm_and_si128(_mm_cmpgt_epi32(edge1, edge1Bias_4x),
+					                  _mm_and_si128(_mm_cmpgt_epi32(edge2, edge2Bias_4x),
+					                                _mm_cmpgt_epi32(edge3, edge3Bias_4x))));
+
+					// NOTE: The span may hang over the right of the rect, those lanes must never be
+					// written since they may belong to another thread.
+					const i32 numLanes = DQN_MIN(rectMax.x - bufferX, NUM_X_PIXELS_TO_SIMD);
+					if (numLanes < NUM_X_PIXELS_TO_SIMD)
+						isInside = _mm_and_ps(isInside, _mm_cmplt_ps(LANE_OFFSET_4X, _mm_set_ps1((f32)numLanes)));
+
+					const i32 coverageMask = _mm_movemask_ps(isInside);
+					if (coverageMask == 0) continue;
+
 					DEBUG_SIMD_AUTO_CHOOSE_BEGIN_CYCLE_COUNT(Triangle_RasterisePixel);
-					__m128 barycentric  = _mm_mul_ps(checkArea, invSignedAreaParallelogram_4x);
-					__m128 barycentricZ = _mm_mul_ps(triangleZ, barycentric);
+					__m128 barycentricA = _mm_mul_ps(_mm_cvtepi32_ps(edge1), invSignedAreaParallelogram_4x);
+					__m128 barycentricB = _mm_mul_ps(_mm_cvtepi32_ps(edge2), invSignedAreaParallelogram_4x);
+					__m128 barycentricC = _mm_mul_ps(_mm_cvtepi32_ps(edge3), invSignedAreaParallelogram_4x);
 
-					f32 pixelZDepth  = ((f32 *)&barycentricZ)[0] +
-					                   ((f32 *)&barycentricZ)[1] +
-					                   ((f32 *)&barycentricZ)[2];
+					__m128 pixelZDepth = _mm_add_ps(_mm_add_ps(_mm_mul_ps(p1Z_4x, barycentricA),
+					                                           _mm_mul_ps(p2Z_4x, barycentricB)),
+					                                _mm_mul_ps(p3Z_4x, barycentricC));
 
-					i32 zBufferIndex = posX + (posY * zBufferPitch);
-					if (context.multithread)
+					if (lockPixels)
 					{
-						bool currLockValue;
-						do
+						for (i32 lane = 0; lane < NUM_X_PIXELS_TO_SIMD; lane++)
 						{
-							currLockValue = (bool)context.api->AtomicCompareSwap(
-							    (u32 *)&renderBuffer->pixelLockTable[zBufferIndex], (u32) true,
-							    (u32) false);
-						} while (currLockValue != false);
+							if (coverageMask & (1 << lane))
+								AcquirePixelLock(context, bufferX + lane + (bufferY * zBufferPitch));
+						}
 					}
 
-					if (pixelZDepth > renderBuffer->zBuffer[zBufferIndex])
+					// NOTE: Reading past the rect is fine as long as it's within the row
+					const i32 zBufferIndex = bufferX + (bufferY * zBufferPitch);
+					const bool fullSpan    = (bufferX + NUM_X_PIXELS_TO_SIMD <= renderBuffer->width);
+					__m128 currZDepth      = ZERO_4X;
+					__m128i srcPixel       = _mm_setzero_si128();
+					if (fullSpan)
 					{
-						__m128 finalColor                   = simdColor;
-						renderBuffer->zBuffer[zBufferIndex] = pixelZDepth;
-						if (!ignoreLight)
+						if (!depthUnorm)  currZDepth = _mm_loadu_ps(zBufferRow + bufferX);
+						if (!blendOpaque) srcPixel   = _mm_loadu_si128((__m128i *)(pixelRow + bufferX));
+					}
+					else
+					{
+						f32 zLanes[4]     = {};
+						u32 pixelLanes[4] = {};
+						for (i32 lane = 0; lane < numLanes; lane++)
 						{
-							__m128 barycentricA_4x = _mm_set_ps1(((f32 *)&barycentric)[0]);
-							__m128 barycentricB_4x = _mm_set_ps1(((f32 *)&barycentric)[1]);
-							__m128 barycentricC_4x = _mm_set_ps1(((f32 *)&barycentric)[2]);
+							if (!depthUnorm)  zLanes[lane]     = zBufferRow[bufferX + lane];
+							if (!blendOpaque) pixelLanes[lane] = pixelRow[bufferX + lane];
+						}
+						currZDepth = _mm_loadu_ps(zLanes);
+						srcPixel   = _mm_loadu_si128((__m128i *)pixelLanes);
+					}
 
-							__m128 barycentricLight1 = _mm_mul_ps(p1Light, barycentricA_4x);
-							__m128 barycentricLight2 = _mm_mul_ps(p2Light, barycentricB_4x);
-							__m128 barycentricLight3 = _mm_mul_ps(p3Light, barycentricC_4x);
+					__m128 depthPass = isInside;
+					__m128i pixelDepthUnorm = _mm_setzero_si128();
+					if (depthUnorm)
+					{
+						__m128 clampedZ = _mm_min_ps(_mm_max_ps(pixelZDepth, ZERO_4X), DEPTH_RANGE_4X);
+						pixelDepthUnorm = _mm_add_epi32(
+						    _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(clampedZ, depthToUnorm_4x), HALF_4X)),
+						    DEPTH_UNORM_BIAS_4X);
 
-							__m128 light =
-							    _mm_add_ps(barycentricLight3,
-							               _mm_add_ps(barycentricLight1, barycentricLight2));
+						if (!skipDepthTest)
+						{
+							__m128i currDepthUnorm = SIMDDepthLoadUnorm(
+							    renderBuffer, zBufferIndex, (fullSpan) ? NUM_X_PIXELS_TO_SIMD : numLanes);
+							depthPass = _mm_and_ps(isInside, _mm_castsi128_ps(_mm_cmpgt_epi32(
+							                                     pixelDepthUnorm, currDepthUnorm)));
+						}
+					}
+					else if (!skipDepthTest)
+					{
+						depthPass = _mm_and_ps(isInside, _mm_cmpgt_ps(pixelZDepth, currZDepth));
+					}
 
-							finalColor              = _mm_mul_ps(finalColor, light);
-							((f32 *)&finalColor)[3] = preserveAlpha;
+					const i32 writeMask = _mm_movemask_ps(depthPass);
+					if (writeMask)
+					{
+						////////////////////////////////////////////////////////////
+						// Shade
+						////////////////////////////////////////////////////////////
+						__m128 finalR = colorR_4x;
+						__m128 finalG = colorG_4x;
+						__m128 finalB = colorB_4x;
+						__m128 finalA = colorA_4x;
+						if (!ignoreLight)
+						{
+							__m128 lightR = _mm_add_ps(_mm_mul_ps(p3LightR_4x, barycentricC),
+							                           _mm_add_ps(_mm_mul_ps(p1LightR_4x, barycentricA),
+							                                      _mm_mul_ps(p2LightR_4x, barycentricB)));
+							__m128 lightG = _mm_add_ps(_mm_mul_ps(p3LightG_4x, barycentricC),
+							                           _mm_add_ps(_mm_mul_ps(p1LightG_4x, barycentricA),
+							                                      _mm_mul_ps(p2LightG_4x, barycentricB)));
+							__m128 lightB = _mm_add_ps(_mm_mul_ps(p3LightB_4x, barycentricC),
+							                           _mm_add_ps(_mm_mul_ps(p1LightB_4x, barycentricA),
+							                                      _mm_mul_ps(p2LightB_4x, barycentricB)));
+							finalR = _mm_mul_ps(finalR, lightR);
+							finalG = _mm_mul_ps(finalG, lightG);
+							finalB = _mm_mul_ps(finalB, lightB);
 						}
 
 						if (texture)
 						{
-							__m128 texSampledColor = SIMDSampleTextureForTriangle(
-							    texture, uv1, uv2SubUv1, uv3SubUv1, barycentric);
-							finalColor = _mm_mul_ps(texSampledColor, finalColor);
+							DTRDebug_BeginCycleCount("SIMDTexturedTriangle_SampleTexture",
+							                         DTRDebugCycleCount_SIMDTexturedTriangle_SampleTexture);
+							__m128 u = _mm_add_ps(_mm_add_ps(uv1X_4x, _mm_mul_ps(uv2SubUv1X_4x, barycentricB)),
+							                      _mm_mul_ps(uv3SubUv1X_4x, barycentricC));
+							__m128 v = _mm_add_ps(_mm_add_ps(uv1Y_4x, _mm_mul_ps(uv2SubUv1Y_4x, barycentricB)),
+							                      _mm_mul_ps(uv3SubUv1Y_4x, barycentricC));
+							u = _mm_min_ps(_mm_max_ps(u, ZERO_4X), ONE_4X);
+							v = _mm_min_ps(_mm_max_ps(v, ZERO_4X), ONE_4X);
+
+							__m128i texelX = _mm_cvttps_epi32(_mm_min_ps(_mm_mul_ps(u, texDimW_4x), texMaxX_4x));
+							__m128i texelY = _mm_cvttps_epi32(_mm_min_ps(_mm_mul_ps(v, texDimH_4x), texMaxY_4x));
+
+							i32 texelXLanes[4], texelYLanes[4];
+							_mm_storeu_si128((__m128i *)texelXLanes, texelX);
+							_mm_storeu_si128((__m128i *)texelYLanes, texelY);
+
+							__m128 texR, texG, texB, texA;
+							if (texLinear16)
+							{
+								u64 texelLanes[4];
+								for (i32 lane = 0; lane < NUM_X_PIXELS_TO_SIMD; lane++)
+									texelLanes[lane] = texture16[DTRAsset_BitmapTexelIndex(texture, texelXLanes[lane], texelYLanes[lane])];
+
+								// Texel Format: AAAA BBBB GGGG RRRR, gather the GGRR and AABB halves of each texel
+								__m128i texel01 = _mm_shuffle_epi32(_mm_loadu_si128((__m128i *)(texelLanes + 0)), _MM_SHUFFLE(3, 1, 2, 0));
+								__m128i texel23 = _mm_shuffle_epi32(_mm_loadu_si128((__m128i *)(texelLanes + 2)), _MM_SHUFFLE(3, 1, 2, 0));
+								__m128i texelGR = _mm_unpacklo_epi64(texel01, texel23);
+								__m128i texelAB = _mm_unpackhi_epi64(texel01, texel23);
+
+								texR = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(texelGR, MASK_FFFF_4X)), INV65535_4X);
+								texG = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(texelGR, 16)), INV65535_4X);
+								texB = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(texelAB, MASK_FFFF_4X)), INV65535_4X);
+								texA = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(texelAB, 16)), INV65535_4X);
+							}
+							else
+							{
+								u32 texelLanes[4];
+								for (i32 lane = 0; lane < NUM_X_PIXELS_TO_SIMD; lane++)
+									texelLanes[lane] = texturePtr[DTRAsset_BitmapTexelIndex(texture, texelXLanes[lane], texelYLanes[lane])];
+
+								// Texel Format: AA BB GG RR
+								__m128i texel = _mm_loadu_si128((__m128i *)texelLanes);
+								texR          = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(texel, MASK_FF_4X)), INV255_4X);
+								texG          = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(texel, 8), MASK_FF_4X)), INV255_4X);
+								texB          = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(texel, 16), MASK_FF_4X)), INV255_4X);
+								texA          = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(texel, 24)), INV255_4X);
+								texR          = _mm_mul_ps(texR, texR);
+								texG          = _mm_mul_ps(texG, texG);
+								texB          = _mm_mul_ps(texB, texB);
+							}
+
+							finalR = _mm_mul_ps(finalR, texR);
+							finalG = _mm_mul_ps(finalG, texG);
+							finalB = _mm_mul_ps(finalB, texB);
+							finalA = _mm_mul_ps(finalA, texA);
+							DTRDebug_EndCycleCount(DTRDebugCycleCount_SIMDTexturedTriangle_SampleTexture);
 						}
 
-						SIMDSetPixel(context, posX, posY, finalColor, ColorSpace_Linear);
-					}
-					renderBuffer->pixelLockTable[zBufferIndex] = false;
-					DEBUG_SIMD_AUTO_CHOOSE_END_CYCLE_COUNT(Triangle_RasterisePixel);
-				}
-				signedArea1 = _mm_add_ps(signedArea1, signedAreaPixelDeltaX);
-			}
-		}
-		signedAreaPixel1 = _mm_add_ps(signedAreaPixel1, signedAreaPixelDeltaY);
-		// signedAreaPixel2 = _mm_add_ps(signedAreaPixel2, signedAreaPixelDeltaY);
+						////////////////////////////////////////////////////////////
+						// Blend, PreAlphaMulColor + (1 - Alpha) * Src, see DTRRenderBlendMode
+						////////////////////////////////////////////////////////////
+						// NOTE: The SRGB conversion is done in registers instead of the color tables,
+						// gathering from the tables measured slower than 2 muls and a sqrt. The results
+						// are identical since the tables are built from the same expressions.
+						__m128 destR = finalR;
+						__m128 destG = finalG;
+						__m128 destB = finalB;
+						if (!blendOpaque)
+						{
+							// Pixel Format: XX RR GG BB
+							__m128 srcR = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(srcPixel, 16), MASK_FF_4X)), INV255_4X);
+							__m128 srcG = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(srcPixel, 8), MASK_FF_4X)), INV255_4X);
+							__m128 srcB = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(srcPixel, MASK_FF_4X)), INV255_4X);
+
+							__m128 invA = (blendAdditive) ? ONE_4X : _mm_sub_ps(ONE_4X, finalA);
+							destR      = _mm_add_ps(finalR, _mm_mul_ps(invA, _mm_mul_ps(srcR, srcR)));
+							destG      = _mm_add_ps(finalG, _mm_mul_ps(invA, _mm_mul_ps(srcG, srcG)));
+							destB      = _mm_add_ps(finalB, _mm_mul_ps(invA, _mm_mul_ps(srcB, srcB)));
+						}
+
+						destR = _mm_min_ps(_mm_mul_ps(_mm_sqrt_ps(destR), MAX_255_4X), MAX_255_4X);
+						destG = _mm_min_ps(_mm_mul_ps(_mm_sqrt_ps(destG), MAX_255_4X), MAX_255_4X);
+						destB = _mm_min_ps(_mm_mul_ps(_mm_sqrt_ps(destB), MAX_255_4X), MAX_255_4X);
+
+						__m128i destPixel = _mm_or_si128(_mm_slli_epi32(_mm_cvttps_epi32(destR), 16),
+						                                 _mm_or_si128(_mm_slli_epi32(_mm_cvttps_epi32(destG), 8),
+						                                              _mm_cvttps_epi32(destB)));
+
+						////////////////////////////////////////////////////////////
+						// Write
+						////////////////////////////////////////////////////////////
+						if (writeMask == ALL_LANES_MASK)
+						{
+							if (!depthUnorm) _mm_storeu_ps(zBufferRow + bufferX, pixelZDepth);
+							_mm_storeu_si128((__m128i *)(pixelRow + bufferX), destPixel);
+						}
+						else
+						{
+							f32 zLanes[4];
+							u32 pixelLanes[4];
+							_mm_storeu_ps(zLanes, pixelZDepth);
+							_mm_storeu_si128((__m128i *)pixelLanes, destPixel);
+							for (i32 lane = 0; lane < NUM_X_PIXELS_TO_SIMD; lane++)
+							{
+								if (writeMask & (1 << lane))
+								{
+									if (!depthUnorm) zBufferRow[bufferX + lane] = zLanes[lane];
+									pixelRow[bufferX + lane] = pixelLanes[lane];
+								}
+							}
+						}
+
+						if (depthUnorm) SIMDDepthStoreUnorm(renderBuffer, zBufferIndex, pixelDepthUnorm, writeMask);
+					}
+
+					if (lockPixels)
+					{
+						for (i32 lane = 0; lane < NUM_X_PIXELS_TO_SIMD; lane++)
+						{
+							if (coverageMask & (1 << lane))
+								renderBuffer->pixelLockTable[bufferX + lane + (bufferY * zBufferPitch)] = false;
+						}
+					}
+					DEBUG_SIMD_AUTO_CHOOSE_END_CYCLE_COUNT(Triangle_RasterisePixel);
+				}
+			}
+
+			////////////////////////////////////////////////////////////////////
+			// Update Depth Block
+			////////////////////////////////////////////////////////////////////
+			// NOTE: The max is raised by the caller once the whole triangle is rasterised
+			if (coversWholeBlock) depthBlock->min = DepthBlockReadMin(renderBuffer, rectMin);
+		}
+	}
+
+	DEBUG_SIMD_AUTO_CHOOSE_END_CYCLE_COUNT(Triangle_Rasterise);
+	DEBUG_SIMD_AUTO_CHOOSE_END_CYCLE_COUNT(Triangle);
+}
+
+// AVX2 version of SIMDTriangle, rasterises 8 horizontally adjacent pixels per iteration and gathers
+// texels with a single instruction.
+DTR_TARGET_AVX2 FILE_SCOPE void SIMDTriangleAVX2(DTRRenderContext context, const DqnV3 p1, const DqnV3 p2,
+                                 const DqnV3 p3, const DqnV2 uv1, const DqnV2 uv2, const DqnV2 uv3,
+                                 const f32 lightIntensity1, const f32 lightIntensity2,
+                                 const f32 lightIntensity3, const bool ignoreLight,
+                                 DTRBitmap *const texture, DqnV4 color, const DqnV2i min,
+                                 const DqnV2i max, const bool lockPixels)
+
+{
+	DTR_DEBUG_EP_TIMED_FUNCTION();
+	DEBUG_SIMD_AUTO_CHOOSE_BEGIN_CYCLE_COUNT(Triangle);
+	DEBUG_SIMD_AUTO_CHOOSE_BEGIN_CYCLE_COUNT(Triangle_Preamble);
+
+	DTRRenderBuffer *const renderBuffer = context.renderBuffer;
+	const i32 NUM_X_PIXELS_TO_SIMD      = 8;
+	const i32 ALL_LANES_MASK            = 0xFF;
+	const i32 BLOCK_SIZE                = DTRRENDER_DEPTH_BLOCK_SIZE;
+
+	////////////////////////////////////////////////////////////////////////////
+	// Setup SIMD data
+	////////////////////////////////////////////////////////////////////////////
+	DEBUG_SIMD_AUTO_CHOOSE_BEGIN_CYCLE_COUNT(Triangle_Preamble_SArea);
+	SIMDTriangleSetup setup = {};
+	bool hasArea = SIMDTriangleSetupInternal(p1, p2, p3, uv1, uv2, uv3, lightIntensity1,
+	                                         lightIntensity2, lightIntensity3,
+	                                         DrawColorToLinearInternal(context, color), min, &setup);
+	DEBUG_SIMD_AUTO_CHOOSE_END_CYCLE_COUNT(Triangle_Preamble_SArea);
+	if (!hasArea)
+	{
+		DEBUG_SIMD_AUTO_CHOOSE_END_CYCLE_COUNT(Triangle_Preamble);
+		DEBUG_SIMD_AUTO_CHOOSE_END_CYCLE_COUNT(Triangle);
+		return;
+	}
+
+	DEBUG_SIMD_AUTO_CHOOSE_BEGIN_CYCLE_COUNT(Triangle_Preamble_SIMDStep);
+	const bool blendOpaque      = (context.blendMode == DTRRenderBlendMode_Opaque);
+	const bool blendAdditive    = (context.blendMode == DTRRenderBlendMode_Additive);
+	const __m256 ZERO_8X        = _mm256_set1_ps(0.0f);
+	const __m256 ONE_8X         = _mm256_set1_ps(1.0f);
+	const __m256 INV255_8X      = _mm256_set1_ps(DTRRENDER_INV_255);
+	const __m256 MAX_255_8X     = _mm256_set1_ps(255.0f);
+	const __m256i MASK_FF_8X    = _mm256_set1_epi32(0xFF);
+	const __m256 LANE_OFFSET_8X = _mm256_set_ps(7, 6, 5, 4, 3, 2, 1, 0);
+
+	// NOTE: Edges are integers so they're stepped by a whole span at a time without drifting
+	i32 edgeLaneOffset[3][8];
+	for (i32 edgeIndex = 0; edgeIndex < 3; edgeIndex++)
+	{
+		for (i32 lane = 0; lane < NUM_X_PIXELS_TO_SIMD; lane++)
+			edgeLaneOffset[edgeIndex][lane] = setup.edges.deltaX[edgeIndex] * lane;
+	}
+
+	const __m256i edge1LaneOffset_8x = _mm256_loadu_si256((__m256i *)edgeLaneOffset[0]);
+	const __m256i edge2LaneOffset_8x = _mm256_loadu_si256((__m256i *)edgeLaneOffset[1]);
+	const __m256i edge3LaneOffset_8x = _mm256_loadu_si256((__m256i *)edgeLaneOffset[2]);
+	const __m256i edge1Step_8x       = _mm256_set1_epi32(setup.edges.deltaX[0] * NUM_X_PIXELS_TO_SIMD);
+	const __m256i edge2Step_8x       = _mm256_set1_epi32(setup.edges.deltaX[1] * NUM_X_PIXELS_TO_SIMD);
+	const __m256i edge3Step_8x       = _mm256_set1_epi32(setup.edges.deltaX[2] * NUM_X_PIXELS_TO_SIMD);
+	const __m256i edge1Bias_8x       = _mm256_set1_epi32(setup.edges.bias[0]);
+	const __m256i edge2Bias_8x       = _mm256_set1_epi32(setup.edges.bias[1]);
+	const __m256i edge3Bias_8x       = _mm256_set1_epi32(setup.edges.bias[2]);
+
+	const __m256 invSignedAreaParallelogram_8x = _mm256_set1_ps(setup.invSignedAreaParallelogram);
+	const __m256 p1Z_8x = _mm256_set1_ps(p1.z);
+	const __m256 p2Z_8x = _mm256_set1_ps(p2.z);
+	const __m256 p3Z_8x = _mm256_set1_ps(p3.z);
+
+	const __m256 colorR_8x = _mm256_set1_ps(setup.color.r);
+	const __m256 colorG_8x = _mm256_set1_ps(setup.color.g);
+	const __m256 colorB_8x = _mm256_set1_ps(setup.color.b);
+	const __m256 colorA_8x = _mm256_set1_ps(setup.color.a);
+
+	const __m256 p1LightR_8x = _mm256_set1_ps(setup.pLight[0].r);
+	const __m256 p1LightG_8x = _mm256_set1_ps(setup.pLight[0].g);
+	const __m256 p1LightB_8x = _mm256_set1_ps(setup.pLight[0].b);
+	const __m256 p2LightR_8x = _mm256_set1_ps(setup.pLight[1].r);
+	const __m256 p2LightG_8x = _mm256_set1_ps(setup.pLight[1].g);
+	const __m256 p2LightB_8x = _mm256_set1_ps(setup.pLight[1].b);
+	const __m256 p3LightR_8x = _mm256_set1_ps(setup.pLight[2].r);
+	const __m256 p3LightG_8x = _mm256_set1_ps(setup.pLight[2].g);
+	const __m256 p3LightB_8x = _mm256_set1_ps(setup.pLight[2].b);
+
+	const __m256 uv1X_8x       = _mm256_set1_ps(uv1.x);
+	const __m256 uv1Y_8x       = _mm256_set1_ps(uv1.y);
+	const __m256 uv2SubUv1X_8x = _mm256_set1_ps(setup.uv2SubUv1.x);
+	const __m256 uv2SubUv1Y_8x = _mm256_set1_ps(setup.uv2SubUv1.y);
+	const __m256 uv3SubUv1X_8x = _mm256_set1_ps(setup.uv3SubUv1.x);
+	const __m256 uv3SubUv1Y_8x = _mm256_set1_ps(setup.uv3SubUv1.y);
+
+	const bool texLinear16      = (texture && texture->format == DTRBitmapFormat_Linear16);
+	const u32 *const texturePtr = (texture) ? (u32 *)texture->memory : NULL;
+	const __m256 INV65535_8X    = _mm256_set1_ps(DTRRENDER_INV_65535);
+	const __m256i MASK_FFFF_8X  = _mm256_set1_epi32(0xFFFF);
+	const __m256i SPLIT_U64_8X  = _mm256_set_epi32(7, 5, 3, 1, 6, 4, 2, 0);
+	const __m256 texMaxX_8x     = _mm256_set1_ps((texture) ? (f32)(texture->dim.w - 1) : 0);
+	const __m256 texMaxY_8x     = _mm256_set1_ps((texture) ? (f32)(texture->dim.h - 1) : 0);
+	const __m256 texDimW_8x     = _mm256_set1_ps((texture) ? (f32)texture->dim.w : 0);
+	const __m256 texDimH_8x     = _mm256_set1_ps((texture) ? (f32)texture->dim.h : 0);
+	const __m256i texPitch_8x   = _mm256_set1_epi32((texture) ? DTRAsset_BitmapPitch(texture) : 0);
+	const bool texTiled         = (texture && texture->layout == DTRBitmapLayout_Tiled4x4);
+	const __m256i MASK_3_8X     = _mm256_set1_epi32(3);
+	if (texture) DQN_ASSERT(texture->bytesPerPixel == ((texLinear16) ? sizeof(u64) : sizeof(u32)));
+
+	const i32 zBufferPitch = renderBuffer->width;
+	const i32 pitchInU32   = (renderBuffer->width * renderBuffer->bytesPerPixel) / 4;
+
+	const bool depthUnorm             = (renderBuffer->depthFormat != DTRRenderDepthFormat_F32);
+	const f32 depthBlockEpsilon       = DepthBlockEpsilonInternal(renderBuffer);
+	const __m256 depthToUnorm_8x      = _mm256_set1_ps(DepthToUnormScaleInternal(renderBuffer->depthFormat));
+	const __m256 DEPTH_RANGE_8X       = _mm256_set1_ps(DTRRENDER_DEPTH_RANGE);
+	const __m256 HALF_8X              = _mm256_set1_ps(0.5f);
+	const __m256i DEPTH_UNORM_BIAS_8X = _mm256_set1_epi32(1);
+
+	// NOTE: Depth blocks are only safe to read and update when no other thread can write to them
+	DTRRenderDepthBlock *const depthBlocks = (lockPixels) ? NULL : renderBuffer->zBufferBlocks;
+	const i32 depthBlockPitch              = DTRRender_DepthBlockPitch(renderBuffer);
+
+	// NOTE: Small triangles aren't worth testing block by block, they're rasterised as one rect.
+	// The whole triangle has already been tested against the blocks by the caller.
+	const bool walkBlocks =
+	    depthBlocks && ((max.x - min.x) * (max.y - min.y)) >= DEPTH_BLOCK_WALK_MIN_AREA;
+	const i32 stepX  = (walkBlocks) ? BLOCK_SIZE : (max.x - min.x);
+	const i32 stepY  = (walkBlocks) ? BLOCK_SIZE : (max.y - min.y);
+	const i32 startX = (walkBlocks) ? (min.x - (min.x % BLOCK_SIZE)) : min.x;
+	const i32 startY = (walkBlocks) ? (min.y - (min.y % BLOCK_SIZE)) : min.y;
+	DEBUG_SIMD_AUTO_CHOOSE_END_CYCLE_COUNT(Triangle_Preamble_SIMDStep);
+	DEBUG_SIMD_AUTO_CHOOSE_END_CYCLE_COUNT(Triangle_Preamble);
+
+	////////////////////////////////////////////////////////////////////////////
+	// Scan and Render
+	////////////////////////////////////////////////////////////////////////////
+	DEBUG_SIMD_AUTO_CHOOSE_BEGIN_CYCLE_COUNT(Triangle_Rasterise);
+	for (i32 blockY = startY; blockY < max.y; blockY += stepY)
+	{
+		for (i32 blockX = startX; blockX < max.x; blockX += stepX)
+		{
+			////////////////////////////////////////////////////////////////////
+			// Coarse Test
+			////////////////////////////////////////////////////////////////////
+			DqnV2i rectMin = DqnV2i_2i(DQN_MAX(blockX, min.x), DQN_MAX(blockY, min.y));
+			DqnV2i rectMax = DqnV2i_2i(DQN_MIN(blockX + stepX, max.x), DQN_MIN(blockY + stepY, max.y));
+
+			DepthBlockTest blockTest        = {};
+			DTRRenderDepthBlock *depthBlock = NULL;
+			bool skipDepthTest              = false;
+			bool coversWholeBlock           = false;
+			if (walkBlocks)
+			{
+				blockTest = SIMDTriangleTestRect(&setup, rectMin, rectMax, depthBlockEpsilon);
+				if (blockTest.isOutside) continue;
+			}
+
+			DepthBlocksLazyClearRect(context, rectMin, rectMax);
+			if (walkBlocks)
+			{
+				depthBlock = depthBlocks + (blockX / BLOCK_SIZE) + ((blockY / BLOCK_SIZE) * depthBlockPitch);
+
+				// NOTE: Triangle is behind every pixel in the block
+				if (blockTest.maxZ <= depthBlock->min) continue;
+				skipDepthTest    = blockTest.isFullyCovered && blockTest.minZ > depthBlock->max;
+				coversWholeBlock = blockTest.isFullyCovered &&
+				                   rectMin.x == blockX && rectMax.x == blockX + BLOCK_SIZE &&
+				                   rectMin.y == blockY && rectMax.y == blockY + BLOCK_SIZE;
+			}
+
+			for (i32 bufferY = rectMin.y; bufferY < rectMax.y; bufferY++)
+			{
+				__m256i edge1Span = _mm256_add_epi32(_mm256_set1_epi32(TriangleEdgesEvaluate(&setup.edges, 0, rectMin.x, bufferY)), edge1LaneOffset_8x);
+				__m256i edge2Span = _mm256_add_epi32(_mm256_set1_epi32(TriangleEdgesEvaluate(&setup.edges, 1, rectMin.x, bufferY)), edge2LaneOffset_8x);
+				__m256i edge3Span = _mm256_add_epi32(_mm256_set1_epi32(TriangleEdgesEvaluate(&setup.edges, 2, rectMin.x, bufferY)), edge3LaneOffset_8x);
+
+				f32 *const zBufferRow = (f32 *)renderBuffer->zBuffer + (bufferY * zBufferPitch);
+				u32 *const pixelRow   = (u32 *)renderBuffer->memory + (bufferY * pitchInU32);
+				for (i32 bufferX = rectMin.x; bufferX < rectMax.x; bufferX += NUM_X_PIXELS_TO_SIMD)
+				{
+					const __m256i edge1 = edge1Span;
+					const __m256i edge2 = edge2Span;
+					const __m256i edge3 = edge3Span;
+					edge1Span           = _mm256_add_epi32(edge1Span, edge1Step_8x);
+					edge2Span           = _mm256_add_epi32(edge2Span, edge2Step_8x);
+					edge3Span           = _mm256_add_epi32(edge3Span, edge3Step_8x);
+
+					__m256 isInside = _mm256_castsi256_ps(
+					    _mm256_and_si256(_mm256_cmpgt_epi32(edge1, edge1Bias_8x),
+					                     _mm256_and_si256(_mm256_cmpgt_epi32(edge2, edge2Bias_8x),
+					                                      _mm256_cmpgt_epi32(edge3, edge3Bias_8x))));
+
+					// NOTE: The span may hang over the right of the rect, those lanes must never be
+					// written since they may belong to another thread.
+					const i32 numLanes = DQN_MIN(rectMax.x - bufferX, NUM_X_PIXELS_TO_SIMD);
+					if (numLanes < NUM_X_PIXELS_TO_SIMD)
+						isInside = _mm256_and_ps(isInside, _mm256_cmp_ps(LANE_OFFSET_8X, _mm256_set1_ps((f32)numLanes), _CMP_LT_OQ));
+
+					const i32 coverageMask = _mm256_movemask_ps(isInside);
+					if (coverageMask == 0) continue;
+
+					DEBUG_SIMD_AUTO_CHOOSE_BEGIN_CYCLE_COUNT(Triangle_RasterisePixel);
+					__m256 barycentricA = _mm256_mul_ps(_mm256_cvtepi32_ps(edge1), invSignedAreaParallelogram_8x);
+					__m256 barycentricB = _mm256_mul_ps(_mm256_cvtepi32_ps(edge2), invSignedAreaParallelogram_8x);
+					__m256 barycentricC = _mm256_mul_ps(_mm256_cvtepi32_ps(edge3), invSignedAreaParallelogram_8x);
+
+					__m256 pixelZDepth = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(p1Z_8x, barycentricA),
+					                                                 _mm256_mul_ps(p2Z_8x, barycentricB)),
+					                                   _mm256_mul_ps(p3Z_8x, barycentricC));
+
+					if (lockPixels)
+					{
+						for (i32 lane = 0; lane < NUM_X_PIXELS_TO_SIMD; lane++)
+						{
+							if (coverageMask & (1 << lane))
+								AcquirePixelLock(context, bufferX + lane + (bufferY * zBufferPitch));
+						}
+					}
+
+					// NOTE: Reading past the rect is fine as long as it's within the row
+					const i32 zBufferIndex = bufferX + (bufferY * zBufferPitch);
+					const bool fullSpan    = (bufferX + NUM_X_PIXELS_TO_SIMD <= renderBuffer->width);
+					__m256 currZDepth      = ZERO_8X;
+					__m256i srcPixel       = _mm256_setzero_si256();
+					if (fullSpan)
+					{
+						if (!depthUnorm)  currZDepth = _mm256_loadu_ps(zBufferRow + bufferX);
+						if (!blendOpaque) srcPixel   = _mm256_loadu_si256((__m256i *)(pixelRow + bufferX));
+					}
+					else
+					{
+						f32 zLanes[8]     = {};
+						u32 pixelLanes[8] = {};
+						for (i32 lane = 0; lane < numLanes; lane++)
+						{
+							if (!depthUnorm)  zLanes[lane]     = zBufferRow[bufferX + lane];
+							if (!blendOpaque) pixelLanes[lane] = pixelRow[bufferX + lane];
+						}
+						currZDepth = _mm256_loadu_ps(zLanes);
+						srcPixel   = _mm256_loadu_si256((__m256i *)pixelLanes);
+					}
+
+					__m256 depthPass = isInside;
+					__m256i pixelDepthUnorm = _mm256_setzero_si256();
+					if (depthUnorm)
+					{
+						__m256 clampedZ = _mm256_min_ps(_mm256_max_ps(pixelZDepth, ZERO_8X), DEPTH_RANGE_8X);
+						pixelDepthUnorm = _mm256_add_epi32(
+						    _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(clampedZ, depthToUnorm_8x), HALF_8X)),
+						    DEPTH_UNORM_BIAS_8X);
+
+						if (!skipDepthTest)
+						{
+							__m256i currDepthUnorm = SIMDDepthLoadUnormAVX2(
+							    renderBuffer, zBufferIndex, (fullSpan) ? NUM_X_PIXELS_TO_SIMD : numLanes);
+							depthPass = _mm256_and_ps(isInside, _mm256_castsi256_ps(_mm256_cmpgt_epi32(
+							                                        pixelDepthUnorm, currDepthUnorm)));
+						}
+					}
+					else if (!skipDepthTest)
+					{
+						depthPass = _mm256_and_ps(isInside, _mm256_cmp_ps(pixelZDepth, currZDepth, _CMP_GT_OQ));
+					}
+
+					const i32 writeMask = _mm256_movemask_ps(depthPass);
+					if (writeMask)
+					{
+						////////////////////////////////////////////////////////////
+						// Shade
+						////////////////////////////////////////////////////////////
+						__m256 finalR = colorR_8x;
+						__m256 finalG = colorG_8x;
+						__m256 finalB = colorB_8x;
+						__m256 finalA = colorA_8x;
+						if (!ignoreLight)
+						{
+							__m256 lightR = _mm256_add_ps(_mm256_mul_ps(p3LightR_8x, barycentricC),
+							                              _mm256_add_ps(_mm256_mul_ps(p1LightR_8x, barycentricA),
+							                                            _mm256_mul_ps(p2LightR_8x, barycentricB)));
+							__m256 lightG = _mm256_add_ps(_mm256_mul_ps(p3LightG_8x, barycentricC),
+							                              _mm256_add_ps(_mm256_mul_ps(p1LightG_8x, barycentricA),
+							                                            _mm256_mul_ps(p2LightG_8x, barycentricB)));
+							__m256 lightB = _mm256_add_ps(_mm256_mul_ps(p3LightB_8x, barycentricC),
+							                              _mm256_add_ps(_mm256_mul_ps(p1LightB_8x, barycentricA),
+							                                            _mm256_mul_ps(p2LightB_8x, barycentricB)));
+							finalR = _mm256_mul_ps(finalR, lightR);
+							finalG = _mm256_mul_ps(finalG, lightG);
+							finalB = _mm256_mul_ps(finalB, lightB);
+						}
+
+						if (texture)
+						{
+							DTRDebug_BeginCycleCount("SIMDTexturedTriangle_SampleTexture",
+							                         DTRDebugCycleCount_SIMDTexturedTriangle_SampleTexture);
+							__m256 u = _mm256_add_ps(_mm256_add_ps(uv1X_8x, _mm256_mul_ps(uv2SubUv1X_8x, barycentricB)),
+							                         _mm256_mul_ps(uv3SubUv1X_8x, barycentricC));
+							__m256 v = _mm256_add_ps(_mm256_add_ps(uv1Y_8x, _mm256_mul_ps(uv2SubUv1Y_8x, barycentricB)),
+							                         _mm256_mul_ps(uv3SubUv1Y_8x, barycentricC));
+							u = _mm256_min_ps(_mm256_max_ps(u, ZERO_8X), ONE_8X);
+							v = _mm256_min_ps(_mm256_max_ps(v, ZERO_8X), ONE_8X);
+
+							__m256i texelX = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_mul_ps(u, texDimW_8x), texMaxX_8x));
+							__m256i texelY = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_mul_ps(v, texDimH_8x), texMaxY_8x));
+
+							// NOTE: See DTRAsset_BitmapTexelIndex()
+							__m256i texelIndex;
+							if (texTiled)
+							{
+								__m256i tileIndex = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_andnot_si256(MASK_3_8X, texelY), texPitch_8x),
+								                                     _mm256_slli_epi32(_mm256_andnot_si256(MASK_3_8X, texelX), 2));
+								__m256i inTileIndex = _mm256_add_epi32(_mm256_slli_epi32(_mm256_and_si256(texelY, MASK_3_8X), 2),
+								                                       _mm256_and_si256(texelX, MASK_3_8X));
+								texelIndex = _mm256_add_epi32(tileIndex, inTileIndex);
+							}
+							else
+							{
+								texelIndex = _mm256_add_epi32(texelX, _mm256_mullo_epi32(texelY, texPitch_8x));
+							}
+
+							__m256 texR, texG, texB, texA;
+							if (texLinear16)
+							{
+								// Texel Format: AAAA BBBB GGGG RRRR, 4 texels per gather. Each gather is split
+								// into the GGRR halves in the low 128 bits and AABB halves in the high 128 bits.
+								__m256i texel0to3 = _mm256_i32gather_epi64((const long long *)texturePtr,
+								                                           _mm256_castsi256_si128(texelIndex), sizeof(u64));
+								__m256i texel4to7 = _mm256_i32gather_epi64((const long long *)texturePtr,
+								                                           _mm256_extracti128_si256(texelIndex, 1), sizeof(u64));
+								texel0to3         = _mm256_permutevar8x32_epi32(texel0to3, SPLIT_U64_8X);
+								texel4to7         = _mm256_permutevar8x32_epi32(texel4to7, SPLIT_U64_8X);
+								__m256i texelGR   = _mm256_permute2x128_si256(texel0to3, texel4to7, 0x20);
+								__m256i texelAB   = _mm256_permute2x128_si256(texel0to3, texel4to7, 0x31);
+
+								texR = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(texelGR, MASK_FFFF_8X)), INV65535_8X);
+								texG = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(texelGR, 16)), INV65535_8X);
+								texB = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(texelAB, MASK_FFFF_8X)), INV65535_8X);
+								texA = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(texelAB, 16)), INV65535_8X);
+							}
+							else
+							{
+								// Texel Format: AA BB GG RR
+								__m256i texel = _mm256_i32gather_epi32((const int *)texturePtr, texelIndex, sizeof(u32));
+								texR          = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(texel, MASK_FF_8X)), INV255_8X);
+								texG          = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(texel, 8), MASK_FF_8X)), INV255_8X);
+								texB          = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(texel, 16), MASK_FF_8X)), INV255_8X);
+								texA          = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(texel, 24)), INV255_8X);
+								texR          = _mm256_mul_ps(texR, texR);
+								texG          = _mm256_mul_ps(texG, texG);
+								texB          = _mm256_mul_ps(texB, texB);
+							}
+
+							finalR = _mm256_mul_ps(finalR, texR);
+							finalG = _mm256_mul_ps(finalG, texG);
+							finalB = _mm256_mul_ps(finalB, texB);
+							finalA = _mm256_mul_ps(finalA, texA);
+							DTRDebug_EndCycleCount(DTRDebugCycleCount_SIMDTexturedTriangle_SampleTexture);
+						}
+
+						////////////////////////////////////////////////////////////
+						// Blend, PreAlphaMulColor + (1 - Alpha) * Src, see DTRRenderBlendMode
+						////////////////////////////////////////////////////////////
+						__m256 destR = finalR;
+						__m256 destG = finalG;
+						__m256 destB = finalB;
+						if (!blendOpaque)
+						{
+							// Pixel Format: XX RR GG BB
+							__m256 srcR = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(srcPixel, 16), MASK_FF_8X)), INV255_8X);
+							__m256 srcG = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(srcPixel, 8), MASK_FF_8X)), INV255_8X);
+							__m256 srcB = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(srcPixel, MASK_FF_8X)), INV255_8X);
+
+							__m256 invA = (blendAdditive) ? ONE_8X : _mm256_sub_ps(ONE_8X, finalA);
+							destR      = _mm256_add_ps(finalR, _mm256_mul_ps(invA, _mm256_mul_ps(srcR, srcR)));
+							destG      = _mm256_add_ps(finalG, _mm256_mul_ps(invA, _mm256_mul_ps(srcG, srcG)));
+							destB      = _mm256_add_ps(finalB, _mm256_mul_ps(invA, _mm256_mul_ps(srcB, srcB)));
+						}
+
+						destR = _mm256_min_ps(_mm256_mul_ps(_mm256_sqrt_ps(destR), MAX_255_8X), MAX_255_8X);
+						destG = _mm256_min_ps(_mm256_mul_ps(_mm256_sqrt_ps(destG), MAX_255_8X), MAX_255_8X);
+						destB = _mm256_min_ps(_mm256_mul_ps(_mm256_sqrt_ps(destB), MAX_255_8X), MAX_255_8X);
+
+						__m256i destPixel = _mm256_or_si256(_mm256_slli_epi32(_mm256_cvttps_epi32(destR), 16),
+						                                    _mm256_or_si256(_mm256_slli_epi32(_mm256_cvttps_epi32(destG), 8),
+						                                                    _mm256_cvttps_epi32(destB)));
+
+						////////////////////////////////////////////////////////////
+						// Write
+						////////////////////////////////////////////////////////////
+						if (writeMask == ALL_LANES_MASK)
+						{
+							if (!depthUnorm) _mm256_storeu_ps(zBufferRow + bufferX, pixelZDepth);
+							_mm256_storeu_si256((__m256i *)(pixelRow + bufferX), destPixel);
+						}
+						else
+						{
+							f32 zLanes[8];
+							u32 pixelLanes[8];
+							_mm256_storeu_ps(zLanes, pixelZDepth);
+							_mm256_storeu_si256((__m256i *)pixelLanes, destPixel);
+							for (i32 lane = 0; lane < NUM_X_PIXELS_TO_SIMD; lane++)
+							{
+								if (writeMask & (1 << lane))
+								{
+									if (!depthUnorm) zBufferRow[bufferX + lane] = zLanes[lane];
+									pixelRow[bufferX + lane] = pixelLanes[lane];
+								}
+							}
+						}
+
+						if (depthUnorm) SIMDDepthStoreUnormAVX2(renderBuffer, zBufferIndex, pixelDepthUnorm, writeMask);
+					}
+
+					if (lockPixels)
+					{
+						for (i32 lane = 0; lane < NUM_X_PIXELS_TO_SIMD; lane++)
+						{
+							if (coverageMask & (1 << lane))
+								renderBuffer->pixelLockTable[bufferX + lane + (bufferY * zBufferPitch)] = false;
+						}
+					}
+					DEBUG_SIMD_AUTO_CHOOSE_END_CYCLE_COUNT(Triangle_RasterisePixel);
+				}
+			}
+
+			////////////////////////////////////////////////////////////////////
+			// Update Depth Block
+			////////////////////////////////////////////////////////////////////
+			// NOTE: The max is raised by the caller once the whole triangle is rasterised
+			if (coversWholeBlock) depthBlock->min = DepthBlockReadMin(renderBuffer, rectMin);
+		}
 	}
 
 	DEBUG_SIMD_AUTO_CHOOSE_END_CYCLE_COUNT(Triangle_Rasterise);
@@ -1073,7 +2551,7 @@ FILE_SCOPE void SlowTriangle(DTRRenderContext context, const DqnV3 p1, const Dqn
                              const f32 lightIntensity1, const f32 lightIntensity2,
                              const f32 lightIntensity3, const bool ignoreLight,
                              DTRBitmap *const texture, DqnV4 color, const DqnV2i min,
-                             const DqnV2i max)
+                             const DqnV2i max, const bool lockPixels)
 {
 	DTR_DEBUG_EP_TIMED_FUNCTION();
 #define DEBUG_SLOW_AUTO_CHOOSE_BEGIN_CYCLE_COUNT(type)                                             \
@@ -1101,42 +2579,32 @@ FILE_SCOPE void SlowTriangle(DTRRenderContext context, const DqnV3 p1, const Dqn
 	////////////////////////////////////////////////////////////////////////////
 	// Convert Color
 	////////////////////////////////////////////////////////////////////////////
-	color = DTRRender_SRGB1ToLinearSpaceV4(color);
-	color = PreMultiplyAlpha1(color);
+	color = DrawColorToLinearInternal(context, color);
 
 	////////////////////////////////////////////////////////////////////////////
 	// Scan and Render
 	////////////////////////////////////////////////////////////////////////////
 	DEBUG_SLOW_AUTO_CHOOSE_BEGIN_CYCLE_COUNT(Triangle_Preamble_SArea);
-	DqnV2i startP         = min;
-	f32 signedArea1Pixel  = Triangle2TimesSignedArea(p2.xy, p3.xy, DqnV2_V2i(startP));
-	f32 signedArea1DeltaX = p2.y - p3.y;
-	f32 signedArea1DeltaY = p3.x - p2.x;
-
-	f32 signedArea2Pixel  = Triangle2TimesSignedArea(p3.xy, p1.xy, DqnV2_V2i(startP));
-	f32 signedArea2DeltaX = p3.y - p1.y;
-	f32 signedArea2DeltaY = p1.x - p3.x;
-
-	f32 signedArea3Pixel  = Triangle2TimesSignedArea(p1.xy, p2.xy, DqnV2_V2i(startP));
-	f32 signedArea3DeltaX = p1.y - p2.y;
-	f32 signedArea3DeltaY = p2.x - p1.x;
+	TriangleEdges edges = {};
+	bool hasArea        = TriangleEdgesSetupInternal(p1.xy, p2.xy, p3.xy, min, &edges);
 	DEBUG_SLOW_AUTO_CHOOSE_END_CYCLE_COUNT(Triangle_Preamble_SArea);
-	DEBUG_SLOW_AUTO_CHOOSE_BEGIN_CYCLE_COUNT(Triangle_Preamble_SIMDStep);
-
-	f32 signedAreaParallelogram = signedArea1Pixel + signedArea2Pixel + signedArea3Pixel;
-	if (signedAreaParallelogram == 0) return;
+	if (!hasArea)
+	{
+		DEBUG_SLOW_AUTO_CHOOSE_END_CYCLE_COUNT(Triangle_Preamble);
+		DEBUG_SLOW_AUTO_CHOOSE_END_CYCLE_COUNT(Triangle);
+		return;
+	}
 
-	f32 invSignedAreaParallelogram = 1.0f / signedAreaParallelogram;
+	DEBUG_SLOW_AUTO_CHOOSE_BEGIN_CYCLE_COUNT(Triangle_Preamble_SIMDStep);
+	f32 invSignedAreaParallelogram = 1.0f / (f32)edges.signedAreaParallelogram;
 	DEBUG_SLOW_AUTO_CHOOSE_END_CYCLE_COUNT(Triangle_Preamble_SIMDStep);
 
-	const DqnV3 p2SubP1        = p2 - p1;
-	const DqnV3 p3SubP1        = p3 - p1;
-	const DqnV2 uv2SubUv1      = uv2 - uv1;
-	const DqnV2 uv3SubUv1      = uv3 - uv1;
-	const u32 texturePitch     = (texture) ? (texture->bytesPerPixel * texture->dim.w) : 0;
-	const u8 *const texturePtr = (texture) ? (texture->memory) : NULL;
-	const u32 zBufferPitch     = renderBuffer->width;
-	const f32 INV_255          = 1 / 255.0f;
+	const DqnV3 p2SubP1         = p2 - p1;
+	const DqnV3 p3SubP1         = p3 - p1;
+	const DqnV2 uv2SubUv1       = uv2 - uv1;
+	const DqnV2 uv3SubUv1       = uv3 - uv1;
+	const u32 zBufferPitch      = renderBuffer->width;
+	DepthBlocksLazyClearRect(context, min, max);
 	DEBUG_SLOW_AUTO_CHOOSE_END_CYCLE_COUNT(Triangle_Preamble);
 	DEBUG_SLOW_AUTO_CHOOSE_BEGIN_CYCLE_COUNT(Triangle_Rasterise);
 
@@ -1145,21 +2613,22 @@ FILE_SCOPE void SlowTriangle(DTRRenderContext context, const DqnV3 p1, const Dqn
 	DqnV3 p3Light = color.rgb * DQN_MAX(0, lightIntensity3);
 	for (i32 bufferY = min.y; bufferY < max.y; bufferY++)
 	{
-		f32 signedArea1 = signedArea1Pixel;
-		f32 signedArea2 = signedArea2Pixel;
-		f32 signedArea3 = signedArea3Pixel;
+		i32 signedArea1 = TriangleEdgesEvaluate(&edges, 0, min.x, bufferY);
+		i32 signedArea2 = TriangleEdgesEvaluate(&edges, 1, min.x, bufferY);
+		i32 signedArea3 = TriangleEdgesEvaluate(&edges, 2, min.x, bufferY);
 
 		for (i32 bufferX = min.x; bufferX < max.x; bufferX++)
 		{
-			if (signedArea1 >= 0 && signedArea2 >= 0 && signedArea3 >= 0)
+			if (signedArea1 > edges.bias[0] && signedArea2 > edges.bias[1] &&
+			    signedArea3 > edges.bias[2])
 			{
 				DEBUG_SLOW_AUTO_CHOOSE_BEGIN_CYCLE_COUNT(Triangle_RasterisePixel);
-				f32 barycentricA = signedArea1 * invSignedAreaParallelogram;
-				f32 barycentricB = signedArea2 * invSignedAreaParallelogram;
-				f32 barycentricC = signedArea3 * invSignedAreaParallelogram;
+				f32 barycentricA = (f32)signedArea1 * invSignedAreaParallelogram;
+				f32 barycentricB = (f32)signedArea2 * invSignedAreaParallelogram;
+				f32 barycentricC = (f32)signedArea3 * invSignedAreaParallelogram;
 
 				i32 zBufferIndex = bufferX + (bufferY * zBufferPitch);
-				if (context.multithread)
+				if (lockPixels)
 				{
 					bool currLockValue;
 					do
@@ -1172,10 +2641,9 @@ FILE_SCOPE void SlowTriangle(DTRRenderContext context, const DqnV3 p1, const Dqn
 
 				f32 pixelZDepth =
 				    p1.z + (barycentricB * (p2SubP1.z)) + (barycentricC * (p3SubP1.z));
-				if (pixelZDepth > renderBuffer->zBuffer[zBufferIndex])
+				if (DepthTestAndWriteInternal(renderBuffer, zBufferIndex, pixelZDepth))
 				{
 					DqnV4 finalColor = color;
-					renderBuffer->zBuffer[zBufferIndex] = pixelZDepth;
 
 					if (!ignoreLight)
 					{
@@ -1202,34 +2670,19 @@ FILE_SCOPE void SlowTriangle(DTRRenderContext context, const DqnV3 p1, const Dqn
 						i32 texelX = (i32)texelXf;
 						i32 texelY = (i32)texelYf;
 
-						u32 texel1 = *(u32 *)(texturePtr + (texelX * texture->bytesPerPixel) +
-						                      (texelY * texturePitch));
-
-						DqnV4 color1;
-						color1.a = (f32)(texel1 >> 24);
-						color1.b = (f32)((texel1 >> 16) & 0xFF);
-						color1.g = (f32)((texel1 >> 8) & 0xFF);
-						color1.r = (f32)((texel1 >> 0) & 0xFF);
-
-						color1 *= INV_255;
-						color1 = DTRRender_SRGB1ToLinearSpaceV4(color1);
-						finalColor *= color1;
+						finalColor *= BitmapTexelToLinear1Internal(texture, DTRAsset_BitmapTexelIndex(texture, texelX, texelY));
 					}
 
 					SetPixel(context, bufferX, bufferY, finalColor, ColorSpace_Linear);
 				}
-				renderBuffer->pixelLockTable[zBufferIndex] = false;
+				if (lockPixels) renderBuffer->pixelLockTable[zBufferIndex] = false;
 				DEBUG_SLOW_AUTO_CHOOSE_END_CYCLE_COUNT(Triangle_RasterisePixel);
 			}
 
-			signedArea1 += signedArea1DeltaX;
-			signedArea2 += signedArea2DeltaX;
-			signedArea3 += signedArea3DeltaX;
+			signedArea1 += edges.deltaX[0];
+			signedArea2 += edges.deltaX[1];
+			signedArea3 += edges.deltaX[2];
 		}
-
-		signedArea1Pixel += signedArea1DeltaY;
-		signedArea2Pixel += signedArea2DeltaY;
-		signedArea3Pixel += signedArea3DeltaY;
 	}
 	DEBUG_SLOW_AUTO_CHOOSE_END_CYCLE_COUNT(Triangle_Rasterise);
 	DEBUG_SLOW_AUTO_CHOOSE_END_CYCLE_COUNT(Triangle);
@@ -1248,7 +2701,7 @@ DqnMat4 GLViewport(f32 x, f32 y, f32 width, f32 height)
 	DqnMat4 result                          = DqnMat4_Identity();
 	f32 halfWidth                           = width * 0.5f;
 	f32 halfHeight                          = height * 0.5f;
-	const f32 DEPTH_BUFFER_GRANULARITY      = 255.0f;
+	const f32 DEPTH_BUFFER_GRANULARITY      = DTRRENDER_DEPTH_RANGE;
 	const f32 HALF_DEPTH_BUFFER_GRANULARITY = DEPTH_BUFFER_GRANULARITY * 0.5f;
 
 	result.e[0][0] = halfWidth;
@@ -1262,18 +2715,106 @@ DqnMat4 GLViewport(f32 x, f32 y, f32 width, f32 height)
 	return result;
 }
 
-FILE_SCOPE void
-TexturedTriangleInternal(DTRRenderContext context, RenderLightInternal lighting, DqnV3 p1, DqnV3 p2,
-                         DqnV3 p3, DqnV2 uv1, DqnV2 uv2, DqnV2 uv3, DTRBitmap *const texture,
-                         DqnV4 color,
-                         const DTRRenderTransform transform = DTRRender_DefaultTriangleTransform())
+// A triangle that has been transformed, lit and clipped to the screen, ready to be rasterised. The
+// min/max bounds are in buffer pixels where max is exclusive.
+typedef struct RenderTriangleSetup
+{
+	DqnV3 p1;
+	DqnV3 p2;
+	DqnV3 p3;
+	DqnV2 uv1;
+	DqnV2 uv2;
+	DqnV2 uv3;
+
+	f32  lightIntensity1;
+	f32  lightIntensity2;
+	f32  lightIntensity3;
+	bool ignoreLight;
+
+	DTRBitmap *texture;
+	DqnV4      color;
+	DqnV2i     min;
+	DqnV2i     max;
+
+	enum DTRRenderBlendMode blendMode; // Of the context the triangle was setup with
+} RenderTriangleSetup;
+
+// Select the mip of texture whose texels are closest to a pixel in size on screen, i.e. the nearest
+// level to log2 of the larger of the texture's screen space derivatives. Texture coordinates are
+// interpolated linearly over the triangle, so the derivatives and the level are per triangle.
+FILE_SCOPE DTRBitmap *SelectTriangleMipInternal(DTRBitmap *const texture, const DqnV2 p1,
+                                                const DqnV2 p2, const DqnV2 p3, const DqnV2 uv1,
+                                                const DqnV2 uv2, const DqnV2 uv3)
+{
+	if (!texture || texture->numMips == 0) return texture;
+
+	f32 area2Times = Triangle2TimesSignedArea(p1, p2, p3);
+	if (area2Times == 0) return texture;
+
+	const DqnV2 texDim    = DqnV2_2i(texture->dim.w, texture->dim.h);
+	const DqnV2 p2SubP1   = p2 - p1;
+	const DqnV2 p3SubP1   = p3 - p1;
+	const DqnV2 uv2SubUv1 = DqnV2_Hadamard(uv2 - uv1, texDim);
+	const DqnV2 uv3SubUv1 = DqnV2_Hadamard(uv3 - uv1, texDim);
+
+	// Texels moved per pixel moved along x and y
+	const f32 invArea2Times = 1.0f / area2Times;
+	DqnV2 texelsPerX = ((uv2SubUv1 * p3SubP1.y) - (uv3SubUv1 * p2SubP1.y)) * invArea2Times;
+	DqnV2 texelsPerY = ((uv3SubUv1 * p2SubP1.x) - (uv2SubUv1 * p3SubP1.x)) * invArea2Times;
+
+	f32 maxLengthSq = DQN_MAX(DqnV2_LengthSquared(texelsPerX, DqnV2_1f(0)),
+	                          DqnV2_LengthSquared(texelsPerY, DqnV2_1f(0)));
+	if (maxLengthSq <= 1.0f) return texture;
+
+	// NOTE: log2(sqrt(x)) == 0.5 * log2(x)
+	f32 lod   = 0.5f * log2f(maxLengthSq);
+	i32 level = DQN_MIN((i32)(lod + 0.5f), texture->numMips);
+	if (level <= 0) return texture;
+
+	DTRBitmap *result = &texture->mips[level - 1];
+	return result;
+}
+
+FILE_SCOPE RenderTriangleSetup
+SetupTriangleInternal(DTRRenderContext context, RenderLightInternal lighting, DqnV3 p1, DqnV3 p2,
+                      DqnV3 p3, DqnV2 uv1, DqnV2 uv2, DqnV2 uv3, DTRBitmap *const texture,
+                      DqnV4 color, const DTRRenderTransform transform,
+                      DqnV2 *const transformedPList = NULL)
 {
 	DTRRenderBuffer *renderBuffer = context.renderBuffer;
 
+	////////////////////////////////////////////////////////////////////////////
+	// Cull by winding, culled triangles are returned with empty bounds
+	////////////////////////////////////////////////////////////////////////////
+	RenderTriangleSetup result = {};
+	result.blendMode           = context.blendMode;
+	{
+		// NOTE: A negative scale on one axis mirrors the triangle and flips its winding
+		f32 area2Times = Triangle2TimesSignedArea(p1.xy, p2.xy, p3.xy);
+		if (transform.scale.x * transform.scale.y < 0) area2Times = -area2Times;
+
+		if (area2Times == 0 || transform.scale.x == 0 || transform.scale.y == 0)
+		{
+			DTRDebug_CounterIncrement(DTRDebugCounter_CulledZeroArea);
+			return result;
+		}
+
+		if ((context.cullMode == DTRRenderCullMode_Back && area2Times < 0) ||
+		    (context.cullMode == DTRRenderCullMode_Front && area2Times > 0))
+		{
+			DTRDebug_CounterIncrement(DTRDebugCounter_CulledBackFace);
+			return result;
+		}
+	}
+
 	////////////////////////////////////////////////////////////////////////////
 	// Transform vertexes p1, p2, p3 inplace
 	////////////////////////////////////////////////////////////////////////////
-	Make3PointsClockwise(&p1, &p2, &p3);
+	if (Make3PointsClockwise(&p1, &p2, &p3))
+	{
+		DQN_SWAP(DqnV2, uv2, uv3);
+		DQN_SWAP(f32, lighting.intensities[1], lighting.intensities[2]);
+	}
 
 	DqnV2 origin  = Get2DOriginFromTransformAnchor(p1.xy, p2.xy, p3.xy, transform);
 	DqnV2 pList[] = {p1.xy - origin, p2.xy - origin, p3.xy - origin};
@@ -1283,11 +2824,27 @@ TexturedTriangleInternal(DTRRenderContext context, RenderLightInternal lighting,
 	p2.xy = pList[1];
 	p3.xy = pList[2];
 
-	DqnRect bounds      = GetBoundingBox(pList, DQN_ARRAY_COUNT(pList));
-	DqnRect screenSpace = DqnRect_4i(0, 0, renderBuffer->width - 1, renderBuffer->height - 1);
-	bounds              = DqnRect_ClipRect(bounds, screenSpace);
-	DqnV2i min          = DqnV2i_V2(bounds.min);
-	DqnV2i max          = DqnV2i_V2(bounds.max);
+	if (transformedPList)
+	{
+		for (i32 i = 0; i < DQN_ARRAY_COUNT(pList); i++)
+			transformedPList[i] = pList[i];
+	}
+
+	// NOTE: Max is exclusive. Vertices move by up to half a pixel when they're rounded to fixed
+	// point, see TriangleEdgesSetupInternal(), so the bounds are padded to cover wherever they land.
+	DqnRect bounds = GetBoundingBox(pList, DQN_ARRAY_COUNT(pList));
+	const f32 maxX = (f32)renderBuffer->width;
+	const f32 maxY = (f32)renderBuffer->height;
+	result.min.x   = (i32)ceilf(DqnMath_Clampf(bounds.min.x - 0.5f, 0, maxX));
+	result.min.y   = (i32)ceilf(DqnMath_Clampf(bounds.min.y - 0.5f, 0, maxY));
+	result.max.x   = (i32)floorf(DqnMath_Clampf(bounds.max.x + 0.5f, -1, maxX - 1)) + 1;
+	result.max.y   = (i32)floorf(DqnMath_Clampf(bounds.max.y + 0.5f, -1, maxY - 1)) + 1;
+	if (result.min.x >= result.max.x || result.min.y >= result.max.y)
+	{
+		result.min = result.max = DqnV2i_2i(0, 0);
+		DTRDebug_CounterIncrement(DTRDebugCounter_CulledOffScreen);
+		return result;
+	}
 
 	////////////////////////////////////////////////////////////////////////////
 	// Calculate light
@@ -1300,45 +2857,260 @@ TexturedTriangleInternal(DTRRenderContext context, RenderLightInternal lighting,
 	}
 	else
 	{
-		lighting.vector = DqnV3_Normalise(lighting.vector);
 		if (lighting.mode == DTRRenderShadingMode_Flat)
 		{
 			DqnV3 p2SubP1 = p2 - p1;
 			DqnV3 p3SubP1 = p3 - p1;
 
 			DqnV3 normal  = DqnV3_Normalise(DqnV3_Cross(p2SubP1, p3SubP1));
-			f32 intensity = DqnV3_Dot(normal, lighting.vector);
+			f32 intensity = DqnV3_Dot(normal, DqnV3_Normalise(lighting.vector));
 			intensity     = DQN_MAX(0, intensity);
 			color.rgb *= intensity;
 		}
 		else
 		{
-			DQN_ASSERT(lighting.numNormals == 3);
+			DQN_ASSERT(lighting.numIntensities == 3);
 			DQN_ASSERT(lighting.mode == DTRRenderShadingMode_Gouraud);
-			lightIntensity1 = DqnV3_Dot(DqnV3_Normalise(lighting.normals[0]), lighting.vector);
-			lightIntensity2 = DqnV3_Dot(DqnV3_Normalise(lighting.normals[1]), lighting.vector);
-			lightIntensity3 = DqnV3_Dot(DqnV3_Normalise(lighting.normals[2]), lighting.vector);
+			lightIntensity1 = lighting.intensities[0];
+			lightIntensity2 = lighting.intensities[1];
+			lightIntensity3 = lighting.intensities[2];
 		}
 	}
 
-	////////////////////////////////////////////////////////////////////////////
-	// SIMD/Slow Path
-	////////////////////////////////////////////////////////////////////////////
-	if (globalDTRPlatformFlags.canUseSSE2)
+	result.p1              = p1;
+	result.p2              = p2;
+	result.p3              = p3;
+	result.uv1             = uv1;
+	result.uv2             = uv2;
+	result.uv3             = uv3;
+	result.lightIntensity1 = lightIntensity1;
+	result.lightIntensity2 = lightIntensity2;
+	result.lightIntensity3 = lightIntensity3;
+	result.ignoreLight     = ignoreLight;
+	result.texture         = SelectTriangleMipInternal(texture, p1.xy, p2.xy, p3.xy, uv1, uv2, uv3);
+	result.color           = color;
+
+	DTRDebug_CounterIncrement(DTRDebugCounter_RenderTriangle);
+	return result;
+}
+
+// Rasterise the triangle p1, p2, p3 over min/max with the rest of its attributes from tri.
+FILE_SCOPE void RasteriseTriangleKernelInternal(DTRRenderContext context,
+                                                const RenderTriangleSetup *const tri,
+                                                const DqnV3 p1, const DqnV3 p2, const DqnV3 p3,
+                                                const DqnV2 uv1, const DqnV2 uv2, const DqnV2 uv3,
+                                                const f32 lightIntensity1, const f32 lightIntensity2,
+                                                const f32 lightIntensity3, const DqnV2i min,
+                                                const DqnV2i max, const bool lockPixels)
+{
+	if (globalDTRPlatformFlags.canUseAVX2)
+	{
+		SIMDTriangleAVX2(context, p1, p2, p3, uv1, uv2, uv3, lightIntensity1, lightIntensity2,
+		                 lightIntensity3, tri->ignoreLight, tri->texture, tri->color, min, max,
+		                 lockPixels);
+	}
+	else if (globalDTRPlatformFlags.canUseSSE2)
 	{
 		SIMDTriangle(context, p1, p2, p3, uv1, uv2, uv3, lightIntensity1, lightIntensity2,
-		             lightIntensity3, ignoreLight, texture, color, min, max);
+		             lightIntensity3, tri->ignoreLight, tri->texture, tri->color, min, max,
+		             lockPixels);
 	}
 	else
 	{
 		SlowTriangle(context, p1, p2, p3, uv1, uv2, uv3, lightIntensity1, lightIntensity2,
-		             lightIntensity3, ignoreLight, texture, color, min, max);
+		             lightIntensity3, tri->ignoreLight, tri->texture, tri->color, min, max,
+		             lockPixels);
+	}
+}
+
+FILE_SCOPE inline bool TriangleInGuardBandInternal(const RenderTriangleSetup *const tri,
+                                                   const DqnRect guardBand)
+{
+	const DqnV3 pList[] = {tri->p1, tri->p2, tri->p3};
+	for (i32 i = 0; i < DQN_ARRAY_COUNT(pList); i++)
+	{
+		// NOTE: Written so non-finite vertexes are outside
+		if (!(pList[i].x >= guardBand.min.x && pList[i].x <= guardBand.max.x &&
+		      pList[i].y >= guardBand.min.y && pList[i].y <= guardBand.max.y))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+typedef struct GuardBandVertex
+{
+	DqnV3 p;
+	DqnV2 uv;
+	f32   lightIntensity;
+} GuardBandVertex;
+
+// Clip the convex polygon inList against the line p.e[axis] == bound, keeping the side where
+// (sign * (p.e[axis] - bound)) >= 0. Returns the number of vertexes written to outList, which must
+// hold numIn + 1 vertexes.
+FILE_SCOPE i32 GuardBandClipInternal(const GuardBandVertex *const inList, const i32 numIn,
+                                     const i32 axis, const f32 bound, const f32 sign,
+                                     GuardBandVertex *const outList)
+{
+	i32 numOut = 0;
+	for (i32 i = 0; i < numIn; i++)
+	{
+		const GuardBandVertex *a = &inList[i];
+		const GuardBandVertex *b = &inList[(i + 1) % numIn];
+		const bool aInside       = (sign * (a->p.e[axis] - bound)) >= 0;
+		const bool bInside       = (sign * (b->p.e[axis] - bound)) >= 0;
+
+		if (aInside) outList[numOut++] = *a;
+		if (aInside == bInside) continue;
+
+		// NOTE: Intersect from the lesser end so triangles sharing the edge, which walk it in the
+		// opposite direction, compute a bit identical vertex.
+		if (b->p.x < a->p.x || (b->p.x == a->p.x && b->p.y < a->p.y)) DQN_SWAP(const GuardBandVertex *, a, b);
+
+		const f32 t             = (bound - a->p.e[axis]) / (b->p.e[axis] - a->p.e[axis]);
+		GuardBandVertex *vertex = &outList[numOut++];
+		vertex->p               = a->p + ((b->p - a->p) * t);
+		vertex->p.e[axis]       = bound;
+		vertex->uv              = a->uv + ((b->uv - a->uv) * t);
+		vertex->lightIntensity  = DqnMath_Lerp(a->lightIntensity, t, b->lightIntensity);
+	}
+
+	return numOut;
+}
+
+// Rasterise the part of tri inside guardBand over min/max, which must lie inside the guard band's
+// cell. Attributes are interpolated linearly in screen space like the rasterisers do, so the clipped
+// polygon shades the same as the triangle.
+FILE_SCOPE void RasteriseTriangleInGuardBandInternal(DTRRenderContext context,
+                                                     const RenderTriangleSetup *const tri,
+                                                     const DqnRect guardBand, const DqnV2i min,
+                                                     const DqnV2i max, const bool lockPixels)
+{
+	if (TriangleInGuardBandInternal(tri, guardBand))
+	{
+		RasteriseTriangleKernelInternal(context, tri, tri->p1, tri->p2, tri->p3, tri->uv1, tri->uv2,
+		                                tri->uv3, tri->lightIntensity1, tri->lightIntensity2,
+		                                tri->lightIntensity3, min, max, lockPixels);
+		return;
+	}
+
+	// NOTE: Each clip adds at most 1 vertex to the triangle, 4 clips gives at most 7
+	GuardBandVertex polygon[8];
+	GuardBandVertex clipped[8];
+	polygon[0] = {tri->p1, tri->uv1, tri->lightIntensity1};
+	polygon[1] = {tri->p2, tri->uv2, tri->lightIntensity2};
+	polygon[2] = {tri->p3, tri->uv3, tri->lightIntensity3};
+
+	i32 numVertexes = 3;
+	numVertexes = GuardBandClipInternal(polygon, numVertexes, 0, guardBand.min.x,  1.0f, clipped);
+	numVertexes = GuardBandClipInternal(clipped, numVertexes, 0, guardBand.max.x, -1.0f, polygon);
+	numVertexes = GuardBandClipInternal(polygon, numVertexes, 1, guardBand.min.y,  1.0f, clipped);
+	numVertexes = GuardBandClipInternal(clipped, numVertexes, 1, guardBand.max.y, -1.0f, polygon);
+
+	// NOTE: Clipping keeps the winding so the fan stays clockwise. Fan triangles share their
+	// vertexes exactly, so the diagonals between them are watertight like any other shared edge.
+	for (i32 i = 1; (i + 1) < numVertexes; i++)
+	{
+		const GuardBandVertex *v1 = &polygon[0];
+		const GuardBandVertex *v2 = &polygon[i];
+		const GuardBandVertex *v3 = &polygon[i + 1];
+		RasteriseTriangleKernelInternal(context, tri, v1->p, v2->p, v3->p, v1->uv, v2->uv, v3->uv,
+		                                v1->lightIntensity, v2->lightIntensity, v3->lightIntensity,
+		                                min, max, lockPixels);
+	}
+}
+
+// min/max: The region of the buffer to rasterise, it should lie within the triangle's bounds.
+// lockPixels: Spin on the renderBuffer's pixelLockTable before touching a pixel, required when
+//             other threads may be rasterising over the same region.
+FILE_SCOPE void RasteriseTriangleInternal(DTRRenderContext context,
+                                          const RenderTriangleSetup *const tri, const DqnV2i min,
+                                          const DqnV2i max, const bool lockPixels)
+{
+	if (min.x >= max.x || min.y >= max.y) return;
+	context.blendMode = tri->blendMode;
+
+	////////////////////////////////////////////////////////////////////////////
+	// Depth Block Rejection
+	////////////////////////////////////////////////////////////////////////////
+	// NOTE: Depth blocks are only safe to read and update when no other thread can write to the
+	// same pixels, locked rasterisation invalidates the blocks it touches instead.
+	DTRRenderBuffer *const renderBuffer = context.renderBuffer;
+	const f32 triangleMaxZ = DQN_MAX(DQN_MAX(tri->p1.z, tri->p2.z), tri->p3.z) +
+	                         DepthBlockEpsilonInternal(renderBuffer);
+	if (lockPixels)
+	{
+		// NOTE: Cleared upfront, a lazy clear after raising would lower the max again
+		DepthBlocksLazyClearRect(context, min, max);
+		RaiseDepthBlocksMax(renderBuffer, min, max, DQN_F32_MAX);
+	}
+	else if (renderBuffer->zBufferBlocks &&
+	         DepthBlocksRejectRect(renderBuffer, min, max, triangleMaxZ))
+	{
+		return;
+	}
+
+	////////////////////////////////////////////////////////////////////////////
+	// Guard Band
+	////////////////////////////////////////////////////////////////////////////
+	// NOTE: Triangles inside the guard band of every cell they're drawn in rasterise as is,
+	// otherwise each cell rasterises the triangle clipped to its own guard band.
+	const i32 CELL_SIZE   = TRIANGLE_GUARD_BAND_CELL_SIZE;
+	const DqnV2i firstCell = DqnV2i_2i(min.x / CELL_SIZE, min.y / CELL_SIZE);
+	const DqnV2i lastCell  = DqnV2i_2i((max.x - 1) / CELL_SIZE, (max.y - 1) / CELL_SIZE);
+	const DqnRect innerGuardBand =
+	    DqnRect_4f((f32)((lastCell.x * CELL_SIZE) - TRIANGLE_GUARD_BAND_MARGIN),
+	               (f32)((lastCell.y * CELL_SIZE) - TRIANGLE_GUARD_BAND_MARGIN),
+	               (f32)(((firstCell.x + 1) * CELL_SIZE) + TRIANGLE_GUARD_BAND_MARGIN),
+	               (f32)(((firstCell.y + 1) * CELL_SIZE) + TRIANGLE_GUARD_BAND_MARGIN));
+	if (TriangleInGuardBandInternal(tri, innerGuardBand))
+	{
+		RasteriseTriangleKernelInternal(context, tri, tri->p1, tri->p2, tri->p3, tri->uv1, tri->uv2,
+		                                tri->uv3, tri->lightIntensity1, tri->lightIntensity2,
+		                                tri->lightIntensity3, min, max, lockPixels);
+	}
+	else
+	{
+		for (i32 cellY = firstCell.y; cellY <= lastCell.y; cellY++)
+		{
+			for (i32 cellX = firstCell.x; cellX <= lastCell.x; cellX++)
+			{
+				const DqnV2i cellMin = DqnV2i_2i(cellX * CELL_SIZE, cellY * CELL_SIZE);
+				const DqnV2i cellMax = DqnV2i_2i(cellMin.x + CELL_SIZE, cellMin.y + CELL_SIZE);
+				const DqnV2i rectMin = DqnV2i_2i(DQN_MAX(min.x, cellMin.x), DQN_MAX(min.y, cellMin.y));
+				const DqnV2i rectMax = DqnV2i_2i(DQN_MIN(max.x, cellMax.x), DQN_MIN(max.y, cellMax.y));
+				const DqnRect guardBand =
+				    DqnRect_4f((f32)(cellMin.x - TRIANGLE_GUARD_BAND_MARGIN),
+				               (f32)(cellMin.y - TRIANGLE_GUARD_BAND_MARGIN),
+				               (f32)(cellMax.x + TRIANGLE_GUARD_BAND_MARGIN),
+				               (f32)(cellMax.y + TRIANGLE_GUARD_BAND_MARGIN));
+				RasteriseTriangleInGuardBandInternal(context, tri, guardBand, rectMin, rectMax,
+				                                     lockPixels);
+			}
+		}
 	}
 
+	// NOTE: Raised after rasterising since the SIMD paths skip depth tests in blocks the triangle
+	// is entirely in front of, which is decided using the max before this triangle.
+	if (!lockPixels) RaiseDepthBlocksMax(renderBuffer, min, max, triangleMaxZ);
+}
+
+FILE_SCOPE void
+TexturedTriangleInternal(DTRRenderContext context, RenderLightInternal lighting, DqnV3 p1, DqnV3 p2,
+                         DqnV3 p3, DqnV2 uv1, DqnV2 uv2, DqnV2 uv3, DTRBitmap *const texture,
+                         DqnV4 color,
+                         const DTRRenderTransform transform = DTRRender_DefaultTriangleTransform())
+{
+	DqnV2 pList[3]          = {};
+	RenderTriangleSetup tri = SetupTriangleInternal(context, lighting, p1, p2, p3, uv1, uv2, uv3,
+	                                                texture, color, transform, pList);
+	RasteriseTriangleInternal(context, &tri, tri.min, tri.max, context.multithread);
+
 	////////////////////////////////////////////////////////////////////////////
 	// Debug
 	////////////////////////////////////////////////////////////////////////////
-	DTRDebug_CounterIncrement(DTRDebugCounter_RenderTriangle);
 	{
 		bool drawBoundingBox = false;
 		bool drawBasis       = false;
@@ -1364,22 +3136,27 @@ void DTRRender_TexturedTriangle(DTRRenderContext context,
 	                         color, transform);
 }
 
-typedef struct RenderMeshJob
+////////////////////////////////////////////////////////////////////////////////
+// Tile Binning
+////////////////////////////////////////////////////////////////////////////////
+// NOTE(doyle): Multithreaded meshes are rasterised in screen tiles. Triangles are set up once then
+// binned into every tile their bounds touch, and each tile is one job that owns its pixels and its
+// slice of the zBuffer outright. So no two threads ever write the same pixel and we don't need to
+// lock pixels. Triangles are binned in submission order so the result matches single threaded.
+#define RENDER_TILE_SIZE 64
+
+typedef struct RenderTileJob
 {
-	DTRRenderContext context;
-	DTRBitmap *tex;
-	RenderLightInternal lighting;
+	DTRRenderContext           context;
+	const RenderTriangleSetup *triList;
+	const u32                 *triIndexList; // Indexes into triList that overlap this tile
+	u32                        numTriIndexes;
 
-	DqnV3 v1;
-	DqnV3 v2;
-	DqnV3 v3;
-	DqnV2 uv1;
-	DqnV2 uv2;
-	DqnV2 uv3;
-	DqnV4 color;
-} RenderMeshJob;
+	DqnV2i min;
+	DqnV2i max;
+} RenderTileJob;
 
-void MultiThreadedRenderMesh(PlatformJobQueue *const queue, void *const userData)
+void MultiThreadedRenderTile(PlatformJobQueue *const queue, void *const userData)
 {
 	if (!queue || !userData)
 	{
@@ -1387,115 +3164,348 @@ void MultiThreadedRenderMesh(PlatformJobQueue *const queue, void *const userData
 		return;
 	}
 
-	RenderMeshJob *job = (RenderMeshJob *)userData;
-	TexturedTriangleInternal(job->context, job->lighting, job->v1, job->v2, job->v3, job->uv1,
-	                         job->uv2, job->uv3, job->tex, job->color);
+	RenderTileJob *job = (RenderTileJob *)userData;
+	for (u32 i = 0; i < job->numTriIndexes; i++)
+	{
+		const RenderTriangleSetup *tri = job->triList + job->triIndexList[i];
+		DqnV2i min = DqnV2i_2i(DQN_MAX(tri->min.x, job->min.x), DQN_MAX(tri->min.y, job->min.y));
+		DqnV2i max = DqnV2i_2i(DQN_MIN(tri->max.x, job->max.x), DQN_MIN(tri->max.y, job->max.y));
+
+		const bool LOCK_PIXELS = false;
+		RasteriseTriangleInternal(job->context, tri, min, max, LOCK_PIXELS);
+	}
 }
 
-void DTRRender_Mesh(DTRRenderContext context, PlatformJobQueue *const jobQueue, DTRMesh *const mesh,
-                    DTRRenderLight lighting, const DqnV3 pos, const DTRRenderTransform transform)
+// Bin the triangles into screen tiles and rasterise each tile as a job, returns once all the tiles
+// have been rendered.
+FILE_SCOPE void RenderTrianglesInTiles(DTRRenderContext context,
+                                       const RenderTriangleSetup *const triList, const u32 numTris)
 {
-	DqnMemStack *const tempStack        = context.tempStack;
 	DTRRenderBuffer *const renderBuffer = context.renderBuffer;
+	DqnMemStack *const tempStack        = context.tempStack;
 	PlatformAPI *const api              = context.api;
+	PlatformJobQueue *const jobQueue    = context.jobQueue;
+	if (numTris == 0) return;
 
-	if (!mesh || !renderBuffer || !tempStack || !api || !jobQueue) return;
+	const i32 numTilesX = (renderBuffer->width + RENDER_TILE_SIZE - 1) / RENDER_TILE_SIZE;
+	const i32 numTilesY = (renderBuffer->height + RENDER_TILE_SIZE - 1) / RENDER_TILE_SIZE;
+	const i32 numTiles  = numTilesX * numTilesY;
 
-	DqnMat4 viewPModelViewProjection = {};
+	// NOTE: After the prefix sum, tileOffset[i] is where tile i's indexes start in triIndexList
+	u32 *tileCount  = (u32 *)DqnMemStack_Push(tempStack, sizeof(*tileCount) * numTiles);
+	u32 *tileOffset = (u32 *)DqnMemStack_Push(tempStack, sizeof(*tileOffset) * numTiles);
+	if (!tileCount || !tileOffset)
 	{
-		// Create model matrix
-		DqnMat4 translateMatrix = DqnMat4_Translate(pos.x, pos.y, pos.z);
-		DqnMat4 scaleMatrix     = DqnMat4_ScaleV3(transform.scale);
-		DqnMat4 rotateMatrix =
-		    DqnMat4_Rotate(DQN_DEGREES_TO_RADIANS(transform.rotation), transform.anchor.x,
-		                   transform.anchor.y, transform.anchor.z);
-		DqnMat4 modelMatrix = DqnMat4_Mul(translateMatrix, DqnMat4_Mul(rotateMatrix, scaleMatrix));
-
-		// Create camera matrix
-		DqnV3 eye          = DqnV3_3f(0, 0, 1);
-		DqnV3 up           = DqnV3_3f(0, 1, 0);
-		DqnV3 center       = DqnV3_3f(0, 0, 0);
-		DqnMat4 viewMatrix = DqnMat4_LookAt(eye, center, up);
-
-		// Create projection matrix
-		f32 aspectRatio     = (f32)renderBuffer->width / (f32)renderBuffer->height;
-		DqnMat4 perspective = DqnMat4_Perspective(80.0f, aspectRatio, 0.5f, 100.0f);
-		perspective         = DqnMat4_Identity();
-		perspective.e[2][3] = -1.0f / DqnV3_Length(eye, center);
-
-		// Combine matrix + matrix that maps NDC to screen space
-		DqnMat4 viewport  = GLViewport(0, 0, (f32)renderBuffer->width, (f32)renderBuffer->height);
-		DqnMat4 modelView = DqnMat4_Mul(viewMatrix, modelMatrix);
-		DqnMat4 modelViewProjection = DqnMat4_Mul(perspective, modelView);
-		viewPModelViewProjection    = DqnMat4_Mul(viewport, modelViewProjection);
+		// TODO(doyle): Allocation error
+		DQN_ASSERT(DQN_INVALID_CODE_PATH);
+		return;
 	}
 
-	for (u32 i = 0; i < mesh->numFaces; i++)
-	{
-		DTRMeshFace face = mesh->faces[i];
+	////////////////////////////////////////////////////////////////////////////
+	// Count triangles per tile
+	////////////////////////////////////////////////////////////////////////////
+	for (i32 i = 0; i < numTiles; i++)
+		tileCount[i] = 0;
 
-		DqnV4 v1, v2, v3;
-		DqnV3 norm1, norm2, norm3;
+	u32 totalTriIndexes = 0;
+	for (u32 triIndex = 0; triIndex < numTris; triIndex++)
+	{
+		const RenderTriangleSetup *tri = triList + triIndex;
+		if (tri->min.x >= tri->max.x || tri->min.y >= tri->max.y) continue;
+
+		i32 tileMinX = tri->min.x / RENDER_TILE_SIZE;
+		i32 tileMinY = tri->min.y / RENDER_TILE_SIZE;
+		i32 tileMaxX = (tri->max.x - 1) / RENDER_TILE_SIZE;
+		i32 tileMaxY = (tri->max.y - 1) / RENDER_TILE_SIZE;
+		for (i32 tileY = tileMinY; tileY <= tileMaxY; tileY++)
 		{
-			DQN_ASSERT(face.numVertexIndex == 3);
-			DQN_ASSERT(face.numNormalIndex == 3);
-
-			i32 v1Index = face.vertexIndex[0];
-			i32 v2Index = face.vertexIndex[1];
-			i32 v3Index = face.vertexIndex[2];
-
-			// TODO(doyle): Some models have -ve indexes to refer to relative
-			// vertices. We should resolve that to positive indexes at run time.
-			DQN_ASSERT(v1Index < (i32)mesh->numVertexes);
-			DQN_ASSERT(v2Index < (i32)mesh->numVertexes);
-			DQN_ASSERT(v3Index < (i32)mesh->numVertexes);
-
-			v1 = mesh->vertexes[v1Index];
-			v2 = mesh->vertexes[v2Index];
-			v3 = mesh->vertexes[v3Index];
-
-			DQN_ASSERT(v1.w == 1);
-			DQN_ASSERT(v2.w == 1);
-			DQN_ASSERT(v3.w == 1);
-
-			i32 norm1Index = face.normalIndex[0];
-			i32 norm2Index = face.normalIndex[1];
-			i32 norm3Index = face.normalIndex[2];
-
-			DQN_ASSERT(norm1Index < (i32)mesh->numNormals);
-			DQN_ASSERT(norm2Index < (i32)mesh->numNormals);
-			DQN_ASSERT(norm3Index < (i32)mesh->numNormals);
-
-			norm1 = mesh->normals[norm1Index];
-			norm2 = mesh->normals[norm2Index];
-			norm3 = mesh->normals[norm3Index];
-		}
+			for (i32 tileX = tileMinX; tileX <= tileMaxX; tileX++)
+			{
+				tileCount[tileX + (tileY * numTilesX)]++;
+				totalTriIndexes++;
+			}
+		}
+	}
+
+	if (totalTriIndexes == 0) return;
+	u32 *triIndexList = (u32 *)DqnMemStack_Push(tempStack, sizeof(*triIndexList) * totalTriIndexes);
+	if (!triIndexList)
+	{
+		// TODO(doyle): Allocation error
+		DQN_ASSERT(DQN_INVALID_CODE_PATH);
+		return;
+	}
+
+	u32 runningOffset = 0;
+	for (i32 i = 0; i < numTiles; i++)
+	{
+		tileOffset[i] = runningOffset;
+		runningOffset += tileCount[i];
+		tileCount[i] = 0;
+	}
+
+	////////////////////////////////////////////////////////////////////////////
+	// Bin triangles into tiles
+	////////////////////////////////////////////////////////////////////////////
+	for (u32 triIndex = 0; triIndex < numTris; triIndex++)
+	{
+		const RenderTriangleSetup *tri = triList + triIndex;
+		if (tri->min.x >= tri->max.x || tri->min.y >= tri->max.y) continue;
+
+		i32 tileMinX = tri->min.x / RENDER_TILE_SIZE;
+		i32 tileMinY = tri->min.y / RENDER_TILE_SIZE;
+		i32 tileMaxX = (tri->max.x - 1) / RENDER_TILE_SIZE;
+		i32 tileMaxY = (tri->max.y - 1) / RENDER_TILE_SIZE;
+		for (i32 tileY = tileMinY; tileY <= tileMaxY; tileY++)
+		{
+			for (i32 tileX = tileMinX; tileX <= tileMaxX; tileX++)
+			{
+				i32 tileIndex = tileX + (tileY * numTilesX);
+				triIndexList[tileOffset[tileIndex] + tileCount[tileIndex]++] = triIndex;
+			}
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////
+	// Dispatch a job per non-empty tile
+	////////////////////////////////////////////////////////////////////////////
+	RenderTileJob *jobDataList = (RenderTileJob *)DqnMemStack_Push(tempStack, sizeof(*jobDataList) * numTiles);
+	PlatformJob *jobList       = (PlatformJob *)DqnMemStack_Push(tempStack, sizeof(*jobList) * numTiles);
+	if (!jobDataList || !jobList)
+	{
+		// TODO(doyle): Allocation error
+		DQN_ASSERT(DQN_INVALID_CODE_PATH);
+		return;
+	}
+
+	u32 numJobs = 0;
+	for (i32 tileY = 0; tileY < numTilesY; tileY++)
+	{
+		for (i32 tileX = 0; tileX < numTilesX; tileX++)
+		{
+			i32 tileIndex = tileX + (tileY * numTilesX);
+			if (tileCount[tileIndex] == 0) continue;
+
+			RenderTileJob *jobData = &jobDataList[numJobs];
+			jobData->context       = context;
+			jobData->triList       = triList;
+			jobData->triIndexList  = triIndexList + tileOffset[tileIndex];
+			jobData->numTriIndexes = tileCount[tileIndex];
+			jobData->min           = DqnV2i_2i(tileX * RENDER_TILE_SIZE, tileY * RENDER_TILE_SIZE);
+			jobData->max           = DqnV2i_2i(DQN_MIN(jobData->min.x + RENDER_TILE_SIZE, renderBuffer->width),
+			                                   DQN_MIN(jobData->min.y + RENDER_TILE_SIZE, renderBuffer->height));
+
+			jobList[numJobs].callback = MultiThreadedRenderTile;
+			jobList[numJobs].userData = jobData;
+			numJobs++;
+		}
+	}
 
-		v1 = DqnMat4_MulV4(viewPModelViewProjection, v1);
-		v2 = DqnMat4_MulV4(viewPModelViewProjection, v2);
-		v3 = DqnMat4_MulV4(viewPModelViewProjection, v3);
+	Platform_QueueAddAllJobs(api, jobQueue, jobList, numJobs);
 
-		// Perspective Divide to Normalise Device Coordinates
-		v1.xyz = (v1.xyz / v1.w);
-		v2.xyz = (v2.xyz / v2.w);
-		v3.xyz = (v3.xyz / v3.w);
+	// NOTE(doyle): Complete remaining jobs and wait until all jobs finished
+	// before leaving function.
+	api->QueueWaitAllJobsComplete(jobQueue);
+}
 
-		// NOTE: Because we need to draw on pixel boundaries. We need to round
-		// up to closest pixel otherwise we will have gaps.
-		v1.x = (f32)(i32)(v1.x + 0.5f);
-		v1.y = (f32)(i32)(v1.y + 0.5f);
-		v2.x = (f32)(i32)(v2.x + 0.5f);
-		v2.y = (f32)(i32)(v2.y + 0.5f);
-		v3.x = (f32)(i32)(v3.x + 0.5f);
-		v3.y = (f32)(i32)(v3.y + 0.5f);
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Mesh Vertex Stage
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Post transform vertexes of a mesh in SoA layout. Vertexes are shared by several faces, so they're
+// transformed and lit once per frame here and faces only gather them by index.
+typedef struct RenderMeshVertexes
+{
+	// Screen space position after the perspective divide, has mesh->numVertexes elements
+	f32 *x;
+	f32 *y;
+	f32 *z;
+
+	// dot(normalised normal, normalised light vector), has mesh->numNormals elements. Only
+	// calculated for Gouraud shading, NULL otherwise.
+	f32 *lightIntensity;
+} RenderMeshVertexes;
+
+FILE_SCOPE bool AllocMeshVertexesInternal(DqnMemStack *const tempStack, const DTRMesh *const mesh,
+                                          const bool needsLight, RenderMeshVertexes *const result)
+{
+	result->x = (f32 *)DqnMemStack_Push(tempStack, sizeof(f32) * mesh->numVertexes);
+	result->y = (f32 *)DqnMemStack_Push(tempStack, sizeof(f32) * mesh->numVertexes);
+	result->z = (f32 *)DqnMemStack_Push(tempStack, sizeof(f32) * mesh->numVertexes);
+	if (!result->x || !result->y || !result->z) return false;
 
-		i32 uv1Index = face.texIndex[0];
-		i32 uv2Index = face.texIndex[1];
-		i32 uv3Index = face.texIndex[2];
+	result->lightIntensity = NULL;
+	if (needsLight)
+	{
+		result->lightIntensity = (f32 *)DqnMemStack_Push(tempStack, sizeof(f32) * mesh->numNormals);
+		if (!result->lightIntensity) return false;
+	}
 
-		DQN_ASSERT(uv1Index < (i32)mesh->numTexUV);
-		DQN_ASSERT(uv2Index < (i32)mesh->numTexUV);
-		DQN_ASSERT(uv3Index < (i32)mesh->numTexUV);
+	return true;
+}
+
+// Transform the vertexes in [startIndex, endIndex) to screen space, 4 at a time if SSE2 is available.
+// NOTE: Lanes evaluate in the same order as DqnMat4_MulV4() and DqnV3 scaling, so the results are
+// identical to transforming each vertex individually.
+FILE_SCOPE void TransformMeshVertexesInternal(const DTRMesh *const mesh,
+                                              const DqnMat4 viewPModelViewProjection,
+                                              const u32 startIndex, const u32 endIndex,
+                                              RenderMeshVertexes *const result)
+{
+	const DqnMat4 m = viewPModelViewProjection;
+	u32 index       = startIndex;
+	if (globalDTRPlatformFlags.canUseSSE2)
+	{
+		__m128 m_4x[4][4];
+		for (i32 col = 0; col < 4; col++)
+		{
+			for (i32 row = 0; row < 4; row++)
+				m_4x[col][row] = _mm_set_ps1(m.e[col][row]);
+		}
+
+		const __m128 ONE_4X = _mm_set_ps1(1.0f);
+		for (; index + 4 <= endIndex; index += 4)
+		{
+			__m128 x = _mm_loadu_ps(mesh->vertexes[index + 0].e);
+			__m128 y = _mm_loadu_ps(mesh->vertexes[index + 1].e);
+			__m128 z = _mm_loadu_ps(mesh->vertexes[index + 2].e);
+			__m128 w = _mm_loadu_ps(mesh->vertexes[index + 3].e);
+			_MM_TRANSPOSE4_PS(x, y, z, w);
+
+			__m128 resultX[4];
+			for (i32 row = 0; row < 4; row++)
+			{
+				resultX[row] = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m_4x[0][row], x),
+				                                                _mm_mul_ps(m_4x[1][row], y)),
+				                                     _mm_mul_ps(m_4x[2][row], z)),
+				                          _mm_mul_ps(m_4x[3][row], w));
+			}
+
+			// Perspective Divide to Normalise Device Coordinates
+			__m128 invW = _mm_div_ps(ONE_4X, resultX[3]);
+			_mm_storeu_ps(result->x + index, _mm_mul_ps(resultX[0], invW));
+			_mm_storeu_ps(result->y + index, _mm_mul_ps(resultX[1], invW));
+			_mm_storeu_ps(result->z + index, _mm_mul_ps(resultX[2], invW));
+		}
+	}
+
+	for (; index < endIndex; index++)
+	{
+		DqnV4 v = mesh->vertexes[index];
+		DQN_ASSERT(v.w == 1);
+
+		v     = DqnMat4_MulV4(m, v);
+		v.xyz = (v.xyz / v.w);
+		result->x[index] = v.x;
+		result->y[index] = v.y;
+		result->z[index] = v.z;
+	}
+}
+
+// Light the normals in [startIndex, endIndex) against the normalised light vector, 4 at a time if
+// SSE2 is available. Matches DqnV3_Dot(DqnV3_Normalise(normal), lightVector) exactly.
+FILE_SCOPE void LightMeshNormalsInternal(const DTRMesh *const mesh, const DqnV3 lightVector,
+                                         const u32 startIndex, const u32 endIndex,
+                                         RenderMeshVertexes *const result)
+{
+	u32 index = startIndex;
+	if (globalDTRPlatformFlags.canUseSSE2)
+	{
+		const __m128 ONE_4X    = _mm_set_ps1(1.0f);
+		const __m128 lightX_4x = _mm_set_ps1(lightVector.x);
+		const __m128 lightY_4x = _mm_set_ps1(lightVector.y);
+		const __m128 lightZ_4x = _mm_set_ps1(lightVector.z);
+		for (; index + 4 <= endIndex; index += 4)
+		{
+			const DqnV3 *const n = mesh->normals + index;
+			__m128 x = _mm_setr_ps(n[0].x, n[1].x, n[2].x, n[3].x);
+			__m128 y = _mm_setr_ps(n[0].y, n[1].y, n[2].y, n[3].y);
+			__m128 z = _mm_setr_ps(n[0].z, n[1].z, n[2].z, n[3].z);
+
+			__m128 lengthSq  = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+			__m128 invLength = _mm_div_ps(ONE_4X, _mm_sqrt_ps(lengthSq));
+			x                = _mm_mul_ps(x, invLength);
+			y                = _mm_mul_ps(y, invLength);
+			z                = _mm_mul_ps(z, invLength);
+
+			__m128 intensity = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, lightX_4x), _mm_mul_ps(y, lightY_4x)),
+			                              _mm_mul_ps(z, lightZ_4x));
+			_mm_storeu_ps(result->lightIntensity + index, intensity);
+		}
+	}
+
+	for (; index < endIndex; index++)
+		result->lightIntensity[index] = DqnV3_Dot(DqnV3_Normalise(mesh->normals[index]), lightVector);
+}
+
+#define RENDER_MESH_VERTEXES_PER_JOB 1024
+
+typedef struct RenderMeshVertexesJob
+{
+	DTRMesh            *mesh;
+	DqnMat4             viewPModelViewProjection;
+	DqnV3               lightVector;
+	u32                 startVertex;
+	u32                 endVertex;
+	u32                 startNormal;
+	u32                 endNormal;
+	RenderMeshVertexes *vertexes;
+} RenderMeshVertexesJob;
+
+void MultiThreadedMeshVertexes(PlatformJobQueue *const queue, void *const userData)
+{
+	if (!queue || !userData)
+	{
+		DQN_ASSERT(DQN_INVALID_CODE_PATH);
+		return;
+	}
+
+	RenderMeshVertexesJob *job = (RenderMeshVertexesJob *)userData;
+	TransformMeshVertexesInternal(job->mesh, job->viewPModelViewProjection, job->startVertex,
+	                              job->endVertex, job->vertexes);
+	if (job->vertexes->lightIntensity)
+	{
+		LightMeshNormalsInternal(job->mesh, job->lightVector, job->startNormal, job->endNormal,
+		                         job->vertexes);
+	}
+}
+
+// Setup the faces in [startFace, endFace) from the post transform vertexes. If triList is NULL the
+// faces are rasterised immediately, otherwise they're setup into triList which has an entry per face
+// of the mesh.
+FILE_SCOPE void SetupMeshFacesInternal(DTRRenderContext context, DTRMesh *const mesh,
+                                       const RenderMeshVertexes *const vertexes,
+                                       const DTRRenderLight lighting, const u32 startFace,
+                                       const u32 endFace, RenderTriangleSetup *const triList)
+{
+	if (mesh->clockwise)
+	{
+		if (context.cullMode == DTRRenderCullMode_Back)       context.cullMode = DTRRenderCullMode_Front;
+		else if (context.cullMode == DTRRenderCullMode_Front) context.cullMode = DTRRenderCullMode_Back;
+	}
+
+	for (u32 i = startFace; i < endFace; i++)
+	{
+		const DTRMeshFace *face = mesh->faces + i;
+
+		u32 v1Index = face->vertexIndex[0];
+		u32 v2Index = face->vertexIndex[1];
+		u32 v3Index = face->vertexIndex[2];
+
+		DQN_ASSERT(v1Index < mesh->numVertexes);
+		DQN_ASSERT(v2Index < mesh->numVertexes);
+		DQN_ASSERT(v3Index < mesh->numVertexes);
+
+		DqnV3 v1 = DqnV3_3f(vertexes->x[v1Index], vertexes->y[v1Index], vertexes->z[v1Index]);
+		DqnV3 v2 = DqnV3_3f(vertexes->x[v2Index], vertexes->y[v2Index], vertexes->z[v2Index]);
+		DqnV3 v3 = DqnV3_3f(vertexes->x[v3Index], vertexes->y[v3Index], vertexes->z[v3Index]);
+
+		u32 uv1Index = face->texIndex[0];
+		u32 uv2Index = face->texIndex[1];
+		u32 uv3Index = face->texIndex[2];
+
+		DQN_ASSERT(uv1Index < mesh->numTexUV);
+		DQN_ASSERT(uv2Index < mesh->numTexUV);
+		DQN_ASSERT(uv3Index < mesh->numTexUV);
 
 		DqnV2 uv1 = mesh->texUV[uv1Index].xy;
 		DqnV2 uv2 = mesh->texUV[uv2Index].xy;
@@ -1506,63 +3516,34 @@ void DTRRender_Mesh(DTRRenderContext context, PlatformJobQueue *const jobQueue,
 		RenderLightInternal lightingInternal = {};
 		lightingInternal.mode                = lighting.mode;
 		lightingInternal.vector              = lighting.vector;
-		lightingInternal.normals[0]          = norm1;
-		lightingInternal.normals[1]          = norm2;
-		lightingInternal.normals[2]          = norm3;
-		lightingInternal.numNormals          = 3;
+		if (vertexes->lightIntensity)
+		{
+			u32 norm1Index = face->normalIndex[0];
+			u32 norm2Index = face->normalIndex[1];
+			u32 norm3Index = face->normalIndex[2];
+
+			DQN_ASSERT(norm1Index < mesh->numNormals);
+			DQN_ASSERT(norm2Index < mesh->numNormals);
+			DQN_ASSERT(norm3Index < mesh->numNormals);
+
+			lightingInternal.intensities[0] = vertexes->lightIntensity[norm1Index];
+			lightingInternal.intensities[1] = vertexes->lightIntensity[norm2Index];
+			lightingInternal.intensities[2] = vertexes->lightIntensity[norm3Index];
+			lightingInternal.numIntensities = 3;
+		}
 
 		bool DEBUG_NO_TEX = false;
-		if (context.multithread)
+		DTRBitmap *tex    = (DTR_DEBUG && DEBUG_NO_TEX) ? NULL : &mesh->tex;
+		if (triList)
 		{
-			RenderMeshJob *jobData = (RenderMeshJob *)DqnMemStack_Push(tempStack, sizeof(*jobData));
-			if (jobData)
-			{
-				jobData->v1       = v1.xyz;
-				jobData->v2       = v2.xyz;
-				jobData->v3       = v3.xyz;
-				jobData->uv1      = uv1;
-				jobData->uv2      = uv2;
-				jobData->uv3      = uv3;
-				jobData->color    = color;
-				jobData->lighting = lightingInternal;
-				jobData->context  = context;
-
-				if (DTR_DEBUG && DEBUG_NO_TEX)
-				{
-					jobData->tex = NULL;
-				}
-				else
-				{
-					jobData->tex = &mesh->tex;
-				}
-
-				PlatformJob renderJob = {};
-				renderJob.callback    = MultiThreadedRenderMesh;
-				renderJob.userData    = jobData;
-				while (!api->QueueAddJob(jobQueue, renderJob))
-				{
-					api->QueueTryExecuteNextJob(jobQueue);
-				}
-			}
-			else
-			{
-				// TODO(doyle): Allocation error
-				DQN_ASSERT(DQN_INVALID_CODE_PATH);
-			}
-
+			triList[i] =
+			    SetupTriangleInternal(context, lightingInternal, v1, v2, v3, uv1, uv2, uv3, tex,
+			                          color, DTRRender_DefaultTriangleTransform());
 		}
 		else
 		{
-			if (DTR_DEBUG && DEBUG_NO_TEX)
-			{
-				TexturedTriangleInternal(context, lightingInternal, v1.xyz, v2.xyz, v3.xyz,
-				                         uv1, uv2, uv3, NULL, color);
-			}
-			else
-			{
-				TexturedTriangleInternal(context, lightingInternal, v1.xyz, v2.xyz, v3.xyz,
-				                         uv1, uv2, uv3, &mesh->tex, color);
-			}
+			TexturedTriangleInternal(context, lightingInternal, v1, v2, v3, uv1, uv2, uv3, tex,
+			                         color);
 		}
 
 		bool DEBUG_WIREFRAME = false;
@@ -1574,14 +3555,190 @@ void DTRRender_Mesh(DTRRenderContext context, PlatformJobQueue *const jobQueue,
 			DTRRender_Line(context, DqnV2i_V2(v3.xy), DqnV2i_V2(v1.xy), wireColor);
 		}
 	}
+}
+
+#define RENDER_MESH_FACES_PER_JOB 256
+
+typedef struct RenderMeshFacesJob
+{
+	DTRRenderContext          context;
+	DTRMesh                  *mesh;
+	const RenderMeshVertexes *vertexes;
+	DTRRenderLight            lighting;
+	u32                       startFace;
+	u32                       endFace;
+	RenderTriangleSetup      *triList;
+} RenderMeshFacesJob;
+
+void MultiThreadedSetupMeshFaces(PlatformJobQueue *const queue, void *const userData)
+{
+	if (!queue || !userData)
+	{
+		DQN_ASSERT(DQN_INVALID_CODE_PATH);
+		return;
+	}
+
+	RenderMeshFacesJob *job = (RenderMeshFacesJob *)userData;
+	SetupMeshFacesInternal(job->context, job->mesh, job->vertexes, job->lighting, job->startFace,
+	                       job->endFace, job->triList);
+}
+
+// Model, view and projection of a mesh at pos combined with the viewport, i.e. maps the mesh's
+// vertexes to screen space.
+FILE_SCOPE DqnMat4 MeshScreenMatrixInternal(const DTRRenderBuffer *const renderBuffer,
+                                            const DqnV3 pos, const DTRRenderTransform transform)
+{
+	// Create model matrix
+	DqnMat4 translateMatrix = DqnMat4_Translate(pos.x, pos.y, pos.z);
+	DqnMat4 scaleMatrix     = DqnMat4_ScaleV3(transform.scale);
+	DqnMat4 rotateMatrix =
+	    DqnMat4_Rotate(DQN_DEGREES_TO_RADIANS(transform.rotation), transform.anchor.x,
+	                   transform.anchor.y, transform.anchor.z);
+	DqnMat4 modelMatrix = DqnMat4_Mul(translateMatrix, DqnMat4_Mul(rotateMatrix, scaleMatrix));
+
+	// Create camera matrix
+	DqnV3 eye          = DqnV3_3f(0, 0, 1);
+	DqnV3 up           = DqnV3_3f(0, 1, 0);
+	DqnV3 center       = DqnV3_3f(0, 0, 0);
+	DqnMat4 viewMatrix = DqnMat4_LookAt(eye, center, up);
+
+	// Create projection matrix
+	f32 aspectRatio     = (f32)renderBuffer->width / (f32)renderBuffer->height;
+	DqnMat4 perspective = DqnMat4_Perspective(80.0f, aspectRatio, 0.5f, 100.0f);
+	perspective         = DqnMat4_Identity();
+	perspective.e[2][3] = -1.0f / DqnV3_Length(eye, center);
+
+	// Combine matrix + matrix that maps NDC to screen space
+	DqnMat4 viewport  = GLViewport(0, 0, (f32)renderBuffer->width, (f32)renderBuffer->height);
+	DqnMat4 modelView = DqnMat4_Mul(viewMatrix, modelMatrix);
+	DqnMat4 modelViewProjection = DqnMat4_Mul(perspective, modelView);
+	DqnMat4 result              = DqnMat4_Mul(viewport, modelViewProjection);
+	return result;
+}
+
+// Run the vertex stage of the mesh and setup its faces into triList, which needs an entry per face.
+// Multithreaded contexts with a jobQueue split the stages into jobs on it, otherwise the stages run
+// on this thread. Single threaded contexts may pass a NULL triList to rasterise the faces
+// immediately. Returns false if out of memory.
+FILE_SCOPE bool SetupMeshTrianglesInternal(DTRRenderContext context, DTRMesh *const mesh,
+                                           DTRRenderLight lighting, const DqnV3 pos,
+                                           const DTRRenderTransform transform,
+                                           RenderTriangleSetup *const triList)
+{
+	DqnMemStack *const tempStack        = context.tempStack;
+	DTRRenderBuffer *const renderBuffer = context.renderBuffer;
+	PlatformAPI *const api              = context.api;
+	PlatformJobQueue *const jobQueue    = context.jobQueue;
+	DQN_ASSERT(triList || !context.multithread);
+
+	DqnMat4 viewPModelViewProjection = MeshScreenMatrixInternal(renderBuffer, pos, transform);
+
+	////////////////////////////////////////////////////////////////////////////
+	// Vertex Stage
+	////////////////////////////////////////////////////////////////////////////
+	RenderMeshVertexes vertexes = {};
+	const bool needsLight       = (lighting.mode == DTRRenderShadingMode_Gouraud);
+	const DqnV3 lightVector     = (needsLight) ? DqnV3_Normalise(lighting.vector) : DqnV3_1f(0);
+	if (!AllocMeshVertexesInternal(tempStack, mesh, needsLight, &vertexes)) return false;
+
+	if (!context.multithread || !jobQueue)
+	{
+		TransformMeshVertexesInternal(mesh, viewPModelViewProjection, 0, mesh->numVertexes,
+		                              &vertexes);
+		if (needsLight) LightMeshNormalsInternal(mesh, lightVector, 0, mesh->numNormals, &vertexes);
+
+		SetupMeshFacesInternal(context, mesh, &vertexes, lighting, 0, mesh->numFaces, triList);
+		return true;
+	}
+
+	{
+		const u32 numItems = DQN_MAX(mesh->numVertexes, (needsLight) ? mesh->numNormals : 0);
+		const u32 numJobs  = (numItems + RENDER_MESH_VERTEXES_PER_JOB - 1) / RENDER_MESH_VERTEXES_PER_JOB;
+		RenderMeshVertexesJob *jobDataList = (RenderMeshVertexesJob *)DqnMemStack_Push(tempStack, sizeof(*jobDataList) * numJobs);
+		PlatformJob *jobList               = (PlatformJob *)DqnMemStack_Push(tempStack, sizeof(*jobList) * numJobs);
+		if (!jobDataList || !jobList) return false;
+
+		for (u32 i = 0; i < numJobs; i++)
+		{
+			const u32 start = i * RENDER_MESH_VERTEXES_PER_JOB;
+			const u32 end   = start + RENDER_MESH_VERTEXES_PER_JOB;
+
+			RenderMeshVertexesJob *jobData    = &jobDataList[i];
+			jobData->mesh                     = mesh;
+			jobData->viewPModelViewProjection = viewPModelViewProjection;
+			jobData->lightVector              = lightVector;
+			jobData->startVertex              = DQN_MIN(start, mesh->numVertexes);
+			jobData->endVertex                = DQN_MIN(end, mesh->numVertexes);
+			jobData->startNormal              = DQN_MIN(start, mesh->numNormals);
+			jobData->endNormal                = DQN_MIN(end, mesh->numNormals);
+			jobData->vertexes                 = &vertexes;
+
+			jobList[i].callback = MultiThreadedMeshVertexes;
+			jobList[i].userData = jobData;
+		}
+
+		Platform_QueueAddAllJobs(api, jobQueue, jobList, numJobs);
+		api->QueueWaitAllJobsComplete(jobQueue);
+	}
+
+	////////////////////////////////////////////////////////////////////////////
+	// Setup faces in ranges of RENDER_MESH_FACES_PER_JOB as jobs
+	////////////////////////////////////////////////////////////////////////////
+	const u32 numJobs = (mesh->numFaces + RENDER_MESH_FACES_PER_JOB - 1) / RENDER_MESH_FACES_PER_JOB;
+	RenderMeshFacesJob *jobDataList = (RenderMeshFacesJob *)DqnMemStack_Push(tempStack, sizeof(*jobDataList) * numJobs);
+	PlatformJob *jobList            = (PlatformJob *)DqnMemStack_Push(tempStack, sizeof(*jobList) * numJobs);
+	if (!jobDataList || !jobList) return false;
+
+	for (u32 i = 0; i < numJobs; i++)
+	{
+		RenderMeshFacesJob *jobData = &jobDataList[i];
+		jobData->context   = context;
+		jobData->mesh      = mesh;
+		jobData->vertexes  = &vertexes;
+		jobData->lighting  = lighting;
+		jobData->startFace = i * RENDER_MESH_FACES_PER_JOB;
+		jobData->endFace   = DQN_MIN(jobData->startFace + RENDER_MESH_FACES_PER_JOB, mesh->numFaces);
+		jobData->triList   = triList;
+
+		jobList[i].callback = MultiThreadedSetupMeshFaces;
+		jobList[i].userData = jobData;
+	}
 
+	Platform_QueueAddAllJobs(api, jobQueue, jobList, numJobs);
+	api->QueueWaitAllJobsComplete(jobQueue);
+	return true;
+}
+
+void DTRRender_Mesh(DTRRenderContext context, PlatformJobQueue *const jobQueue, DTRMesh *const mesh,
+                    DTRRenderLight lighting, const DqnV3 pos, const DTRRenderTransform transform)
+{
+	DqnMemStack *const tempStack        = context.tempStack;
+	DTRRenderBuffer *const renderBuffer = context.renderBuffer;
+	PlatformAPI *const api              = context.api;
+
+	if (!mesh || !renderBuffer || !tempStack || !api || !jobQueue) return;
+	context.jobQueue = jobQueue;
+
+	RenderTriangleSetup *triList = NULL;
 	if (context.multithread)
 	{
-		// NOTE(doyle): Complete remaining jobs and wait until all jobs finished
-		// before leaving function.
-		while (api->QueueTryExecuteNextJob(jobQueue) || !api->QueueAllJobsComplete(jobQueue))
-			;
+		triList = (RenderTriangleSetup *)DqnMemStack_Push(tempStack, sizeof(*triList) * mesh->numFaces);
+		if (!triList)
+		{
+			// TODO(doyle): Allocation error
+			DQN_ASSERT(DQN_INVALID_CODE_PATH);
+			return;
+		}
+	}
+
+	if (!SetupMeshTrianglesInternal(context, mesh, lighting, pos, transform, triList))
+	{
+		// TODO(doyle): Allocation error
+		DQN_ASSERT(DQN_INVALID_CODE_PATH);
+		return;
 	}
+
+	if (triList) RenderTrianglesInTiles(context, triList, mesh->numFaces);
 }
 
 void DTRRender_Triangle(DTRRenderContext context, DqnV3 p1, DqnV3 p2, DqnV3 p3, DqnV4 color,
@@ -1593,6 +3750,468 @@ void DTRRender_Triangle(DTRRenderContext context, DqnV3 p1, DqnV3 p2, DqnV3 p3,
 	                         NO_UV, NO_TEX, color, transform);
 }
 
+// Bilinear filter the texel under pixel (bufferX, bufferY) of the bitmap quad and write it.
+FILE_SCOPE void BitmapPixelInternal(DTRRenderContext context, const RenderQuadSetup *const quad,
+                                    const i32 bufferX, const i32 bufferY)
+{
+	DTRBitmap *const bitmap     = quad->bitmap;
+	const DqnV4 color           = quad->color;
+	const DqnV2 rectBasis       = quad->rectBasis;
+	const DqnV2 xAxisRelToBasis = quad->xAxisRelToBasis;
+	const DqnV2 yAxisRelToBasis = quad->yAxisRelToBasis;
+	const f32 invXAxisLenSq     = quad->invXAxisLenSq;
+	const f32 invYAxisLenSq     = quad->invYAxisLenSq;
+
+	DTR_DEBUG_EP_TIMED_BLOCK("DTRRender_Bitmap TexelCalculation");
+	DqnV2 bufPRelToBasis = DqnV2_2i(bufferX, bufferY) - rectBasis;
+
+	f32 u = DqnV2_Dot(bufPRelToBasis, xAxisRelToBasis) * invXAxisLenSq;
+	f32 v = DqnV2_Dot(bufPRelToBasis, yAxisRelToBasis) * invYAxisLenSq;
+	u     = DqnMath_Clampf(u, 0.0f, 1.0f);
+	v     = DqnMath_Clampf(v, 0.0f, 1.0f);
+
+	f32 texelXf = u * (f32)(bitmap->dim.w - 1);
+	f32 texelYf = v * (f32)(bitmap->dim.h - 1);
+	DQN_ASSERT(texelXf >= 0 && texelXf < bitmap->dim.w);
+	DQN_ASSERT(texelYf >= 0 && texelYf < bitmap->dim.h);
+
+	i32 texelX           = (i32)texelXf;
+	i32 texelY           = (i32)texelYf;
+	f32 texelFractionalX = texelXf - texelX;
+	f32 texelFractionalY = texelYf - texelY;
+
+	i32 texel1X = texelX;
+	i32 texel1Y = texelY;
+
+	i32 texel2X = DQN_MIN((texelX + 1), bitmap->dim.w - 1);
+	i32 texel2Y = texelY;
+
+	i32 texel3X = texelX;
+	i32 texel3Y = DQN_MIN((texelY + 1), bitmap->dim.h - 1);
+
+	i32 texel4X = DQN_MIN((texelX + 1), bitmap->dim.w - 1);
+	i32 texel4Y = DQN_MIN((texelY + 1), bitmap->dim.h - 1);
+
+	{
+		DTR_DEBUG_EP_TIMED_BLOCK("DTRRender_Bitmap TexelBilinearInterpolation");
+		DqnV4 color1 = BitmapTexelToLinear1Internal(bitmap, DTRAsset_BitmapTexelIndex(bitmap, texel1X, texel1Y));
+		DqnV4 color2 = BitmapTexelToLinear1Internal(bitmap, DTRAsset_BitmapTexelIndex(bitmap, texel2X, texel2Y));
+		DqnV4 color3 = BitmapTexelToLinear1Internal(bitmap, DTRAsset_BitmapTexelIndex(bitmap, texel3X, texel3Y));
+		DqnV4 color4 = BitmapTexelToLinear1Internal(bitmap, DTRAsset_BitmapTexelIndex(bitmap, texel4X, texel4Y));
+
+		DqnV4 color12;
+		color12.a = DqnMath_Lerp(color1.a, texelFractionalX, color2.a);
+		color12.b = DqnMath_Lerp(color1.b, texelFractionalX, color2.b);
+		color12.g = DqnMath_Lerp(color1.g, texelFractionalX, color2.g);
+		color12.r = DqnMath_Lerp(color1.r, texelFractionalX, color2.r);
+
+		DqnV4 color34;
+		color34.a = DqnMath_Lerp(color3.a, texelFractionalX, color4.a);
+		color34.b = DqnMath_Lerp(color3.b, texelFractionalX, color4.b);
+		color34.g = DqnMath_Lerp(color3.g, texelFractionalX, color4.g);
+		color34.r = DqnMath_Lerp(color3.r, texelFractionalX, color4.r);
+
+		DqnV4 blend;
+		blend.a = DqnMath_Lerp(color12.a, texelFractionalY, color34.a);
+		blend.b = DqnMath_Lerp(color12.b, texelFractionalY, color34.b);
+		blend.g = DqnMath_Lerp(color12.g, texelFractionalY, color34.g);
+		blend.r = DqnMath_Lerp(color12.r, texelFractionalY, color34.r);
+
+		DQN_ASSERT(blend.a >= 0 && blend.a <= 1.0f);
+		DQN_ASSERT(blend.r >= 0 && blend.r <= 1.0f);
+		DQN_ASSERT(blend.g >= 0 && blend.g <= 1.0f);
+		DQN_ASSERT(blend.b >= 0 && blend.b <= 1.0f);
+
+		// TODO(doyle): Color modulation does not work!!! By supplying
+		// colors [0->1] it'll reduce some of the coverage of a channel
+		// and once alpha blending is applied that reduced coverage will
+		// blend with the background and cause the bitmap to go
+		// transparent when it shouldn't.
+		blend.a *= color.a;
+		blend.r *= color.r;
+		blend.g *= color.g;
+		blend.b *= color.b;
+
+		SetPixel(context, bufferX, bufferY, blend, ColorSpace_Linear);
+	}
+}
+
+// color: _mm_set_ps(a, b, g, r) ie. 0=r, 1=g, 2=b, 3=a
+// See DqnMath_Lerp(), a + (b - a) * t
+FILE_SCOPE inline __m128 SIMDLerp(const __m128 a, const __m128 t, const __m128 b)
+{
+	__m128 result = _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t));
+	return result;
+}
+
+DTR_TARGET_AVX2 FILE_SCOPE inline __m256 SIMDLerpAVX2(const __m256 a, const __m256 t, const __m256 b)
+{
+	__m256 result = _mm256_add_ps(a, _mm256_mul_ps(_mm256_sub_ps(b, a), t));
+	return result;
+}
+
+// Fetch the 4 texels at indexLanes and unpack them to channels with RGB in linear space and alpha
+// in [0->1], see BitmapTexelToLinear1Internal()
+FILE_SCOPE inline void SIMDBitmapTexelsToLinear1(const DTRBitmap *const bitmap,
+                                                 const i32 *const indexLanes, __m128 *const r,
+                                                 __m128 *const g, __m128 *const b, __m128 *const a)
+{
+	if (bitmap->format == DTRBitmapFormat_Linear16)
+	{
+		const __m128 INV65535_4X   = _mm_set_ps1(DTRRENDER_INV_65535);
+		const __m128i MASK_FFFF_4X = _mm_set1_epi32(0xFFFF);
+		const u64 *const texture16 = (u64 *)bitmap->memory;
+
+		u64 texelLanes[4];
+		for (i32 lane = 0; lane < 4; lane++)
+			texelLanes[lane] = texture16[indexLanes[lane]];
+
+		// Texel Format: AAAA BBBB GGGG RRRR, gather the GGRR and AABB halves of each texel
+		__m128i texel01 = _mm_shuffle_epi32(_mm_loadu_si128((__m128i *)(texelLanes + 0)), _MM_SHUFFLE(3, 1, 2, 0));
+		__m128i texel23 = _mm_shuffle_epi32(_mm_loadu_si128((__m128i *)(texelLanes + 2)), _MM_SHUFFLE(3, 1, 2, 0));
+		__m128i texelGR = _mm_unpacklo_epi64(texel01, texel23);
+		__m128i texelAB = _mm_unpackhi_epi64(texel01, texel23);
+
+		*r = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(texelGR, MASK_FFFF_4X)), INV65535_4X);
+		*g = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(texelGR, 16)), INV65535_4X);
+		*b = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(texelAB, MASK_FFFF_4X)), INV65535_4X);
+		*a = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(texelAB, 16)), INV65535_4X);
+	}
+	else
+	{
+		const __m128 INV255_4X    = _mm_set_ps1(DTRRENDER_INV_255);
+		const __m128i MASK_FF_4X  = _mm_set1_epi32(0xFF);
+		const u32 *const texture8 = (u32 *)bitmap->memory;
+
+		u32 texelLanes[4];
+		for (i32 lane = 0; lane < 4; lane++)
+			texelLanes[lane] = texture8[indexLanes[lane]];
+
+		// Texel Format: AA BB GG RR
+		__m128i texel = _mm_loadu_si128((__m128i *)texelLanes);
+		*r = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(texel, MASK_FF_4X)), INV255_4X);
+		*g = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(texel, 8), MASK_FF_4X)), INV255_4X);
+		*b = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(texel, 16), MASK_FF_4X)), INV255_4X);
+		*a = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(texel, 24)), INV255_4X);
+		*r = _mm_mul_ps(*r, *r);
+		*g = _mm_mul_ps(*g, *g);
+		*b = _mm_mul_ps(*b, *b);
+	}
+}
+
+// AVX2 version of SIMDBitmapTexelsToLinear1 for 8 texels, gathers the texels at texelIndex.
+DTR_TARGET_AVX2 FILE_SCOPE inline void SIMDBitmapTexelsToLinear1AVX2(const DTRBitmap *const bitmap,
+                                                                     const __m256i texelIndex,
+                                                                     __m256 *const r, __m256 *const g,
+                                                                     __m256 *const b, __m256 *const a)
+{
+	if (bitmap->format == DTRBitmapFormat_Linear16)
+	{
+		const __m256 INV65535_8X   = _mm256_set1_ps(DTRRENDER_INV_65535);
+		const __m256i MASK_FFFF_8X = _mm256_set1_epi32(0xFFFF);
+		const __m256i SPLIT_U64_8X = _mm256_set_epi32(7, 5, 3, 1, 6, 4, 2, 0);
+
+		// Texel Format: AAAA BBBB GGGG RRRR, 4 texels per gather. Each gather is split into the GGRR
+		// halves in the low 128 bits and AABB halves in the high 128 bits.
+		__m256i texel0to3 = _mm256_i32gather_epi64((const long long *)bitmap->memory,
+		                                           _mm256_castsi256_si128(texelIndex), sizeof(u64));
+		__m256i texel4to7 = _mm256_i32gather_epi64((const long long *)bitmap->memory,
+		                                           _mm256_extracti128_si256(texelIndex, 1), sizeof(u64));
+		texel0to3         = _mm256_permutevar8x32_epi32(texel0to3, SPLIT_U64_8X);
+		texel4to7         = _mm256_permutevar8x32_epi32(texel4to7, SPLIT_U64_8X);
+		__m256i texelGR   = _mm256_permute2x128_si256(texel0to3, texel4to7, 0x20);
+		__m256i texelAB   = _mm256_permute2x128_si256(texel0to3, texel4to7, 0x31);
+
+		*r = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(texelGR, MASK_FFFF_8X)), INV65535_8X);
+		*g = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(texelGR, 16)), INV65535_8X);
+		*b = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(texelAB, MASK_FFFF_8X)), INV65535_8X);
+		*a = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(texelAB, 16)), INV65535_8X);
+	}
+	else
+	{
+		const __m256 INV255_8X   = _mm256_set1_ps(DTRRENDER_INV_255);
+		const __m256i MASK_FF_8X = _mm256_set1_epi32(0xFF);
+
+		// Texel Format: AA BB GG RR
+		__m256i texel = _mm256_i32gather_epi32((const int *)bitmap->memory, texelIndex, sizeof(u32));
+		*r = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(texel, MASK_FF_8X)), INV255_8X);
+		*g = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(texel, 8), MASK_FF_8X)), INV255_8X);
+		*b = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(texel, 16), MASK_FF_8X)), INV255_8X);
+		*a = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(texel, 24)), INV255_8X);
+		*r = _mm256_mul_ps(*r, *r);
+		*g = _mm256_mul_ps(*g, *g);
+		*b = _mm256_mul_ps(*b, *b);
+	}
+}
+
+// NOTE: See DTRAsset_BitmapTexelIndex()
+DTR_TARGET_AVX2 FILE_SCOPE inline __m256i SIMDBitmapTexelIndexAVX2(const DTRBitmap *const bitmap,
+                                                                   const __m256i texelX,
+                                                                   const __m256i texelY)
+{
+	const __m256i pitch_8x = _mm256_set1_epi32(DTRAsset_BitmapPitch(bitmap));
+	if (bitmap->layout == DTRBitmapLayout_Tiled4x4)
+	{
+		const __m256i MASK_3_8X = _mm256_set1_epi32(3);
+		__m256i tileIndex   = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_andnot_si256(MASK_3_8X, texelY), pitch_8x),
+		                                       _mm256_slli_epi32(_mm256_andnot_si256(MASK_3_8X, texelX), 2));
+		__m256i inTileIndex = _mm256_add_epi32(_mm256_slli_epi32(_mm256_and_si256(texelY, MASK_3_8X), 2),
+		                                       _mm256_and_si256(texelX, MASK_3_8X));
+		return _mm256_add_epi32(tileIndex, inTileIndex);
+	}
+
+	__m256i result = _mm256_add_epi32(texelX, _mm256_mullo_epi32(texelY, pitch_8x));
+	return result;
+}
+
+// SSE2 version of BitmapPixelInternal, bilinear filters 4 horizontally adjacent pixels of the span
+// [x, endX) of row y per iteration. u and v are linear in x so each step adds a constant to them.
+// Returns the first pixel not drawn, less than 4 pixels are left for the caller.
+FILE_SCOPE i32 SIMDBitmapSpan(DTRRenderContext context, const RenderQuadSetup *const quad,
+                              const i32 y, i32 x, const i32 endX)
+{
+	const i32 NUM_X_PIXELS_TO_SIMD = 4;
+	if ((endX - x) < NUM_X_PIXELS_TO_SIMD) return x;
+
+	DTRRenderBuffer *const renderBuffer = context.renderBuffer;
+	const DTRBitmap *const bitmap       = quad->bitmap;
+	const i32 texMaxX                   = bitmap->dim.w - 1;
+	const i32 texMaxY                   = bitmap->dim.h - 1;
+	const bool blendOpaque              = (context.blendMode == DTRRenderBlendMode_Opaque);
+	const bool blendAdditive            = (context.blendMode == DTRRenderBlendMode_Additive);
+
+	const __m128 ZERO_4X        = _mm_set_ps1(0.0f);
+	const __m128 ONE_4X         = _mm_set_ps1(1.0f);
+	const __m128 INV255_4X      = _mm_set_ps1(DTRRENDER_INV_255);
+	const __m128 MAX_255_4X     = _mm_set_ps1(255.0f);
+	const __m128i MASK_FF_4X    = _mm_set1_epi32(0xFF);
+	const __m128 LANE_OFFSET_4X = _mm_set_ps(3, 2, 1, 0);
+	const __m128 texMaxX_4x     = _mm_set_ps1((f32)texMaxX);
+	const __m128 texMaxY_4x     = _mm_set_ps1((f32)texMaxY);
+	const __m128 colorR_4x      = _mm_set_ps1(quad->color.r);
+	const __m128 colorG_4x      = _mm_set_ps1(quad->color.g);
+	const __m128 colorB_4x      = _mm_set_ps1(quad->color.b);
+	const __m128 colorA_4x      = _mm_set_ps1(quad->color.a);
+
+	// NOTE: See BitmapPixelInternal(), u and v of the first pixel and their step per pixel
+	const DqnV2 bufPRelToBasis = DqnV2_2i(x, y) - quad->rectBasis;
+	const f32 uStep            = quad->xAxisRelToBasis.x * quad->invXAxisLenSq;
+	const f32 vStep            = quad->yAxisRelToBasis.x * quad->invYAxisLenSq;
+	const __m128 uStep_4x      = _mm_set_ps1(uStep * NUM_X_PIXELS_TO_SIMD);
+	const __m128 vStep_4x      = _mm_set_ps1(vStep * NUM_X_PIXELS_TO_SIMD);
+	__m128 u = _mm_add_ps(_mm_set_ps1(DqnV2_Dot(bufPRelToBasis, quad->xAxisRelToBasis) * quad->invXAxisLenSq),
+	                      _mm_mul_ps(LANE_OFFSET_4X, _mm_set_ps1(uStep)));
+	__m128 v = _mm_add_ps(_mm_set_ps1(DqnV2_Dot(bufPRelToBasis, quad->yAxisRelToBasis) * quad->invYAxisLenSq),
+	                      _mm_mul_ps(LANE_OFFSET_4X, _mm_set_ps1(vStep)));
+
+	DTR_DEBUG_EP_TIMED_BLOCK("DTRRender_Bitmap TexelBilinearInterpolation");
+	const u32 pitchInU32 = (renderBuffer->width * renderBuffer->bytesPerPixel) / 4;
+	u32 *const pixelRow  = (u32 *)renderBuffer->memory + (y * pitchInU32);
+	for (; (x + NUM_X_PIXELS_TO_SIMD) <= endX; x += NUM_X_PIXELS_TO_SIMD)
+	{
+		__m128 texelXf = _mm_mul_ps(_mm_min_ps(_mm_max_ps(u, ZERO_4X), ONE_4X), texMaxX_4x);
+		__m128 texelYf = _mm_mul_ps(_mm_min_ps(_mm_max_ps(v, ZERO_4X), ONE_4X), texMaxY_4x);
+		u              = _mm_add_ps(u, uStep_4x);
+		v              = _mm_add_ps(v, vStep_4x);
+
+		__m128i texelX          = _mm_cvttps_epi32(texelXf);
+		__m128i texelY          = _mm_cvttps_epi32(texelYf);
+		__m128 texelFractionalX = _mm_sub_ps(texelXf, _mm_cvtepi32_ps(texelX));
+		__m128 texelFractionalY = _mm_sub_ps(texelYf, _mm_cvtepi32_ps(texelY));
+
+		i32 texelXLanes[4], texelYLanes[4];
+		_mm_storeu_si128((__m128i *)texelXLanes, texelX);
+		_mm_storeu_si128((__m128i *)texelYLanes, texelY);
+
+		// NOTE: The 4 texels around each pixel, ordered like BitmapPixelInternal()
+		i32 index1Lanes[4], index2Lanes[4], index3Lanes[4], index4Lanes[4];
+		for (i32 lane = 0; lane < NUM_X_PIXELS_TO_SIMD; lane++)
+		{
+			i32 texel1X       = texelXLanes[lane];
+			i32 texel1Y       = texelYLanes[lane];
+			i32 texel4X       = DQN_MIN((texel1X + 1), texMaxX);
+			i32 texel4Y       = DQN_MIN((texel1Y + 1), texMaxY);
+			index1Lanes[lane] = DTRAsset_BitmapTexelIndex(bitmap, texel1X, texel1Y);
+			index2Lanes[lane] = DTRAsset_BitmapTexelIndex(bitmap, texel4X, texel1Y);
+			index3Lanes[lane] = DTRAsset_BitmapTexelIndex(bitmap, texel1X, texel4Y);
+			index4Lanes[lane] = DTRAsset_BitmapTexelIndex(bitmap, texel4X, texel4Y);
+		}
+
+		__m128 r1, g1, b1, a1, r2, g2, b2, a2, r3, g3, b3, a3, r4, g4, b4, a4;
+		SIMDBitmapTexelsToLinear1(bitmap, index1Lanes, &r1, &g1, &b1, &a1);
+		SIMDBitmapTexelsToLinear1(bitmap, index2Lanes, &r2, &g2, &b2, &a2);
+		SIMDBitmapTexelsToLinear1(bitmap, index3Lanes, &r3, &g3, &b3, &a3);
+		SIMDBitmapTexelsToLinear1(bitmap, index4Lanes, &r4, &g4, &b4, &a4);
+
+		__m128 blendR = SIMDLerp(SIMDLerp(r1, texelFractionalX, r2), texelFractionalY, SIMDLerp(r3, texelFractionalX, r4));
+		__m128 blendG = SIMDLerp(SIMDLerp(g1, texelFractionalX, g2), texelFractionalY, SIMDLerp(g3, texelFractionalX, g4));
+		__m128 blendB = SIMDLerp(SIMDLerp(b1, texelFractionalX, b2), texelFractionalY, SIMDLerp(b3, texelFractionalX, b4));
+		__m128 blendA = SIMDLerp(SIMDLerp(a1, texelFractionalX, a2), texelFractionalY, SIMDLerp(a3, texelFractionalX, a4));
+		blendR        = _mm_mul_ps(blendR, colorR_4x);
+		blendG        = _mm_mul_ps(blendG, colorG_4x);
+		blendB        = _mm_mul_ps(blendB, colorB_4x);
+		blendA        = _mm_mul_ps(blendA, colorA_4x);
+
+		////////////////////////////////////////////////////////////////////////
+		// Blend, PreAlphaMulColor + (1 - Alpha) * Src, see DTRRenderBlendMode
+		////////////////////////////////////////////////////////////////////////
+		__m128 destR = blendR;
+		__m128 destG = blendG;
+		__m128 destB = blendB;
+		if (!blendOpaque)
+		{
+			// Pixel Format: XX RR GG BB
+			__m128i srcPixel = _mm_loadu_si128((__m128i *)(pixelRow + x));
+			__m128 srcR = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(srcPixel, 16), MASK_FF_4X)), INV255_4X);
+			__m128 srcG = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(srcPixel, 8), MASK_FF_4X)), INV255_4X);
+			__m128 srcB = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(srcPixel, MASK_FF_4X)), INV255_4X);
+
+			__m128 invA = (blendAdditive) ? ONE_4X : _mm_sub_ps(ONE_4X, blendA);
+			destR      = _mm_add_ps(blendR, _mm_mul_ps(invA, _mm_mul_ps(srcR, srcR)));
+			destG      = _mm_add_ps(blendG, _mm_mul_ps(invA, _mm_mul_ps(srcG, srcG)));
+			destB      = _mm_add_ps(blendB, _mm_mul_ps(invA, _mm_mul_ps(srcB, srcB)));
+		}
+
+		destR = _mm_min_ps(_mm_mul_ps(_mm_sqrt_ps(destR), MAX_255_4X), MAX_255_4X);
+		destG = _mm_min_ps(_mm_mul_ps(_mm_sqrt_ps(destG), MAX_255_4X), MAX_255_4X);
+		destB = _mm_min_ps(_mm_mul_ps(_mm_sqrt_ps(destB), MAX_255_4X), MAX_255_4X);
+
+		__m128i destPixel = _mm_or_si128(_mm_slli_epi32(_mm_cvttps_epi32(destR), 16),
+		                                 _mm_or_si128(_mm_slli_epi32(_mm_cvttps_epi32(destG), 8),
+		                                              _mm_cvttps_epi32(destB)));
+		_mm_storeu_si128((__m128i *)(pixelRow + x), destPixel);
+	}
+
+	return x;
+}
+
+// AVX2 version of SIMDBitmapSpan, bilinear filters 8 pixels per iteration and gathers the texels.
+DTR_TARGET_AVX2 FILE_SCOPE i32 SIMDBitmapSpanAVX2(DTRRenderContext context,
+                                                  const RenderQuadSetup *const quad, const i32 y,
+                                                  i32 x, const i32 endX)
+{
+	const i32 NUM_X_PIXELS_TO_SIMD = 8;
+	if ((endX - x) < NUM_X_PIXELS_TO_SIMD) return x;
+
+	DTRRenderBuffer *const renderBuffer = context.renderBuffer;
+	const DTRBitmap *const bitmap       = quad->bitmap;
+	const bool blendOpaque              = (context.blendMode == DTRRenderBlendMode_Opaque);
+	const bool blendAdditive            = (context.blendMode == DTRRenderBlendMode_Additive);
+
+	const __m256 ZERO_8X        = _mm256_set1_ps(0.0f);
+	const __m256 ONE_8X         = _mm256_set1_ps(1.0f);
+	const __m256 INV255_8X      = _mm256_set1_ps(DTRRENDER_INV_255);
+	const __m256 MAX_255_8X     = _mm256_set1_ps(255.0f);
+	const __m256i MASK_FF_8X    = _mm256_set1_epi32(0xFF);
+	const __m256i ONE_I_8X      = _mm256_set1_epi32(1);
+	const __m256 LANE_OFFSET_8X = _mm256_set_ps(7, 6, 5, 4, 3, 2, 1, 0);
+	const __m256 texMaxX_8x     = _mm256_set1_ps((f32)(bitmap->dim.w - 1));
+	const __m256 texMaxY_8x     = _mm256_set1_ps((f32)(bitmap->dim.h - 1));
+	const __m256i texMaxXi_8x   = _mm256_set1_epi32(bitmap->dim.w - 1);
+	const __m256i texMaxYi_8x   = _mm256_set1_epi32(bitmap->dim.h - 1);
+	const __m256 colorR_8x      = _mm256_set1_ps(quad->color.r);
+	const __m256 colorG_8x      = _mm256_set1_ps(quad->color.g);
+	const __m256 colorB_8x      = _mm256_set1_ps(quad->color.b);
+	const __m256 colorA_8x      = _mm256_set1_ps(quad->color.a);
+
+	// NOTE: See BitmapPixelInternal(), u and v of the first pixel and their step per pixel
+	const DqnV2 bufPRelToBasis = DqnV2_2i(x, y) - quad->rectBasis;
+	const f32 uStep            = quad->xAxisRelToBasis.x * quad->invXAxisLenSq;
+	const f32 vStep            = quad->yAxisRelToBasis.x * quad->invYAxisLenSq;
+	const __m256 uStep_8x      = _mm256_set1_ps(uStep * NUM_X_PIXELS_TO_SIMD);
+	const __m256 vStep_8x      = _mm256_set1_ps(vStep * NUM_X_PIXELS_TO_SIMD);
+	__m256 u = _mm256_add_ps(_mm256_set1_ps(DqnV2_Dot(bufPRelToBasis, quad->xAxisRelToBasis) * quad->invXAxisLenSq),
+	                         _mm256_mul_ps(LANE_OFFSET_8X, _mm256_set1_ps(uStep)));
+	__m256 v = _mm256_add_ps(_mm256_set1_ps(DqnV2_Dot(bufPRelToBasis, quad->yAxisRelToBasis) * quad->invYAxisLenSq),
+	                         _mm256_mul_ps(LANE_OFFSET_8X, _mm256_set1_ps(vStep)));
+
+	DTR_DEBUG_EP_TIMED_BLOCK("DTRRender_Bitmap TexelBilinearInterpolation");
+	const u32 pitchInU32 = (renderBuffer->width * renderBuffer->bytesPerPixel) / 4;
+	u32 *const pixelRow  = (u32 *)renderBuffer->memory + (y * pitchInU32);
+	for (; (x + NUM_X_PIXELS_TO_SIMD) <= endX; x += NUM_X_PIXELS_TO_SIMD)
+	{
+		__m256 texelXf = _mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(u, ZERO_8X), ONE_8X), texMaxX_8x);
+		__m256 texelYf = _mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(v, ZERO_8X), ONE_8X), texMaxY_8x);
+		u              = _mm256_add_ps(u, uStep_8x);
+		v              = _mm256_add_ps(v, vStep_8x);
+
+		__m256i texel1X         = _mm256_cvttps_epi32(texelXf);
+		__m256i texel1Y         = _mm256_cvttps_epi32(texelYf);
+		__m256 texelFractionalX = _mm256_sub_ps(texelXf, _mm256_cvtepi32_ps(texel1X));
+		__m256 texelFractionalY = _mm256_sub_ps(texelYf, _mm256_cvtepi32_ps(texel1Y));
+
+		// NOTE: The 4 texels around each pixel, ordered like BitmapPixelInternal()
+		__m256i texel4X = _mm256_min_epi32(_mm256_add_epi32(texel1X, ONE_I_8X), texMaxXi_8x);
+		__m256i texel4Y = _mm256_min_epi32(_mm256_add_epi32(texel1Y, ONE_I_8X), texMaxYi_8x);
+
+		__m256 r1, g1, b1, a1, r2, g2, b2, a2, r3, g3, b3, a3, r4, g4, b4, a4;
+		SIMDBitmapTexelsToLinear1AVX2(bitmap, SIMDBitmapTexelIndexAVX2(bitmap, texel1X, texel1Y), &r1, &g1, &b1, &a1);
+		SIMDBitmapTexelsToLinear1AVX2(bitmap, SIMDBitmapTexelIndexAVX2(bitmap, texel4X, texel1Y), &r2, &g2, &b2, &a2);
+		SIMDBitmapTexelsToLinear1AVX2(bitmap, SIMDBitmapTexelIndexAVX2(bitmap, texel1X, texel4Y), &r3, &g3, &b3, &a3);
+		SIMDBitmapTexelsToLinear1AVX2(bitmap, SIMDBitmapTexelIndexAVX2(bitmap, texel4X, texel4Y), &r4, &g4, &b4, &a4);
+
+		__m256 blendR = SIMDLerpAVX2(SIMDLerpAVX2(r1, texelFractionalX, r2), texelFractionalY, SIMDLerpAVX2(r3, texelFractionalX, r4));
+		__m256 blendG = SIMDLerpAVX2(SIMDLerpAVX2(g1, texelFractionalX, g2), texelFractionalY, SIMDLerpAVX2(g3, texelFractionalX, g4));
+		__m256 blendB = SIMDLerpAVX2(SIMDLerpAVX2(b1, texelFractionalX, b2), texelFractionalY, SIMDLerpAVX2(b3, texelFractionalX, b4));
+		__m256 blendA = SIMDLerpAVX2(SIMDLerpAVX2(a1, texelFractionalX, a2), texelFractionalY, SIMDLerpAVX2(a3, texelFractionalX, a4));
+		blendR        = _mm256_mul_ps(blendR, colorR_8x);
+		blendG        = _mm256_mul_ps(blendG, colorG_8x);
+		blendB        = _mm256_mul_ps(blendB, colorB_8x);
+		blendA        = _mm256_mul_ps(blendA, colorA_8x);
+
+		////////////////////////////////////////////////////////////////////////
+		// Blend, PreAlphaMulColor + (1 - Alpha) * Src, see DTRRenderBlendMode
+		////////////////////////////////////////////////////////////////////////
+		__m256 destR = blendR;
+		__m256 destG = blendG;
+		__m256 destB = blendB;
+		if (!blendOpaque)
+		{
+			// Pixel Format: XX RR GG BB
+			__m256i srcPixel = _mm256_loadu_si256((__m256i *)(pixelRow + x));
+			__m256 srcR = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(srcPixel, 16), MASK_FF_8X)), INV255_8X);
+			__m256 srcG = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(srcPixel, 8), MASK_FF_8X)), INV255_8X);
+			__m256 srcB = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(srcPixel, MASK_FF_8X)), INV255_8X);
+
+			__m256 invA = (blendAdditive) ? ONE_8X : _mm256_sub_ps(ONE_8X, blendA);
+			destR      = _mm256_add_ps(blendR, _mm256_mul_ps(invA, _mm256_mul_ps(srcR, srcR)));
+			destG      = _mm256_add_ps(blendG, _mm256_mul_ps(invA, _mm256_mul_ps(srcG, srcG)));
+			destB      = _mm256_add_ps(blendB, _mm256_mul_ps(invA, _mm256_mul_ps(srcB, srcB)));
+		}
+
+		destR = _mm256_min_ps(_mm256_mul_ps(_mm256_sqrt_ps(destR), MAX_255_8X), MAX_255_8X);
+		destG = _mm256_min_ps(_mm256_mul_ps(_mm256_sqrt_ps(destG), MAX_255_8X), MAX_255_8X);
+		destB = _mm256_min_ps(_mm256_mul_ps(_mm256_sqrt_ps(destB), MAX_255_8X), MAX_255_8X);
+
+		__m256i destPixel = _mm256_or_si256(_mm256_slli_epi32(_mm256_cvttps_epi32(destR), 16),
+		                                    _mm256_or_si256(_mm256_slli_epi32(_mm256_cvttps_epi32(destG), 8),
+		                                                    _mm256_cvttps_epi32(destB)));
+		_mm256_storeu_si256((__m256i *)(pixelRow + x), destPixel);
+	}
+
+	return x;
+}
+
+FILE_SCOPE void BitmapRowsInternal(DTRRenderContext context, const RenderQuadSetup *const quad,
+                                   const i32 startY, const i32 endY)
+{
+	QuadSpanEdges edges = QuadSpanEdgesInternal(&quad->rectPoints, startY);
+	for (i32 bufferY = startY; bufferY < endY; bufferY++)
+	{
+		i32 spanMinX, spanMaxX;
+		if (!QuadSpanNextRowInternal(&edges, bufferY, quad->min.x, quad->max.x, &spanMinX, &spanMaxX))
+			continue;
+
+		// NOTE: The SIMD spans draw in groups of pixels, the remainder is drawn a pixel at a time
+		i32 bufferX = spanMinX;
+		if (globalDTRPlatformFlags.canUseAVX2) bufferX = SIMDBitmapSpanAVX2(context, quad, bufferY, bufferX, spanMaxX);
+		if (globalDTRPlatformFlags.canUseSSE2) bufferX = SIMDBitmapSpan(context, quad, bufferY, bufferX, spanMaxX);
+
+		for (; bufferX < spanMaxX; bufferX++)
+			BitmapPixelInternal(context, quad, bufferX, bufferY);
+	}
+}
+
 void DTRRender_Bitmap(DTRRenderContext context, DTRBitmap *const bitmap, DqnV2 pos,
                       const DTRRenderTransform transform, DqnV4 color)
 {
@@ -1615,8 +4234,7 @@ void DTRRender_Bitmap(DTRRenderContext context, DTRBitmap *const bitmap, DqnV2 p
 	min            = bounds.min;
 	max            = bounds.max;
 
-	color = DTRRender_SRGB1ToLinearSpaceV4(color);
-	color = PreMultiplyAlpha1(color);
+	color = DrawColorToLinearInternal(context, color);
 	DQN_ASSERT(color.a >= 0 && color.a <= 1.0f);
 	DQN_ASSERT(color.r >= 0 && color.r <= 1.0f);
 	DQN_ASSERT(color.g >= 0 && color.g <= 1.0f);
@@ -1634,183 +4252,591 @@ void DTRRender_Bitmap(DTRRenderContext context, DTRBitmap *const bitmap, DqnV2 p
 	////////////////////////////////////////////////////////////////////////////
 	// Setup Texture Mapping
 	////////////////////////////////////////////////////////////////////////////
-	const i32 pitch      = bitmap->dim.w * bitmap->bytesPerPixel;
-	u8 *const bitmapPtr  = (u8 *)bitmap->memory;
-
 	const DqnV2 rectBasis       = pList[RectPointsIndex_Basis];
 	const DqnV2 xAxisRelToBasis = pList[RectPointsIndex_XAxis] - rectBasis;
 	const DqnV2 yAxisRelToBasis = pList[RectPointsIndex_YAxis] - rectBasis;
 
-	const f32 invXAxisLenSq = 1 / DqnV2_LengthSquared(DqnV2_1f(0), xAxisRelToBasis);
-	const f32 invYAxisLenSq = 1 / DqnV2_LengthSquared(DqnV2_1f(0), yAxisRelToBasis);
-	for (i32 y = 0; y < (i32)clippedSize.h; y++)
-	{
-		const i32 bufferY = (i32)clippedDrawRect.min.y + y;
-		for (i32 x = 0; x < (i32)clippedSize.w; x++)
-		{
-			const i32 bufferX = (i32)clippedDrawRect.min.x + x;
+	RenderQuadSetup quad = {};
+	quad.rectPoints      = rectPoints;
+	quad.min             = DqnV2i_2i((i32)clippedDrawRect.min.x, (i32)clippedDrawRect.min.y);
+	quad.max             = DqnV2i_2i(quad.min.x + (i32)clippedSize.w, quad.min.y + (i32)clippedSize.h);
+	quad.color           = color;
+	quad.bitmap          = bitmap;
+	quad.rectBasis       = rectBasis;
+	quad.xAxisRelToBasis = xAxisRelToBasis;
+	quad.yAxisRelToBasis = yAxisRelToBasis;
+	quad.invXAxisLenSq   = 1 / DqnV2_LengthSquared(DqnV2_1f(0), xAxisRelToBasis);
+	quad.invYAxisLenSq   = 1 / DqnV2_LengthSquared(DqnV2_1f(0), yAxisRelToBasis);
+	DrawQuadRowsInternal(context, &quad, BitmapRowsInternal);
 
-			bool bufXYIsInside = true;
-			for (i32 pIndex = 0; pIndex < RECT_PLIST_SIZE; pIndex++)
-			{
-				DqnV2 origin = pList[pIndex];
-				DqnV2 axis   = pList[(pIndex + 1) % RECT_PLIST_SIZE] - origin;
-				DqnV2 testP  = DqnV2_2i(bufferX, bufferY)            - origin;
+	////////////////////////////////////////////////////////////////////////////
+	// Debug
+	////////////////////////////////////////////////////////////////////////////
+	{
+		bool drawBoundingBox   = true;
+		bool drawBasis         = true;
+		bool drawVertexMarkers = true;
 
-				f32 dot = DqnV2_Dot(testP, axis);
-				if (dot < 0)
-				{
-					bufXYIsInside = false;
-					break;
-				}
-			}
+		DebugRenderMarkers(context, pList, RECT_PLIST_SIZE, transform, drawBoundingBox,
+		                   drawBasis, drawVertexMarkers);
+	}
+}
 
-			if (bufXYIsInside)
-			{
-				DTR_DEBUG_EP_TIMED_BLOCK("DTRRender_Bitmap TexelCalculation");
-				DqnV2 bufPRelToBasis = DqnV2_2i(bufferX, bufferY) - rectBasis;
+////////////////////////////////////////////////////////////////////////////////
+// Clear
+////////////////////////////////////////////////////////////////////////////////
+// NOTE: A multiple of DTRRENDER_DEPTH_BLOCK_SIZE so every band owns whole rows of depth blocks
+#define RENDER_CLEAR_ROWS_PER_JOB (DTRRENDER_DEPTH_BLOCK_SIZE * 8)
 
-				f32 u = DqnV2_Dot(bufPRelToBasis, xAxisRelToBasis) * invXAxisLenSq;
-				f32 v = DqnV2_Dot(bufPRelToBasis, yAxisRelToBasis) * invYAxisLenSq;
-				u     = DqnMath_Clampf(u, 0.0f, 1.0f);
-				v     = DqnMath_Clampf(v, 0.0f, 1.0f);
+// Fill size bytes at dest with the 4 byte pattern repeated, i.e. byte (address % 4) of pattern is
+// written to each address. So dest must be 4 byte aligned unless every byte of pattern is the same.
+FILE_SCOPE void FillPatternInternal(u8 *dest, const size_t size, const u32 pattern,
+                                    const bool nonTemporal)
+{
+	u8 *const end = dest + size;
+	for (; dest < end && ((uintptr_t)dest & 15); dest++)
+		*dest = (u8)(pattern >> (((uintptr_t)dest & 3) * 8));
 
-				f32 texelXf = u * (f32)(bitmap->dim.w - 1);
-				f32 texelYf = v * (f32)(bitmap->dim.h - 1);
-				DQN_ASSERT(texelXf >= 0 && texelXf < bitmap->dim.w);
-				DQN_ASSERT(texelYf >= 0 && texelYf < bitmap->dim.h);
+	if (globalDTRPlatformFlags.canUseSSE2)
+	{
+		const __m128i value = _mm_set1_epi32((i32)pattern);
+		if (nonTemporal)
+		{
+			// NOTE: Streamed stores bypass the cache, the fence orders them before the job completes
+			for (; (dest + 64) <= end; dest += 64)
+			{
+				_mm_stream_si128((__m128i *)dest + 0, value);
+				_mm_stream_si128((__m128i *)dest + 1, value);
+				_mm_stream_si128((__m128i *)dest + 2, value);
+				_mm_stream_si128((__m128i *)dest + 3, value);
+			}
+			_mm_sfence();
+		}
+		else
+		{
+			for (; (dest + 64) <= end; dest += 64)
+			{
+				_mm_store_si128((__m128i *)dest + 0, value);
+				_mm_store_si128((__m128i *)dest + 1, value);
+				_mm_store_si128((__m128i *)dest + 2, value);
+				_mm_store_si128((__m128i *)dest + 3, value);
+			}
+		}
 
-				i32 texelX           = (i32)texelXf;
-				i32 texelY           = (i32)texelYf;
-				f32 texelFractionalX = texelXf - texelX;
-				f32 texelFractionalY = texelYf - texelY;
+		for (; (dest + 16) <= end; dest += 16)
+			_mm_store_si128((__m128i *)dest, value);
+	}
 
-				i32 texel1X = texelX;
-				i32 texel1Y = texelY;
+	for (; (dest + 4) <= end; dest += 4)
+		*(u32 *)dest = pattern;
 
-				i32 texel2X = DQN_MIN((texelX + 1), bitmap->dim.w - 1);
-				i32 texel2Y = texelY;
+	for (; dest < end; dest++)
+		*dest = (u8)(pattern >> (((uintptr_t)dest & 3) * 8));
+}
 
-				i32 texel3X = texelX;
-				i32 texel3Y = DQN_MIN((texelY + 1), bitmap->dim.h - 1);
+typedef struct RenderClearJob
+{
+	DTRRenderBuffer *renderBuffer;
+	u32              flags;
+	u32              pixel;
+	i32              startY;
+	i32              endY;
+} RenderClearJob;
+
+// Clear the rows [startY, endY) of the planes in flags, see DTRRenderClearFlag
+FILE_SCOPE void ClearRowsInternal(DTRRenderBuffer *const renderBuffer, const u32 flags,
+                                  const u32 pixel, const i32 startY, const i32 endY)
+{
+	const bool nonTemporal = (flags & DTRRenderClearFlag_NonTemporal);
+	const i32 width        = renderBuffer->width;
+	const i32 numRows      = endY - startY;
 
-				i32 texel4X = DQN_MIN((texelX + 1), bitmap->dim.w - 1);
-				i32 texel4Y = DQN_MIN((texelY + 1), bitmap->dim.h - 1);
+	if (flags & DTRRenderClearFlag_Color)
+	{
+		DQN_ASSERT(renderBuffer->bytesPerPixel == sizeof(u32));
+		u8 *const memory = (u8 *)renderBuffer->memory + (startY * width * sizeof(u32));
+		FillPatternInternal(memory, numRows * width * sizeof(u32), pixel, nonTemporal);
+	}
 
-				{
-					DTR_DEBUG_EP_TIMED_BLOCK("DTRRender_Bitmap TexelBilinearInterpolation");
-					u32 texel1  = *(u32 *)(bitmapPtr + ((texel1X * bitmap->bytesPerPixel) + (texel1Y * pitch)));
-					u32 texel2  = *(u32 *)(bitmapPtr + ((texel2X * bitmap->bytesPerPixel) + (texel2Y * pitch)));
-					u32 texel3  = *(u32 *)(bitmapPtr + ((texel3X * bitmap->bytesPerPixel) + (texel3Y * pitch)));
-					u32 texel4  = *(u32 *)(bitmapPtr + ((texel4X * bitmap->bytesPerPixel) + (texel4Y * pitch)));
-
-					DqnV4 color1;
-					color1.a = (f32)(texel1 >> 24);
-					color1.b = (f32)((texel1 >> 16) & 0xFF);
-					color1.g = (f32)((texel1 >> 8) & 0xFF);
-					color1.r = (f32)((texel1 >> 0) & 0xFF);
-
-					DqnV4 color2;
-					color2.a = (f32)(texel2 >> 24);
-					color2.b = (f32)((texel2 >> 16) & 0xFF);
-					color2.g = (f32)((texel2 >> 8) & 0xFF);
-					color2.r = (f32)((texel2 >> 0) & 0xFF);
-
-					DqnV4 color3;
-					color3.a = (f32)(texel3 >> 24);
-					color3.b = (f32)((texel3 >> 16) & 0xFF);
-					color3.g = (f32)((texel3 >> 8) & 0xFF);
-					color3.r = (f32)((texel3 >> 0) & 0xFF);
-
-					DqnV4 color4;
-					color4.a = (f32)(texel4 >> 24);
-					color4.b = (f32)((texel4 >> 16) & 0xFF);
-					color4.g = (f32)((texel4 >> 8) & 0xFF);
-					color4.r = (f32)((texel4 >> 0) & 0xFF);
-
-					color1 *= DTRRENDER_INV_255;
-					color2 *= DTRRENDER_INV_255;
-					color3 *= DTRRENDER_INV_255;
-					color4 *= DTRRENDER_INV_255;
-
-					color1 = DTRRender_SRGB1ToLinearSpaceV4(color1);
-					color2 = DTRRender_SRGB1ToLinearSpaceV4(color2);
-					color3 = DTRRender_SRGB1ToLinearSpaceV4(color3);
-					color4 = DTRRender_SRGB1ToLinearSpaceV4(color4);
-
-					DqnV4 color12;
-					color12.a = DqnMath_Lerp(color1.a, texelFractionalX, color2.a);
-					color12.b = DqnMath_Lerp(color1.b, texelFractionalX, color2.b);
-					color12.g = DqnMath_Lerp(color1.g, texelFractionalX, color2.g);
-					color12.r = DqnMath_Lerp(color1.r, texelFractionalX, color2.r);
-
-					DqnV4 color34;
-					color34.a = DqnMath_Lerp(color3.a, texelFractionalX, color4.a);
-					color34.b = DqnMath_Lerp(color3.b, texelFractionalX, color4.b);
-					color34.g = DqnMath_Lerp(color3.g, texelFractionalX, color4.g);
-					color34.r = DqnMath_Lerp(color3.r, texelFractionalX, color4.r);
-
-					DqnV4 blend;
-					blend.a = DqnMath_Lerp(color12.a, texelFractionalY, color34.a);
-					blend.b = DqnMath_Lerp(color12.b, texelFractionalY, color34.b);
-					blend.g = DqnMath_Lerp(color12.g, texelFractionalY, color34.g);
-					blend.r = DqnMath_Lerp(color12.r, texelFractionalY, color34.r);
-
-					DQN_ASSERT(blend.a >= 0 && blend.a <= 1.0f);
-					DQN_ASSERT(blend.r >= 0 && blend.r <= 1.0f);
-					DQN_ASSERT(blend.g >= 0 && blend.g <= 1.0f);
-					DQN_ASSERT(blend.b >= 0 && blend.b <= 1.0f);
-
-					// TODO(doyle): Color modulation does not work!!! By supplying
-					// colors [0->1] it'll reduce some of the coverage of a channel
-					// and once alpha blending is applied that reduced coverage will
-					// blend with the background and cause the bitmap to go
-					// transparent when it shouldn't.
-					blend.a *= color.a;
-					blend.r *= color.r;
-					blend.g *= color.g;
-					blend.b *= color.b;
-
-					SetPixel(context, bufferX, bufferY, blend, ColorSpace_Linear);
-				}
-			}
+	if (flags & DTRRenderClearFlag_Depth)
+	{
+		const i32 depthBytes = DTRRender_DepthBytesPerPixel(renderBuffer->depthFormat);
+		u8 *const zBuffer    = (u8 *)renderBuffer->zBuffer + (startY * width * depthBytes);
+		FillPatternInternal(zBuffer, numRows * width * depthBytes,
+		                    DepthClearBitsInternal(renderBuffer->depthFormat), nonTemporal);
+
+		// NOTE: min == max == the cleared depth, so each block is 2 of the same u32
+		const u32 depthBits = DepthClearBitsInternal(DTRRenderDepthFormat_F32);
+		if (renderBuffer->zBufferBlocks)
+		{
+			const i32 blockPitch  = DTRRender_DepthBlockPitch(renderBuffer);
+			const i32 startBlockY = startY / DTRRENDER_DEPTH_BLOCK_SIZE;
+			const i32 endBlockY   = (endY + DTRRENDER_DEPTH_BLOCK_SIZE - 1) / DTRRENDER_DEPTH_BLOCK_SIZE;
+			u8 *const blocks      = (u8 *)(renderBuffer->zBufferBlocks + (startBlockY * blockPitch));
+			FillPatternInternal(blocks, (endBlockY - startBlockY) * blockPitch * sizeof(DTRRenderDepthBlock),
+			                    depthBits, nonTemporal);
 		}
 	}
 
-	////////////////////////////////////////////////////////////////////////////
-	// Debug
-	////////////////////////////////////////////////////////////////////////////
+	if ((flags & DTRRenderClearFlag_Locks) && renderBuffer->pixelLockTable)
 	{
-		bool drawBoundingBox   = true;
-		bool drawBasis         = true;
-		bool drawVertexMarkers = true;
+		u8 *const locks = (u8 *)(renderBuffer->pixelLockTable + (startY * width));
+		FillPatternInternal(locks, numRows * width * sizeof(bool), 0, nonTemporal);
+	}
+}
 
-		DebugRenderMarkers(context, pList, RECT_PLIST_SIZE, transform, drawBoundingBox,
-		                   drawBasis, drawVertexMarkers);
+void MultiThreadedClearRows(PlatformJobQueue *const queue, void *const userData)
+{
+	if (!queue || !userData)
+	{
+		DQN_ASSERT(DQN_INVALID_CODE_PATH);
+		return;
 	}
+
+	RenderClearJob *job = (RenderClearJob *)userData;
+	ClearRowsInternal(job->renderBuffer, job->flags, job->pixel, job->startY, job->endY);
 }
 
-void DTRRender_Clear(DTRRenderContext context, DqnV3 color)
+void DTRRender_Clear(DTRRenderContext context, DqnV3 color, const u32 flags)
 {
 	DTRRenderBuffer *renderBuffer = context.renderBuffer;
 	if (!renderBuffer) return;
+	DTR_DEBUG_EP_TIMED_FUNCTION();
 
 	DQN_ASSERT(color.r >= 0.0f && color.r <= 1.0f);
 	DQN_ASSERT(color.g >= 0.0f && color.g <= 1.0f);
 	DQN_ASSERT(color.b >= 0.0f && color.b <= 1.0f);
 	color *= 255.0f;
 
-	u32 *const bitmapPtr = (u32 *)renderBuffer->memory;
-	for (i32 y = 0; y < renderBuffer->height; y++)
+	u32 pixel = ((i32)0       << 24) |
+	            ((i32)color.r << 16) |
+	            ((i32)color.g << 8)  |
+	            ((i32)color.b << 0);
+
+	// NOTE: Stamped depth is cleared by advancing the stamp, the blocks are cleared when next touched
+	u32 rowFlags = flags;
+	if ((rowFlags & DTRRenderClearFlag_Depth) && renderBuffer->zBufferBlockStamps)
+	{
+		rowFlags &= ~DTRRenderClearFlag_Depth;
+		renderBuffer->depthStamp++;
+
+		// NOTE: On wrap around, reset the stamps so no block from 2^32 clears ago reads as current
+		if (renderBuffer->depthStamp == DEPTH_BLOCK_STAMP_CLEARING)
+		{
+			FillPatternInternal((u8 *)renderBuffer->zBufferBlockStamps,
+			                    DTRRender_DepthBlockCount(renderBuffer) * sizeof(u32), 0, false);
+			renderBuffer->depthStamp = 1;
+		}
+	}
+
+	if ((rowFlags & ~DTRRenderClearFlag_NonTemporal) == 0) return;
+
+	const i32 numJobs = (renderBuffer->height + RENDER_CLEAR_ROWS_PER_JOB - 1) / RENDER_CLEAR_ROWS_PER_JOB;
+	if (!context.multithread || !context.jobQueue || numJobs <= 1)
+	{
+		ClearRowsInternal(renderBuffer, rowFlags, pixel, 0, renderBuffer->height);
+		return;
+	}
+
+	bool regionValid;
+	auto tempRegion = DqnMemStackTempRegionGuard(context.tempStack, &regionValid);
+	RenderClearJob *jobDataList = (regionValid) ? (RenderClearJob *)DqnMemStack_Push(context.tempStack, sizeof(*jobDataList) * numJobs) : NULL;
+	PlatformJob *jobList        = (regionValid) ? (PlatformJob *)DqnMemStack_Push(context.tempStack, sizeof(*jobList) * numJobs) : NULL;
+	if (!jobDataList || !jobList)
+	{
+		ClearRowsInternal(renderBuffer, rowFlags, pixel, 0, renderBuffer->height);
+		return;
+	}
+
+	for (i32 i = 0; i < numJobs; i++)
+	{
+		RenderClearJob *jobData = &jobDataList[i];
+		jobData->renderBuffer   = renderBuffer;
+		jobData->flags          = rowFlags;
+		jobData->pixel          = pixel;
+		jobData->startY         = i * RENDER_CLEAR_ROWS_PER_JOB;
+		jobData->endY           = DQN_MIN(jobData->startY + RENDER_CLEAR_ROWS_PER_JOB, renderBuffer->height);
+
+		jobList[i].callback = MultiThreadedClearRows;
+		jobList[i].userData = jobData;
+	}
+
+	Platform_QueueAddAllJobs(context.api, context.jobQueue, jobList, numJobs);
+	context.api->QueueWaitAllJobsComplete(context.jobQueue);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Render Commands
+////////////////////////////////////////////////////////////////////////////////
+enum RenderCommandType
+{
+	RenderCommandType_Clear,
+	RenderCommandType_Text,
+	RenderCommandType_Rectangle,
+	RenderCommandType_Bitmap,
+	RenderCommandType_Triangle,
+	RenderCommandType_Mesh,
+};
+
+typedef struct DTRRenderCommand
+{
+	enum RenderCommandType  type;
+	enum DTRRenderCullMode  cullMode;
+	enum DTRRenderBlendMode blendMode;
+	DTRRenderTransform      transform;
+	DqnV4                   color;
+
+	// 3D commands only. The nearest z of a triangle, or the screen space z of a mesh's position.
+	f32        sortDepth;
+	DTRBitmap *texture; // Also the bitmap of bitmap commands
+
+	union
 	{
-		for (i32 x = 0; x < renderBuffer->width; x++)
+		struct { u32 flags;                                            } clear;
+		struct { DTRFont font; DqnV2 pos; const char *string; i32 len; } text;
+		struct { DqnV2 min, max;                                       } rect;
+		struct { DqnV2 pos;                                            } bitmap;
+		struct { DqnV3 p1, p2, p3; DqnV2 uv1, uv2, uv3;                } triangle;
+		struct { DTRMesh *mesh; DTRRenderLight lighting; DqnV3 pos;    } mesh;
+	};
+} DTRRenderCommand;
+
+bool DTRRender_BeginCommands(DTRRenderCommandBuffer *const buffer, DqnMemStack *const stack,
+                             const u32 maxCommands)
+{
+	if (!buffer || !stack) return false;
+
+	buffer->stack       = stack;
+	buffer->commandList = (DTRRenderCommand *)DqnMemStack_Push(stack, sizeof(*buffer->commandList) * maxCommands);
+	buffer->numCommands = 0;
+	buffer->maxCommands = (buffer->commandList) ? maxCommands : 0;
+	return (buffer->commandList != NULL);
+}
+
+// Returns the next command of the buffer with the context's draw state, or NULL if it's full.
+FILE_SCOPE DTRRenderCommand *PushCommandInternal(DTRRenderCommandBuffer *const buffer,
+                                                 const DTRRenderContext context,
+                                                 const enum RenderCommandType type,
+                                                 const DTRRenderTransform transform,
+                                                 const DqnV4 color)
+{
+	if (!buffer || buffer->numCommands >= buffer->maxCommands) return NULL;
+
+	DTRRenderCommand *result = buffer->commandList + buffer->numCommands++;
+	DqnMem_Clear(result, 0, sizeof(*result));
+	result->type      = type;
+	result->cullMode  = context.cullMode;
+	result->blendMode = context.blendMode;
+	result->transform = transform;
+	result->color     = color;
+	return result;
+}
+
+bool DTRRender_PushText(DTRRenderCommandBuffer *const buffer, DTRRenderContext context,
+                        const DTRFont font, DqnV2 pos, const char *const text, DqnV4 color, i32 len)
+{
+	if (!buffer || !text) return false;
+	if (len == -1) len = DqnStr_Len(text);
+
+	// NOTE: The text is copied since the caller's string may not live until the submit
+	char *string = (char *)DqnMemStack_Push(buffer->stack, sizeof(*string) * (len + 1));
+	if (!string) return false;
+	for (i32 i = 0; i < len; i++)
+		string[i] = text[i];
+	string[len] = 0;
+
+	DTRRenderCommand *command = PushCommandInternal(buffer, context, RenderCommandType_Text,
+	                                                DTRRender_DefaultTransform(), color);
+	if (!command) return false;
+
+	command->text.font   = font;
+	command->text.pos    = pos;
+	command->text.string = string;
+	command->text.len    = len;
+	return true;
+}
+
+bool DTRRender_PushRectangle(DTRRenderCommandBuffer *const buffer, DTRRenderContext context,
+                             DqnV2 min, DqnV2 max, DqnV4 color, const DTRRenderTransform transform)
+{
+	DTRRenderCommand *command =
+	    PushCommandInternal(buffer, context, RenderCommandType_Rectangle, transform, color);
+	if (!command) return false;
+
+	command->rect.min = min;
+	command->rect.max = max;
+	return true;
+}
+
+bool DTRRender_PushMesh(DTRRenderCommandBuffer *const buffer, DTRRenderContext context,
+                        DTRMesh *const mesh, DTRRenderLight lighting, const DqnV3 pos,
+                        const DTRRenderTransform transform)
+{
+	if (!mesh || !context.renderBuffer) return false;
+	DTRRenderCommand *command =
+	    PushCommandInternal(buffer, context, RenderCommandType_Mesh, transform, lighting.color);
+	if (!command) return false;
+
+	DqnMat4 screenMatrix = MeshScreenMatrixInternal(context.renderBuffer, pos, transform);
+	DqnV4 screenPos      = DqnMat4_MulV4(screenMatrix, DqnV4_4f(0, 0, 0, 1));
+
+	command->sortDepth     = screenPos.z / screenPos.w;
+	command->texture       = &mesh->tex;
+	command->mesh.mesh     = mesh;
+	command->mesh.lighting = lighting;
+	command->mesh.pos      = pos;
+	return true;
+}
+
+bool DTRRender_PushTexturedTriangle(DTRRenderCommandBuffer *const buffer, DTRRenderContext context,
+                                    DqnV3 p1, DqnV3 p2, DqnV3 p3, DqnV2 uv1, DqnV2 uv2, DqnV2 uv3,
+                                    DTRBitmap *const texture, DqnV4 color,
+                                    const DTRRenderTransform transform)
+{
+	DTRRenderCommand *command =
+	    PushCommandInternal(buffer, context, RenderCommandType_Triangle, transform, color);
+	if (!command) return false;
+
+	command->sortDepth    = DQN_MAX(DQN_MAX(p1.z, p2.z), p3.z);
+	command->texture      = texture;
+	command->triangle.p1  = p1;
+	command->triangle.p2  = p2;
+	command->triangle.p3  = p3;
+	command->triangle.uv1 = uv1;
+	command->triangle.uv2 = uv2;
+	command->triangle.uv3 = uv3;
+	return true;
+}
+
+bool DTRRender_PushTriangle(DTRRenderCommandBuffer *const buffer, DTRRenderContext context,
+                            DqnV3 p1, DqnV3 p2, DqnV3 p3, DqnV4 color,
+                            const DTRRenderTransform transform)
+{
+	const DqnV2 NO_UV       = {};
+	DTRBitmap *const NO_TEX = NULL;
+	bool result = DTRRender_PushTexturedTriangle(buffer, context, p1, p2, p3, NO_UV, NO_UV, NO_UV,
+	                                             NO_TEX, color, transform);
+	return result;
+}
+
+bool DTRRender_PushBitmap(DTRRenderCommandBuffer *const buffer, DTRRenderContext context,
+                          DTRBitmap *const bitmap, DqnV2 pos, const DTRRenderTransform transform,
+                          DqnV4 color)
+{
+	if (!bitmap) return false;
+	DTRRenderCommand *command =
+	    PushCommandInternal(buffer, context, RenderCommandType_Bitmap, transform, color);
+	if (!command) return false;
+
+	command->texture    = bitmap;
+	command->bitmap.pos = pos;
+	return true;
+}
+
+bool DTRRender_PushClear(DTRRenderCommandBuffer *const buffer, DTRRenderContext context,
+                         DqnV3 color, const u32 flags)
+{
+	DTRRenderCommand *command = PushCommandInternal(
+	    buffer, context, RenderCommandType_Clear, DTRRender_DefaultTransform(), DqnV4_V3(color, 1));
+	if (!command) return false;
+
+	command->clear.flags = flags;
+	return true;
+}
+
+// True if a must execute before b in a run of 3D commands. Opaque commands execute first, front to
+// back so the depth blocks reject what's behind them, then grouped by texture. Blended commands
+// execute back to front. Ties keep the order they were pushed in.
+FILE_SCOPE inline bool RenderCommandSortsBeforeInternal(const DTRRenderCommand *const a,
+                                                        const DTRRenderCommand *const b)
+{
+	const bool aOpaque = (a->blendMode == DTRRenderBlendMode_Opaque);
+	const bool bOpaque = (b->blendMode == DTRRenderBlendMode_Opaque);
+	if (aOpaque != bOpaque) return aOpaque;
+
+	// NOTE: Greater depth is nearer
+	if (a->sortDepth != b->sortDepth)
+		return (aOpaque) ? (a->sortDepth > b->sortDepth) : (a->sortDepth < b->sortDepth);
+
+	if (aOpaque && a->texture != b->texture) return ((uintptr_t)a->texture < (uintptr_t)b->texture);
+	return false;
+}
+
+// Stable bottom up merge sort of the list, swapList must have numCommands entries. Returns whichever
+// of the 2 lists holds the sorted result.
+FILE_SCOPE const DTRRenderCommand **SortRenderCommandsInternal(const DTRRenderCommand **list,
+                                                               const DTRRenderCommand **swapList,
+                                                               const u32 numCommands)
+{
+	for (u32 width = 1; width < numCommands; width *= 2)
+	{
+		for (u32 start = 0; start < numCommands; start += (width * 2))
 		{
-			u32 pixel = ((i32)0       << 24) |
-			            ((i32)color.r << 16) |
-			            ((i32)color.g << 8)  |
-			            ((i32)color.b << 0);
-			bitmapPtr[x + (y * renderBuffer->width)] = pixel;
+			const u32 mid = DQN_MIN(start + width, numCommands);
+			const u32 end = DQN_MIN(start + (width * 2), numCommands);
+
+			u32 left  = start;
+			u32 right = mid;
+			u32 out   = start;
+			while (left < mid && right < end)
+			{
+				if (RenderCommandSortsBeforeInternal(list[right], list[left]))
+					swapList[out++] = list[right++];
+				else
+					swapList[out++] = list[left++];
+			}
+
+			while (left < mid)  swapList[out++] = list[left++];
+			while (right < end) swapList[out++] = list[right++];
 		}
+
+		DQN_SWAP(const DTRRenderCommand **, list, swapList);
 	}
+
+	return list;
 }
 
+FILE_SCOPE inline bool RenderCommandIs3DInternal(const DTRRenderCommand *const command)
+{
+	bool result = (command->type == RenderCommandType_Triangle ||
+	               command->type == RenderCommandType_Mesh);
+	return result;
+}
+
+// Sort a run of 3D commands and setup all their triangles into 1 list, so the whole run is binned
+// and rasterised in screen tiles together instead of a command at a time.
+FILE_SCOPE void ExecuteTriangleCommandsInternal(DTRRenderContext context,
+                                                const DTRRenderCommand *const commandList,
+                                                const u32 numCommands)
+{
+	DqnMemStack *const tempStack = context.tempStack;
+	DTR_DEBUG_EP_TIMED_FUNCTION();
+
+	u32 maxTris = 0;
+	for (u32 i = 0; i < numCommands; i++)
+	{
+		const DTRRenderCommand *command = commandList + i;
+		maxTris += (command->type == RenderCommandType_Mesh) ? command->mesh.mesh->numFaces : 1;
+	}
+
+	bool regionValid;
+	auto tempRegion = DqnMemStackTempRegionGuard(tempStack, &regionValid);
+	const DTRRenderCommand **sortList = (regionValid) ? (const DTRRenderCommand **)DqnMemStack_Push(tempStack, sizeof(*sortList) * numCommands) : NULL;
+	const DTRRenderCommand **swapList = (regionValid) ? (const DTRRenderCommand **)DqnMemStack_Push(tempStack, sizeof(*swapList) * numCommands) : NULL;
+	RenderTriangleSetup *triList      = (regionValid) ? (RenderTriangleSetup *)DqnMemStack_Push(tempStack, sizeof(*triList) * maxTris) : NULL;
+	if (!sortList || !swapList || !triList)
+	{
+		// TODO(doyle): Allocation error
+		DQN_ASSERT(DQN_INVALID_CODE_PATH);
+		return;
+	}
+
+	for (u32 i = 0; i < numCommands; i++)
+		sortList[i] = commandList + i;
+	sortList = SortRenderCommandsInternal(sortList, swapList, numCommands);
+
+	////////////////////////////////////////////////////////////////////////////
+	// Setup triangles in sorted order
+	////////////////////////////////////////////////////////////////////////////
+	u32 numTris = 0;
+	for (u32 i = 0; i < numCommands; i++)
+	{
+		const DTRRenderCommand *command  = sortList[i];
+		DTRRenderContext commandContext = context;
+		commandContext.cullMode         = command->cullMode;
+		commandContext.blendMode        = command->blendMode;
+
+		if (command->type == RenderCommandType_Mesh)
+		{
+			DTRMesh *const mesh = command->mesh.mesh;
+			if (!SetupMeshTrianglesInternal(commandContext, mesh, command->mesh.lighting,
+			                                command->mesh.pos, command->transform, triList + numTris))
+			{
+				// TODO(doyle): Allocation error
+				DQN_ASSERT(DQN_INVALID_CODE_PATH);
+				return;
+			}
+			numTris += mesh->numFaces;
+		}
+		else
+		{
+			triList[numTris++] = SetupTriangleInternal(
+			    commandContext, NullRenderLightInternal(), command->triangle.p1,
+			    command->triangle.p2, command->triangle.p3, command->triangle.uv1,
+			    command->triangle.uv2, command->triangle.uv3, command->texture, command->color,
+			    command->transform);
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////
+	// Rasterise
+	////////////////////////////////////////////////////////////////////////////
+	if (context.multithread && context.jobQueue)
+	{
+		RenderTrianglesInTiles(context, triList, numTris);
+	}
+	else
+	{
+		const bool LOCK_PIXELS = false;
+		for (u32 i = 0; i < numTris; i++)
+			RasteriseTriangleInternal(context, triList + i, triList[i].min, triList[i].max, LOCK_PIXELS);
+	}
+}
+
+void DTRRender_SubmitCommands(DTRRenderContext context, const DTRRenderCommandBuffer *const buffer)
+{
+	if (!buffer || !context.renderBuffer || !context.tempStack) return;
+	DTR_DEBUG_EP_TIMED_FUNCTION();
+
+	u32 index = 0;
+	while (index < buffer->numCommands)
+	{
+		const DTRRenderCommand *command = buffer->commandList + index;
+		if (RenderCommandIs3DInternal(command))
+		{
+			u32 runEnd = index + 1;
+			while (runEnd < buffer->numCommands && RenderCommandIs3DInternal(buffer->commandList + runEnd))
+				runEnd++;
+
+			ExecuteTriangleCommandsInternal(context, command, runEnd - index);
+			index = runEnd;
+			continue;
+		}
+
+		DTRRenderContext commandContext = context;
+		commandContext.cullMode         = command->cullMode;
+		commandContext.blendMode        = command->blendMode;
+		switch (command->type)
+		{
+			case RenderCommandType_Clear:
+			{
+				DTRRender_Clear(commandContext, command->color.rgb, command->clear.flags);
+			}
+			break;
+
+			case RenderCommandType_Text:
+			{
+				DTRRender_Text(commandContext, command->text.font, command->text.pos,
+				               command->text.string, command->color, command->text.len);
+			}
+			break;
+
+			case RenderCommandType_Rectangle:
+			{
+				DTRRender_Rectangle(commandContext, command->rect.min, command->rect.max,
+				                    command->color, command->transform);
+			}
+			break;
+
+			case RenderCommandType_Bitmap:
+			{
+				DTRRender_Bitmap(commandContext, command->texture, command->bitmap.pos,
+				                 command->transform, command->color);
+			}
+			break;
+
+			default: DQN_ASSERT(DQN_INVALID_CODE_PATH); break;
+		}
+		index++;
+	}
+}
@@ -4,13 +4,35 @@
 #include "dqn.h"
 #include "DTRendererPlatform.h"
 
-#define DTRRENDER_INV_255 1.0f/255.0f
+#define DTRRENDER_INV_255   (1.0f / 255.0f)
+#define DTRRENDER_INV_65535 (1.0f / 65535.0f)
 
 typedef struct DTRBitmap DTRBitmap;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Utility
 ////////////////////////////////////////////////////////////////////////////////////////////////////
+// The zBuffer is also summarised in blocks of DTRRENDER_DEPTH_BLOCK_SIZE^2 pixels. Min is a lower
+// bound and max an upper bound of the depths in the block, which lets the rasteriser reject a block
+// of pixels, or skip the per-pixel depth test, with one compare.
+#define DTRRENDER_DEPTH_BLOCK_SIZE 8
+typedef struct DTRRenderDepthBlock
+{
+	f32 min;
+	f32 max;
+} DTRRenderDepthBlock;
+
+// Depth is mapped into [0, DTRRENDER_DEPTH_RANGE] by the viewport, where greater is nearer. The
+// unorm formats quantise depths in this range and clamp those outside of it. A stored unorm of 0 is
+// reserved for cleared, so depths are stored biased by 1 and every depth passes against a clear.
+#define DTRRENDER_DEPTH_RANGE 255.0f
+enum DTRRenderDepthFormat
+{
+	DTRRenderDepthFormat_F32,     // f32 per pixel, cleared to DQN_F32_MIN
+	DTRRenderDepthFormat_Unorm16, // u16 per pixel
+	DTRRenderDepthFormat_Unorm24, // u32 per pixel, the top 8 bits are always 0
+};
+
 typedef struct DTRRenderBuffer
 {
 	i32 width;
@@ -18,12 +40,78 @@ typedef struct DTRRenderBuffer
 	i32 bytesPerPixel;
 	PlatformLock *renderLock;
 	volatile u8  *memory;     // Format: XX RR GG BB, and has (width * height * bytesPerPixels) elements
-	volatile f32 *zBuffer;    // zBuffer has (width * height) elements
+	volatile void *zBuffer;   // zBuffer has (width * height) elements of depthFormat
+	enum DTRRenderDepthFormat depthFormat;
+
+	// Optional, has (DTRRender_DepthBlockPitch() * ceil(height / DTRRENDER_DEPTH_BLOCK_SIZE))
+	// elements. Must be cleared with the zBuffer, i.e. min = max = the cleared depth.
+	DTRRenderDepthBlock *zBufferBlocks;
 
-	volatile bool *pixelLockTable; // has (width * height) elements
+	// Optional, has DTRRender_DepthBlockCount() elements. When set, clearing the depth only
+	// advances depthStamp and the zBuffer must persist between frames. A block whose stamp isn't
+	// depthStamp reads as cleared, its pixels are cleared the first time a triangle touches it.
+	volatile u32 *zBufferBlockStamps;
+	u32           depthStamp;
+
+	// Has (width * height) elements. Only used by multithreaded immediate mode triangles, meshes
+	// are rasterised in screen tiles that own their pixels and don't need to lock.
+	volatile bool *pixelLockTable;
 
 } DTRRenderBuffer;
 
+inline i32 DTRRender_DepthBlockPitch(const DTRRenderBuffer *const renderBuffer)
+{
+	i32 result = (renderBuffer->width + DTRRENDER_DEPTH_BLOCK_SIZE - 1) / DTRRENDER_DEPTH_BLOCK_SIZE;
+	return result;
+}
+
+inline i32 DTRRender_DepthBlockCount(const DTRRenderBuffer *const renderBuffer)
+{
+	i32 numBlockRows = (renderBuffer->height + DTRRENDER_DEPTH_BLOCK_SIZE - 1) / DTRRENDER_DEPTH_BLOCK_SIZE;
+	i32 result       = DTRRender_DepthBlockPitch(renderBuffer) * numBlockRows;
+	return result;
+}
+
+inline i32 DTRRender_DepthBytesPerPixel(const enum DTRRenderDepthFormat format)
+{
+	i32 result = (format == DTRRenderDepthFormat_Unorm16) ? sizeof(u16) : sizeof(u32);
+	return result;
+}
+
+// Largest stored value of the unorm formats, 0 for f32.
+inline u32 DTRRender_DepthUnormMax(const enum DTRRenderDepthFormat format)
+{
+	u32 result = 0;
+	if      (format == DTRRenderDepthFormat_Unorm16) result = 0xFFFF;
+	else if (format == DTRRenderDepthFormat_Unorm24) result = 0xFFFFFF;
+	return result;
+}
+
+// Read back the depth at index of the zBuffer, cleared unorm depths read as DQN_F32_MIN.
+inline f32 DTRRender_GetDepth(const DTRRenderBuffer *const renderBuffer, const i32 index)
+{
+	if (renderBuffer->depthFormat == DTRRenderDepthFormat_F32)
+		return ((volatile f32 *)renderBuffer->zBuffer)[index];
+
+	u32 value = (renderBuffer->depthFormat == DTRRenderDepthFormat_Unorm16)
+	                ? ((volatile u16 *)renderBuffer->zBuffer)[index]
+	                : ((volatile u32 *)renderBuffer->zBuffer)[index];
+	if (value == 0) return DQN_F32_MIN;
+
+	const u32 unormMax = DTRRender_DepthUnormMax(renderBuffer->depthFormat);
+	f32 result         = (f32)(value - 1) * (DTRRENDER_DEPTH_RANGE / (f32)(unormMax - 1));
+	return result;
+}
+
+// A stale block reads as cleared regardless of what's in the zBuffer, see zBufferBlockStamps.
+inline bool DTRRender_DepthBlockIsStale(const DTRRenderBuffer *const renderBuffer,
+                                        const i32 blockIndex)
+{
+	bool result = (renderBuffer->zBufferBlockStamps &&
+	               renderBuffer->zBufferBlockStamps[blockIndex] != renderBuffer->depthStamp);
+	return result;
+}
+
 // Using transforms for 2D ignores the 'z' element.
 typedef struct DTRRenderTransform
 {
@@ -57,6 +145,12 @@ inline DqnV4 DTRRender_LinearToSRGB1SpaceV4(DqnV4 color);
 // color back in SRGB space.
 inline DqnV4 DTRRender_PreMultiplyAlphaSRGB1WithLinearConversion(DqnV4 color);
 
+// Lookup tables for converting 8 bit SRGB [0->255] to linear [0->1] and back. The tables must be
+// built with DTRRender_InitColorTables() before any conversion, subsequent calls are no-ops.
+void         DTRRender_InitColorTables();
+inline f32   DTRRender_SRGB255ToLinear1(const u32 val);
+inline u32   DTRRender_Linear1ToSRGB255(const f32 val);
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Rendering
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -76,6 +170,27 @@ typedef struct DTRRenderLight
 	DqnV4 color;
 } DTRRenderLight;
 
+// Triangles with zero area or entirely off screen are always culled, the cull mode additionally
+// culls triangles by their winding in screen space, i.e. after projection and transforms with y up
+// the render buffer. Meshes flip the winding if they're DTRMesh::clockwise, so Back always culls
+// the faces showing the inside of a mesh and doesn't change the image of a closed mesh.
+enum DTRRenderCullMode
+{
+	DTRRenderCullMode_None,
+	DTRRenderCullMode_Back,  // Cull clockwise triangles, i.e. the inside of counter clockwise meshes
+	DTRRenderCullMode_Front, // Cull counter clockwise triangles
+};
+
+// How a draw call combines its color with the render buffer, blending happens in linear space.
+// Colors passed to draw calls are straight alpha unless the mode is PreMultiplied.
+enum DTRRenderBlendMode
+{
+	DTRRenderBlendMode_Alpha,         // dest = (srcA * src) + ((1 - srcA) * dest)
+	DTRRenderBlendMode_PreMultiplied, // dest = src + ((1 - srcA) * dest), src already multiplied by srcA, i.e. DTRRender_PreMultiplyAlphaSRGB1WithLinearConversion()
+	DTRRenderBlendMode_Additive,      // dest = (srcA * src) + dest
+	DTRRenderBlendMode_Opaque,        // dest = src, for opaque geometry, the render buffer is never read
+};
+
 typedef struct DTRRenderContext
 {
 	DTRRenderBuffer  *renderBuffer;
@@ -83,9 +198,24 @@ typedef struct DTRRenderContext
 	PlatformAPI      *api;
 	PlatformJobQueue *jobQueue;
 
-	bool multithread;
+	bool                    multithread;
+	enum DTRRenderCullMode  cullMode;
+	enum DTRRenderBlendMode blendMode;
 } DTRRenderContext;
 
+// Planes of the render buffer for DTRRender_Clear() to clear. Depth clears the zBuffer to
+// DQN_F32_MIN along with the zBufferBlocks, lazily if the buffer has zBufferBlockStamps.
+// NonTemporal streams the stores past the cache, which is only worth it when the buffer is too big
+// to still be in cache by the time it's drawn to.
+enum DTRRenderClearFlag
+{
+	DTRRenderClearFlag_Color       = (1 << 0),
+	DTRRenderClearFlag_Depth       = (1 << 1),
+	DTRRenderClearFlag_Locks       = (1 << 2),
+	DTRRenderClearFlag_NonTemporal = (1 << 3),
+	DTRRenderClearFlag_All         = DTRRenderClearFlag_Color | DTRRenderClearFlag_Depth | DTRRenderClearFlag_Locks,
+};
+
 // NOTE: All colors should be in the range of [0->1] where DqnV4 is a struct with 4 floats, rgba
 // Leaving len = -1 for text will make the system use strlen to determine len.
 void DTRRender_Text            (DTRRenderContext context, const DTRFont font, DqnV2 pos, const char *const text, DqnV4 color = DqnV4_1f(1), i32 len = -1);
@@ -95,6 +225,36 @@ void DTRRender_Mesh            (DTRRenderContext context, PlatformJobQueue *cons
 void DTRRender_Triangle        (DTRRenderContext context, DqnV3 p1, DqnV3 p2, DqnV3 p3, DqnV4 color, const DTRRenderTransform transform = DTRRender_DefaultTriangleTransform());
 void DTRRender_TexturedTriangle(DTRRenderContext context, DqnV3 p1, DqnV3 p2, DqnV3 p3, DqnV2 uv1, DqnV2 uv2, DqnV2 uv3, DTRBitmap *const texture, DqnV4 color, const DTRRenderTransform transform = DTRRender_DefaultTriangleTransform());
 void DTRRender_Bitmap          (DTRRenderContext context, DTRBitmap *const bitmap, DqnV2 pos, const DTRRenderTransform transform = DTRRender_DefaultTransform(), DqnV4 color = DqnV4_4f(1, 1, 1, 1));
-void DTRRender_Clear           (DTRRenderContext context, DqnV3 color);
+void DTRRender_Clear           (DTRRenderContext context, DqnV3 color, const u32 flags = DTRRenderClearFlag_Color);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Render Commands
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Draws pushed to a command buffer are deferred until DTRRender_SubmitCommands(), every command
+// keeps the cull and blend mode of the context it was pushed with. On submit, each run of
+// consecutive 3D commands (triangles and meshes) is sorted, opaque front to back grouped by texture
+// then blended back to front, and rasterised together in screen tiles on the context's jobQueue.
+// Clears and 2D commands don't depth test, so they execute in the order they were pushed.
+//
+// Commands and copies of their text are pushed onto the buffer's stack, which must outlive the
+// submit. Pushes return false if the buffer is full or the stack is out of memory.
+typedef struct DTRRenderCommand DTRRenderCommand;
+typedef struct DTRRenderCommandBuffer
+{
+	DqnMemStack      *stack;
+	DTRRenderCommand *commandList;
+	u32               numCommands;
+	u32               maxCommands;
+} DTRRenderCommandBuffer;
+
+bool DTRRender_BeginCommands       (DTRRenderCommandBuffer *const buffer, DqnMemStack *const stack, const u32 maxCommands);
+bool DTRRender_PushText            (DTRRenderCommandBuffer *const buffer, DTRRenderContext context, const DTRFont font, DqnV2 pos, const char *const text, DqnV4 color = DqnV4_1f(1), i32 len = -1);
+bool DTRRender_PushRectangle       (DTRRenderCommandBuffer *const buffer, DTRRenderContext context, DqnV2 min, DqnV2 max, DqnV4 color, const DTRRenderTransform transform = DTRRender_DefaultTransform());
+bool DTRRender_PushMesh            (DTRRenderCommandBuffer *const buffer, DTRRenderContext context, DTRMesh *const mesh, DTRRenderLight lighting, const DqnV3 pos, const DTRRenderTransform transform);
+bool DTRRender_PushTriangle        (DTRRenderCommandBuffer *const buffer, DTRRenderContext context, DqnV3 p1, DqnV3 p2, DqnV3 p3, DqnV4 color, const DTRRenderTransform transform = DTRRender_DefaultTriangleTransform());
+bool DTRRender_PushTexturedTriangle(DTRRenderCommandBuffer *const buffer, DTRRenderContext context, DqnV3 p1, DqnV3 p2, DqnV3 p3, DqnV2 uv1, DqnV2 uv2, DqnV2 uv3, DTRBitmap *const texture, DqnV4 color, const DTRRenderTransform transform = DTRRender_DefaultTriangleTransform());
+bool DTRRender_PushBitmap          (DTRRenderCommandBuffer *const buffer, DTRRenderContext context, DTRBitmap *const bitmap, DqnV2 pos, const DTRRenderTransform transform = DTRRender_DefaultTransform(), DqnV4 color = DqnV4_4f(1, 1, 1, 1));
+bool DTRRender_PushClear           (DTRRenderCommandBuffer *const buffer, DTRRenderContext context, DqnV3 color, const u32 flags = DTRRenderClearFlag_Color);
+void DTRRender_SubmitCommands      (DTRRenderContext context, const DTRRenderCommandBuffer *const buffer);
 
 #endif
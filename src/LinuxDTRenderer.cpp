@@ -0,0 +1,711 @@
+#include "DTRenderer.h"
+#include "DTRendererPlatform.h"
+
+#define DQN_UNIX_IMPLEMENTATION
+#define DQN_IMPLEMENTATION
+#include "dqn.h"
+
+#include <dlfcn.h>        // dlopen(), dlsym()
+#include <fcntl.h>        // open()
+#include <linux/futex.h>  // FUTEX_WAIT_PRIVATE, FUTEX_WAKE_PRIVATE
+#include <pthread.h>
+#include <sys/mman.h>     // mmap(), munmap()
+#include <sys/stat.h>     // fstat()
+#include <sys/syscall.h>  // SYS_futex
+#include <unistd.h>       // sysconf(), readlink(), syscall(), close()
+
+// NOTE: LinuxDTRenderer is a headless platform layer. There is no window, the renderer draws into
+// an in-memory PlatformRenderBuffer for a fixed number of frames and can optionally write the final
+// frame out to disk. It exists so that we can run DTR_Update in batch on machines without a display.
+
+FILE_SCOPE PlatformMemory globalPlatformMemory;
+FILE_SCOPE bool           globalRunning;
+
+void Platform_DieGracefully() { globalRunning = false; }
+
+////////////////////////////////////////////////////////////////////////////////
+// Platform Atomics
+////////////////////////////////////////////////////////////////////////////////
+u32 Platform_AtomicCompareSwap(u32 volatile *dest, u32 swapVal, u32 compareVal)
+{
+	u32 result = __sync_val_compare_and_swap(dest, compareVal, swapVal);
+	return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Linux Futex
+////////////////////////////////////////////////////////////////////////////////
+// Sleep the calling thread for as long as *addr is equal to expectedVal.
+FILE_SCOPE inline void LinuxFutexWait(u32 volatile *addr, u32 expectedVal)
+{
+	syscall(SYS_futex, (u32 *)addr, FUTEX_WAIT_PRIVATE, expectedVal, NULL, NULL, 0);
+}
+
+FILE_SCOPE inline void LinuxFutexWake(u32 volatile *addr, i32 numThreadsToWake)
+{
+	syscall(SYS_futex, (u32 *)addr, FUTEX_WAKE_PRIVATE, numThreadsToWake, NULL, NULL, 0);
+}
+
+// NOTE: Counting semaphore built on a futex, mirroring the Win32 semaphore semantics we use in
+// Win32DTRenderer, i.e. count is capped at maxCount and release only enters the kernel if there is
+// a thread that may be sleeping on it. Release wakes as many threads as it adds to the count.
+typedef struct LinuxSemaphore
+{
+	u32 volatile count;
+	u32 volatile numWaiters;
+	u32          maxCount;
+} LinuxSemaphore;
+
+FILE_SCOPE void LinuxSemaphoreRelease(LinuxSemaphore *const semaphore, const u32 releaseCount)
+{
+	u32 numReleased = 0;
+	for (;;)
+	{
+		u32 count    = semaphore->count;
+		u32 newCount = DQN_MIN(count + releaseCount, semaphore->maxCount);
+		if (newCount == count) return;
+		if (__sync_val_compare_and_swap(&semaphore->count, count, newCount) == count)
+		{
+			numReleased = newCount - count;
+			break;
+		}
+	}
+
+	if (semaphore->numWaiters > 0) LinuxFutexWake(&semaphore->count, (i32)numReleased);
+}
+
+FILE_SCOPE void LinuxSemaphoreWait(LinuxSemaphore *const semaphore)
+{
+	for (;;)
+	{
+		u32 count = semaphore->count;
+		if (count > 0)
+		{
+			if (__sync_val_compare_and_swap(&semaphore->count, count, count - 1) == count) return;
+			continue;
+		}
+
+		__sync_fetch_and_add(&semaphore->numWaiters, 1);
+		LinuxFutexWait(&semaphore->count, 0);
+		__sync_fetch_and_sub(&semaphore->numWaiters, 1);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Platform Mutex/Lock
+////////////////////////////////////////////////////////////////////////////////
+typedef struct PlatformLock
+{
+	pthread_mutex_t mutex;
+} PlatformLock;
+
+PlatformLock *Platform_LockInit(DqnMemStack *const stack)
+{
+	PlatformLock *result = (PlatformLock *)DqnMemStack_Push(stack, sizeof(PlatformLock));
+	if (result)
+	{
+		if (pthread_mutex_init(&result->mutex, NULL) != 0)
+		{
+			DqnMemStack_Pop(stack, result, sizeof(PlatformLock));
+			return NULL;
+		}
+		else
+		{
+			return result;
+		}
+	}
+	return NULL;
+}
+
+void Platform_LockAcquire(PlatformLock *const lock) { pthread_mutex_lock(&lock->mutex); }
+void Platform_LockRelease(PlatformLock *const lock) { pthread_mutex_unlock(&lock->mutex); }
+void Platform_LockDelete (PlatformLock *const lock) { pthread_mutex_destroy(&lock->mutex); }
+
+////////////////////////////////////////////////////////////////////////////////
+// Platform Multi Threading
+////////////////////////////////////////////////////////////////////////////////
+// NOTE: Every thread, the main thread included, owns a ring of jobs. Jobs are only added by the
+// main thread which deals them out round-robin across the rings. Threads take jobs from the front of
+// their own ring and steal from the front of the other rings once theirs is empty, so threads only
+// contend on the same index whilst stealing.
+typedef struct LinuxJobRing
+{
+	PlatformJob *jobList;
+	u32          size;
+
+	// NOTE: Modified by main+worker threads
+	u32 volatile jobToExecuteIndex;
+
+	// NOTE: Modified by main thread ONLY
+	u32 volatile jobInsertIndex;
+	u32          pendingInsertIndex; // Jobs written but not yet published by jobInsertIndex
+
+	// NOTE: Rings are kept on separate cache lines otherwise threads taking jobs from their own ring
+	// still contend with each other.
+	u8 padding[64 - sizeof(PlatformJob *) - (4 * sizeof(u32))];
+} LinuxJobRing;
+
+struct PlatformJobQueue
+{
+	LinuxJobRing *ringList; // One per thread, ring 0 belongs to the main thread
+	u32           numRings;
+
+	// NOTE: Modified by main+worker threads
+	LinuxSemaphore semaphore;
+	u32 volatile   numJobsToComplete;
+	u32 volatile   numCompleteWaiters;
+
+	// NOTE: Modified by main thread ONLY
+	u32 nextRingIndex;
+};
+
+typedef struct LinuxThreadParam
+{
+	PlatformJobQueue *queue;
+	u32               ringIndex;
+} LinuxThreadParam;
+
+// NOTE: The ring owned by the calling thread, stays 0 for the main thread
+FILE_SCOPE __thread u32 globalThreadRingIndex;
+
+FILE_SCOPE bool LinuxJobRingTake(LinuxJobRing *const ring, PlatformJob *const job)
+{
+	for (;;)
+	{
+		u32 originalJobToExecute = ring->jobToExecuteIndex;
+		if (originalJobToExecute == ring->jobInsertIndex) return false;
+
+		// NOTE: Read the job before claiming it, once claimed the main thread may overwrite the slot.
+		*job = ring->jobList[originalJobToExecute];
+		u32 newJobIndexForNextThread = (originalJobToExecute + 1) % ring->size;
+		if (__sync_val_compare_and_swap(&ring->jobToExecuteIndex, originalJobToExecute,
+		                                newJobIndexForNextThread) == originalJobToExecute)
+		{
+			return true;
+		}
+	}
+}
+
+u32 Platform_QueueAddJobs(PlatformJobQueue *const queue, const PlatformJob *const jobs,
+                          const u32 numJobs)
+{
+	// NOTE: Count the jobs before they're visible, otherwise they could complete and underflow the
+	// count.
+	__sync_fetch_and_add(&queue->numJobsToComplete, numJobs);
+
+	// NOTE: Deal the jobs out round-robin until every ring is full
+	u32 numAdded     = 0;
+	u32 numFullRings = 0;
+	while (numAdded < numJobs && numFullRings < queue->numRings)
+	{
+		LinuxJobRing *ring   = &queue->ringList[queue->nextRingIndex];
+		queue->nextRingIndex = (queue->nextRingIndex + 1) % queue->numRings;
+
+		u32 newJobInsertIndex = (ring->pendingInsertIndex + 1) % ring->size;
+		if (newJobInsertIndex == ring->jobToExecuteIndex)
+		{
+			numFullRings++;
+			continue;
+		}
+
+		ring->jobList[ring->pendingInsertIndex] = jobs[numAdded++];
+		ring->pendingInsertIndex                = newJobInsertIndex;
+		numFullRings                            = 0;
+	}
+
+	// NOTE: The jobs must be visible to worker threads before the insert indexes that publish them.
+	__sync_synchronize();
+	for (u32 i = 0; i < queue->numRings; i++)
+		queue->ringList[i].jobInsertIndex = queue->ringList[i].pendingInsertIndex;
+
+	if (numAdded < numJobs) __sync_fetch_and_sub(&queue->numJobsToComplete, numJobs - numAdded);
+	if (numAdded > 0) LinuxSemaphoreRelease(&queue->semaphore, numAdded);
+	return numAdded;
+}
+
+bool Platform_QueueAddJob(PlatformJobQueue *const queue, const PlatformJob job)
+{
+	bool result = (Platform_QueueAddJobs(queue, &job, 1) == 1);
+	return result;
+}
+
+bool Platform_QueueTryExecuteNextJob(PlatformJobQueue *const queue)
+{
+	for (u32 i = 0; i < queue->numRings; i++)
+	{
+		LinuxJobRing *ring = &queue->ringList[(globalThreadRingIndex + i) % queue->numRings];
+		PlatformJob job;
+		if (LinuxJobRingTake(ring, &job))
+		{
+			job.callback(queue, job.userData);
+			if (__sync_sub_and_fetch(&queue->numJobsToComplete, 1) == 0 &&
+			    queue->numCompleteWaiters > 0)
+			{
+				LinuxFutexWake(&queue->numJobsToComplete, INT32_MAX);
+			}
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool Platform_QueueAllJobsComplete(PlatformJobQueue *const queue)
+{
+	bool result = (queue->numJobsToComplete == 0);
+	return result;
+}
+
+void Platform_QueueWaitAllJobsComplete(PlatformJobQueue *const queue)
+{
+	while (Platform_QueueTryExecuteNextJob(queue))
+		;
+
+	// NOTE: Nothing left to take, the remaining jobs are in flight on other threads. Sleep until the
+	// last one completes instead of spinning on the count.
+	__sync_fetch_and_add(&queue->numCompleteWaiters, 1);
+	for (;;)
+	{
+		u32 numJobsToComplete = queue->numJobsToComplete;
+		if (numJobsToComplete == 0) break;
+		LinuxFutexWait(&queue->numJobsToComplete, numJobsToComplete);
+	}
+	__sync_fetch_and_sub(&queue->numCompleteWaiters, 1);
+}
+
+FILE_SCOPE void *LinuxThreadCallback(void *threadParam)
+{
+	LinuxThreadParam *param = (LinuxThreadParam *)threadParam;
+	globalThreadRingIndex   = param->ringIndex;
+
+	PlatformJobQueue *queue = param->queue;
+	for (;;)
+	{
+		if (!Platform_QueueTryExecuteNextJob(queue))
+		{
+			LinuxSemaphoreWait(&queue->semaphore);
+		}
+	}
+
+	return NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Platform I/O
+////////////////////////////////////////////////////////////////////////////////
+FILE_SCOPE inline PlatformFile DqnFileToPlatformFileInternal(const DqnFile file)
+{
+	PlatformFile result    = {};
+	result.handle          = file.handle;
+	result.size            = file.size;
+	result.permissionFlags = file.permissionFlags;
+
+	return result;
+}
+
+FILE_SCOPE inline DqnFile PlatformFileToDqnFileInternal(const PlatformFile file)
+{
+	DqnFile result = {};
+	result.handle          = file.handle;
+	result.size            = file.size;
+	result.permissionFlags = file.permissionFlags;
+
+	return result;
+}
+
+void Platform_Print(const char *const string)
+{
+	if (!string) return;
+	fputs(string, stderr);
+}
+
+bool Platform_FileOpen(const char *const path, PlatformFile *const file, const u32 permissionFlags,
+                       const enum PlatformFileAction fileAction)
+{
+	if (!path || !file) return false;
+	DQN_ASSERT((permissionFlags &
+	            ~(PlatformFilePermissionFlag_Write |
+	              PlatformFilePermissionFlag_Read)) == 0);
+
+	DQN_ASSERT((fileAction &
+	            ~(PlatformFileAction_OpenOnly | PlatformFileAction_CreateIfNotExist |
+	              PlatformFileAction_ClearIfExist)) == 0);
+
+	DqnFile dqnFile = {};
+	if (DqnFile_Open(path, &dqnFile, permissionFlags, (enum DqnFileAction)fileAction))
+	{
+		*file = DqnFileToPlatformFileInternal(dqnFile);
+		return true;
+	}
+
+	return false;
+}
+
+size_t Platform_FileRead(PlatformFile *const file, u8 *const buf,
+                         const size_t bytesToRead)
+{
+	if (!file || !buf) return 0;
+
+	DqnFile dqnFile     = PlatformFileToDqnFileInternal(*file);
+	size_t numBytesRead = DqnFile_Read(&dqnFile, buf, bytesToRead);
+
+	return numBytesRead;
+}
+
+size_t Platform_FileWrite(PlatformFile *const file, u8 *const buf,
+                         const size_t numBytesToWrite)
+{
+	if (!file || !buf) return 0;
+
+	DqnFile dqnFile     = PlatformFileToDqnFileInternal(*file);
+	size_t numBytesRead = DqnFile_Write(&dqnFile, buf, numBytesToWrite, 0);
+	return numBytesRead;
+}
+
+void Platform_FileClose(PlatformFile *const file)
+{
+	if (!file) return;
+
+	DqnFile dqnFile = PlatformFileToDqnFileInternal(*file);
+	DqnFile_Close(&dqnFile);
+}
+
+bool Platform_FileMap(const char *const path, PlatformFileMap *const map)
+{
+	if (!path || !map) return false;
+
+	i32 fd = open(path, O_RDONLY);
+	if (fd == -1) return false;
+
+	bool result          = false;
+	struct stat fileStat = {};
+	if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
+	{
+		// NOTE: MAP_PRIVATE makes writes copy on write, they never reach the file
+		void *memory = mmap(NULL, (size_t)fileStat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+		if (memory != MAP_FAILED)
+		{
+			map->memory = (u8 *)memory;
+			map->size   = (size_t)fileStat.st_size;
+			result      = true;
+		}
+	}
+
+	// NOTE: The mapping keeps the file alive, the descriptor isn't needed anymore
+	close(fd);
+	return result;
+}
+
+void Platform_FileUnmap(PlatformFileMap *const map)
+{
+	if (!map || !map->memory) return;
+
+	munmap(map->memory, map->size);
+	map->memory = NULL;
+	map->size   = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Linux Layer
+////////////////////////////////////////////////////////////////////////////////
+const char *const SO_NAME = "dtrenderer.so";
+
+typedef struct LinuxExternalCode
+{
+	void               *so;
+	DTR_UpdateFunction *DTR_Update;
+} LinuxExternalCode;
+
+FILE_SCOPE LinuxExternalCode LinuxLoadExternalSO(const char *const path)
+{
+	LinuxExternalCode result = {};
+	result.so                = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+	if (result.so)
+	{
+		DTR_UpdateFunction *updateFunction = (DTR_UpdateFunction *)dlsym(result.so, "DTR_Update");
+		if (updateFunction) result.DTR_Update = updateFunction;
+	}
+	else
+	{
+		fprintf(stderr, "dlopen() failed: %s\n", dlerror());
+	}
+
+	return result;
+}
+
+// Get the full path of the current executable and return the char offset in the string to the
+// last forward slash, i.e. the directory. Returns -1 if buf was not large enough.
+FILE_SCOPE i32 LinuxGetEXEDirectory(char *const buf, const u32 bufLen)
+{
+	ssize_t len = readlink("/proc/self/exe", buf, bufLen - 1);
+	if (len <= 0 || len >= (ssize_t)(bufLen - 1)) return -1;
+	buf[len] = 0;
+
+	i32 lastSlashIndex = -1;
+	for (i32 i = 0; i < (i32)len; i++)
+	{
+		if (buf[i] == '/') lastSlashIndex = i;
+	}
+
+	return lastSlashIndex;
+}
+
+// Write the render buffer out as a binary PPM (P6). The render buffer is bottom-up with pixel
+// format XX RR GG BB, PPM is top-down RGB.
+FILE_SCOPE bool LinuxWriteRenderBufferToPPM(const PlatformRenderBuffer *const renderBuffer,
+                                            const char *const path)
+{
+	FILE *handle = fopen(path, "wb");
+	if (!handle) return false;
+
+	fprintf(handle, "P6\n%d %d\n255\n", renderBuffer->width, renderBuffer->height);
+
+	const u32 *const pixels = (u32 *)renderBuffer->memory;
+	u8 *rowBuffer           = (u8 *)DqnMem_Alloc(renderBuffer->width * 3);
+	if (!rowBuffer)
+	{
+		fclose(handle);
+		return false;
+	}
+
+	for (i32 y = renderBuffer->height - 1; y >= 0; y--)
+	{
+		const u32 *const row = pixels + (y * renderBuffer->width);
+		for (i32 x = 0; x < renderBuffer->width; x++)
+		{
+			u32 pixel            = row[x];
+			rowBuffer[x * 3 + 0] = (u8)((pixel >> 16) & 0xFF);
+			rowBuffer[x * 3 + 1] = (u8)((pixel >> 8) & 0xFF);
+			rowBuffer[x * 3 + 2] = (u8)((pixel >> 0) & 0xFF);
+		}
+		fwrite(rowBuffer, 3, renderBuffer->width, handle);
+	}
+
+	DqnMem_Free(rowBuffer);
+	fclose(handle);
+	return true;
+}
+
+FILE_SCOPE void LinuxPrintUsage(const char *const exeName)
+{
+	fprintf(stderr,
+	        "Usage: %s [-frames <num>] [-width <px>] [-height <px>] [-output <file.ppm>]\n",
+	        exeName);
+}
+
+int main(int argc, char **argv)
+{
+	////////////////////////////////////////////////////////////////////////////
+	// Parse Command Line
+	////////////////////////////////////////////////////////////////////////////
+	i32 numFrames          = 1;
+	i32 width              = 800;
+	i32 height             = 800;
+	const char *outputPath = NULL;
+	for (i32 i = 1; i < argc; i++)
+	{
+		const char *const arg = argv[i];
+		if (i + 1 >= argc)
+		{
+			LinuxPrintUsage(argv[0]);
+			return -1;
+		}
+
+		const char *const value = argv[++i];
+		if (DqnStr_Cmp(arg, "-frames") == 0)
+		{
+			numFrames = (i32)Dqn_StrToI64(value, DqnStr_Len(value));
+		}
+		else if (DqnStr_Cmp(arg, "-width") == 0)
+		{
+			width = (i32)Dqn_StrToI64(value, DqnStr_Len(value));
+		}
+		else if (DqnStr_Cmp(arg, "-height") == 0)
+		{
+			height = (i32)Dqn_StrToI64(value, DqnStr_Len(value));
+		}
+		else if (DqnStr_Cmp(arg, "-output") == 0)
+		{
+			outputPath = value;
+		}
+		else
+		{
+			LinuxPrintUsage(argv[0]);
+			return -1;
+		}
+	}
+
+	if (numFrames <= 0 || width <= 0 || height <= 0)
+	{
+		LinuxPrintUsage(argv[0]);
+		return -1;
+	}
+
+	////////////////////////////////////////////////////////////////////////////
+	// Initialise Render Buffer
+	////////////////////////////////////////////////////////////////////////////
+	PlatformRenderBuffer platformBuffer = {};
+	platformBuffer.width                = width;
+	platformBuffer.height               = height;
+	platformBuffer.bytesPerPixel        = 4;
+	platformBuffer.memory =
+	    DqnMem_Calloc(platformBuffer.width * platformBuffer.height * platformBuffer.bytesPerPixel);
+	if (!platformBuffer.memory)
+	{
+		fprintf(stderr, "Unable to allocate %dx%d render buffer\n", width, height);
+		return -1;
+	}
+
+	////////////////////////////////////////////////////////////////////////////
+	// Make SO Path
+	////////////////////////////////////////////////////////////////////////////
+	LinuxExternalCode soCode = {};
+	{
+		char exeDir[1024]  = {};
+		char soPath[1024]  = {};
+		i32 lastSlashIndex = LinuxGetEXEDirectory(exeDir, DQN_ARRAY_COUNT(exeDir));
+		if (!DQN_ASSERT_MSG(lastSlashIndex != -1, "Not enough space in buffer for exe path"))
+			return -1;
+
+		exeDir[lastSlashIndex + 1] = 0;
+		u32 soNumCopied            = Dqn_sprintf(soPath, "%s%s", exeDir, SO_NAME);
+		if (!DQN_ASSERT_MSG(soNumCopied < DQN_ARRAY_COUNT(soPath), "Out of space to form SO path"))
+			return -1;
+
+		soCode = LinuxLoadExternalSO(soPath);
+		if (!soCode.DTR_Update) return -1;
+	}
+
+	////////////////////////////////////////////////////////////////////////////
+	// Platform Data Pre-amble
+	////////////////////////////////////////////////////////////////////////////
+	bool memoryInitResult =
+	    DqnMemStack_Init(&globalPlatformMemory.mainStack, DQN_MEGABYTE(4), true, 4) |
+	    DqnMemStack_Init(&globalPlatformMemory.tempStack, DQN_MEGABYTE(4), true, 4) |
+	    DqnMemStack_Init(&globalPlatformMemory.assetStack, DQN_MEGABYTE(4), true, 4);
+	if (!DQN_ASSERT_MSG(memoryInitResult, "Unable to allocate DTRenderer globalPlatformMemory stacks"))
+	{
+		return -1;
+	}
+
+	PlatformAPI platformAPI   = {};
+	platformAPI.DieGracefully = Platform_DieGracefully;
+
+	platformAPI.FileOpen  = Platform_FileOpen;
+	platformAPI.FileRead  = Platform_FileRead;
+	platformAPI.FileWrite = Platform_FileWrite;
+	platformAPI.FileClose = Platform_FileClose;
+	platformAPI.FileMap   = Platform_FileMap;
+	platformAPI.FileUnmap = Platform_FileUnmap;
+	platformAPI.Print     = Platform_Print;
+
+	platformAPI.QueueAddJob              = Platform_QueueAddJob;
+	platformAPI.QueueAddJobs             = Platform_QueueAddJobs;
+	platformAPI.QueueTryExecuteNextJob   = Platform_QueueTryExecuteNextJob;
+	platformAPI.QueueAllJobsComplete     = Platform_QueueAllJobsComplete;
+	platformAPI.QueueWaitAllJobsComplete = Platform_QueueWaitAllJobsComplete;
+
+	platformAPI.AtomicCompareSwap = Platform_AtomicCompareSwap;
+
+	platformAPI.LockInit    = Platform_LockInit;
+	platformAPI.LockAcquire = Platform_LockAcquire;
+	platformAPI.LockRelease = Platform_LockRelease;
+	platformAPI.LockDelete  = Platform_LockDelete;
+
+	PlatformJobQueue jobQueue = {};
+
+	PlatformInput platformInput     = {};
+	platformInput.api               = platformAPI;
+	platformInput.jobQueue          = &jobQueue;
+	platformInput.flags.canUseSSE2  = __builtin_cpu_supports("sse2");
+	platformInput.flags.canUseRdtsc = true; // NOTE: Always available on x86-64
+	platformInput.flags.canUseAVX2  = __builtin_cpu_supports("avx2");
+
+	// Threading
+	PlatformJob jobQueueMemory[1024]       = {};
+	LinuxJobRing jobRingMemory[64]         = {};
+	LinuxThreadParam threadParamMemory[64] = {};
+	{
+		////////////////////////////////////////////////////////////////////////
+		// Query CPU Cores
+		////////////////////////////////////////////////////////////////////////
+		i32 numLogicalCores = (i32)sysconf(_SC_NPROCESSORS_ONLN);
+
+		////////////////////////////////////////////////////////////////////////
+		// Threading
+		////////////////////////////////////////////////////////////////////////
+		// NOTE: (numLogicalCores - 1), 1 core is already exclusively for main thread
+		i32 availableThreads = numLogicalCores - 1;
+		if (availableThreads <= 0) availableThreads = 1;
+		availableThreads = DQN_MIN(availableThreads, (i32)DQN_ARRAY_COUNT(jobRingMemory) - 1);
+
+		// NOTE: Split the job memory evenly between the main and worker thread rings
+		jobQueue.ringList = jobRingMemory;
+		jobQueue.numRings = (u32)availableThreads + 1;
+		u32 jobsPerRing   = DQN_ARRAY_COUNT(jobQueueMemory) / jobQueue.numRings;
+		for (u32 i = 0; i < jobQueue.numRings; i++)
+		{
+			jobQueue.ringList[i].jobList = jobQueueMemory + (i * jobsPerRing);
+			jobQueue.ringList[i].size    = jobsPerRing;
+		}
+
+		jobQueue.semaphore.maxCount = (u32)availableThreads;
+		for (i32 i = 0; i < availableThreads; i++)
+		{
+			LinuxThreadParam *threadParam = &threadParamMemory[i];
+			threadParam->queue            = &jobQueue;
+			threadParam->ringIndex        = (u32)i + 1;
+
+			pthread_t thread;
+			if (pthread_create(&thread, NULL, LinuxThreadCallback, threadParam) == 0)
+			{
+				pthread_detach(thread);
+			}
+			else
+			{
+				// TODO(doyle): Thread creation failed, main thread still completes jobs.
+				fprintf(stderr, "pthread_create() failed\n");
+			}
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////
+	// Update Loop
+	////////////////////////////////////////////////////////////////////////////
+	// NOTE: Frames are stepped at a fixed rate so that batch output is deterministic regardless of
+	// how long a frame takes to render on the host.
+	const f32 TARGET_FRAMES_PER_S = 60.0f;
+	f32 targetSecondsPerFrame     = 1 / TARGET_FRAMES_PER_S;
+	f64 totalFrameTimeInS         = 0;
+	globalRunning                 = true;
+
+	platformInput.flags.executableReloaded = true;
+	for (i32 frameIndex = 0; frameIndex < numFrames && globalRunning; frameIndex++)
+	{
+		f64 startFrameTimeInS = DqnTimer_NowInS();
+
+		platformInput.timeNowInS    = frameIndex * targetSecondsPerFrame;
+		platformInput.deltaForFrame = targetSecondsPerFrame;
+		soCode.DTR_Update(&platformBuffer, &platformInput, &globalPlatformMemory);
+		platformInput.flags.executableReloaded = false;
+
+		f64 frameTimeInS = DqnTimer_NowInS() - startFrameTimeInS;
+		totalFrameTimeInS += frameTimeInS;
+		fprintf(stdout, "frame %d: %5.2f ms/f\n", frameIndex, 1000.0f * (f32)frameTimeInS);
+	}
+
+	fprintf(stdout, "average: %5.2f ms/f over %d frame(s)\n",
+	        1000.0f * (f32)(totalFrameTimeInS / numFrames), numFrames);
+
+	if (outputPath)
+	{
+		if (!LinuxWriteRenderBufferToPPM(&platformBuffer, outputPath))
+		{
+			fprintf(stderr, "Unable to write render buffer to %s\n", outputPath);
+			return -1;
+		}
+	}
+
+	return 0;
+}
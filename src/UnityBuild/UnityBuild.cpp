@@ -1,4 +1,4 @@
-#include "..\DTRendererDebug.cpp"
-#include "..\DTRendererRender.cpp"
-#include "..\DTRenderer.cpp"
-#include "..\DTRendererAsset.cpp"
+#include "../DTRendererDebug.cpp"
+#include "../DTRendererRender.cpp"
+#include "../DTRenderer.cpp"
+#include "../DTRendererAsset.cpp"
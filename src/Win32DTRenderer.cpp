@@ -62,55 +62,138 @@ void Platform_LockDelete (PlatformLock *const lock) { DqnLock_Delete(&lock->dqnL
 ////////////////////////////////////////////////////////////////////////////////
 // Platform Multi Threading
 ////////////////////////////////////////////////////////////////////////////////
-struct PlatformJobQueue
+// NOTE: Every thread, the main thread included, owns a ring of jobs. Jobs are only added by the
+// main thread which deals them out round-robin across the rings. Threads take jobs from the front of
+// their own ring and steal from the front of the other rings once theirs is empty, so threads only
+// contend on the same index whilst stealing.
+typedef struct Win32JobRing
 {
-	PlatformJob *volatile jobList;
+	PlatformJob *jobList;
 	LONG         size;
 
 	// NOTE: Modified by main+worker threads
-	LONG   volatile jobToExecuteIndex;
-	HANDLE volatile win32Semaphore;
-	LONG   volatile numJobsToComplete;
+	LONG volatile jobToExecuteIndex;
 
 	// NOTE: Modified by main thread ONLY
 	LONG volatile jobInsertIndex;
+	LONG          pendingInsertIndex; // Jobs written but not yet published by jobInsertIndex
+
+	// NOTE: Rings are kept on separate cache lines otherwise threads taking jobs from their own ring
+	// still contend with each other.
+	u8 padding[64 - sizeof(PlatformJob *) - (4 * sizeof(LONG))];
+} Win32JobRing;
+
+struct PlatformJobQueue
+{
+	Win32JobRing *ringList; // One per thread, ring 0 belongs to the main thread
+	LONG          numRings;
+
+	// NOTE: Modified by main+worker threads
+	HANDLE volatile win32Semaphore;
+	HANDLE volatile win32AllJobsCompleteEvent;
+	LONG   volatile numJobsToComplete;
+	LONG   volatile numCompleteWaiters;
 
+	// NOTE: Modified by main thread ONLY
+	LONG nextRingIndex;
 };
 
-bool Platform_QueueAddJob(PlatformJobQueue *const queue, const PlatformJob job)
+typedef struct Win32ThreadParam
 {
-	LONG newJobInsertIndex = (queue->jobInsertIndex + 1) % queue->size;
-	if (newJobInsertIndex == queue->jobToExecuteIndex) return false;
+	PlatformJobQueue *queue;
+	LONG              ringIndex;
+} Win32ThreadParam;
 
-	queue->jobList[queue->jobInsertIndex] = job;
+// NOTE: The ring owned by the calling thread, stays 0 for the main thread
+FILE_SCOPE __declspec(thread) LONG globalThreadRingIndex;
 
-	InterlockedIncrement(&queue->numJobsToComplete);
-	ReleaseSemaphore(queue->win32Semaphore, 1, NULL);
-	queue->jobInsertIndex = newJobInsertIndex;
-	return true;
+FILE_SCOPE bool Win32JobRingTake(Win32JobRing *const ring, PlatformJob *const job)
+{
+	for (;;)
+	{
+		LONG originalJobToExecute = ring->jobToExecuteIndex;
+		if (originalJobToExecute == ring->jobInsertIndex) return false;
+
+		// NOTE: Read the job before claiming it, once claimed the main thread may overwrite the slot.
+		*job = ring->jobList[originalJobToExecute];
+		LONG newJobIndexForNextThread = (originalJobToExecute + 1) % ring->size;
+		if (InterlockedCompareExchange(&ring->jobToExecuteIndex, newJobIndexForNextThread,
+		                               originalJobToExecute) == originalJobToExecute)
+		{
+			return true;
+		}
+	}
+}
+
+u32 Platform_QueueAddJobs(PlatformJobQueue *const queue, const PlatformJob *const jobs,
+                          const u32 numJobs)
+{
+	// NOTE: Count the jobs before they're visible, otherwise they could complete and underflow the
+	// count.
+	InterlockedExchangeAdd(&queue->numJobsToComplete, (LONG)numJobs);
+
+	// NOTE: Deal the jobs out round-robin until every ring is full
+	u32 numAdded      = 0;
+	LONG numFullRings = 0;
+	while (numAdded < numJobs && numFullRings < queue->numRings)
+	{
+		Win32JobRing *ring   = &queue->ringList[queue->nextRingIndex];
+		queue->nextRingIndex = (queue->nextRingIndex + 1) % queue->numRings;
+
+		LONG newJobInsertIndex = (ring->pendingInsertIndex + 1) % ring->size;
+		if (newJobInsertIndex == ring->jobToExecuteIndex)
+		{
+			numFullRings++;
+			continue;
+		}
+
+		ring->jobList[ring->pendingInsertIndex] = jobs[numAdded++];
+		ring->pendingInsertIndex                = newJobInsertIndex;
+		numFullRings                            = 0;
+	}
+
+	// NOTE: The jobs must be visible to worker threads before the insert indexes that publish them.
+	MemoryBarrier();
+	for (LONG i = 0; i < queue->numRings; i++)
+		queue->ringList[i].jobInsertIndex = queue->ringList[i].pendingInsertIndex;
+
+	if (numAdded < numJobs) InterlockedExchangeAdd(&queue->numJobsToComplete, -(LONG)(numJobs - numAdded));
+
+	// NOTE: Wake a worker per job, up to every worker. Releasing past the semaphore's max count fails
+	// without releasing anything, in which case release one at a time until it's full.
+	LONG releaseCount = DQN_MIN((LONG)numAdded, queue->numRings - 1);
+	if (releaseCount > 0 && !ReleaseSemaphore(queue->win32Semaphore, releaseCount, NULL))
+	{
+		while (releaseCount-- > 0 && ReleaseSemaphore(queue->win32Semaphore, 1, NULL))
+			;
+	}
+
+	return numAdded;
+}
+
+bool Platform_QueueAddJob(PlatformJobQueue *const queue, const PlatformJob job)
+{
+	bool result = (Platform_QueueAddJobs(queue, &job, 1) == 1);
+	return result;
 }
 
 bool Platform_QueueTryExecuteNextJob(PlatformJobQueue *const queue)
 {
-	LONG originalJobToExecute = queue->jobToExecuteIndex;
-	if (originalJobToExecute != queue->jobInsertIndex)
+	for (LONG i = 0; i < queue->numRings; i++)
 	{
-		LONG newJobIndexForNextThread = (originalJobToExecute + 1) % queue->size;
-		LONG index = InterlockedCompareExchange(&queue->jobToExecuteIndex, newJobIndexForNextThread,
-		                                        originalJobToExecute);
-
-		// NOTE: If we weren't successful at the interlock, another thread has
-		// taken the work and we can't know if there's more work or not. So
-		// irrespective of that result, return true to let the thread check
-		// again for more work.
-		if (index == originalJobToExecute)
+		Win32JobRing *ring = &queue->ringList[(globalThreadRingIndex + i) % queue->numRings];
+		PlatformJob job;
+		if (Win32JobRingTake(ring, &job))
 		{
-			PlatformJob job = queue->jobList[index];
 			job.callback(queue, job.userData);
-			InterlockedDecrement(&queue->numJobsToComplete);
-		}
+			if (InterlockedDecrement(&queue->numJobsToComplete) == 0 &&
+			    queue->numCompleteWaiters > 0)
+			{
+				SetEvent(queue->win32AllJobsCompleteEvent);
+			}
 
-		return true;
+			return true;
+		}
 	}
 
 	return false;
@@ -122,6 +205,20 @@ bool Platform_QueueAllJobsComplete(PlatformJobQueue *const queue)
 	return result;
 }
 
+void Platform_QueueWaitAllJobsComplete(PlatformJobQueue *const queue)
+{
+	while (Platform_QueueTryExecuteNextJob(queue))
+		;
+
+	// NOTE: Nothing left to take, the remaining jobs are in flight on other threads. Sleep until the
+	// last one completes instead of spinning on the count. The event may still be signalled from an
+	// earlier batch, in which case we just check the count again.
+	InterlockedIncrement(&queue->numCompleteWaiters);
+	while (queue->numJobsToComplete != 0)
+		WaitForSingleObjectEx(queue->win32AllJobsCompleteEvent, INFINITE, false);
+	InterlockedDecrement(&queue->numCompleteWaiters);
+}
+
 FILE_SCOPE u32  volatile globalDebugCounter;
 FILE_SCOPE bool volatile globalDebugCounterMemoize[2048];
 FILE_SCOPE PlatformLock  globalDebugLock;
@@ -140,7 +237,10 @@ FILE_SCOPE void DebugWin32IncrementCounter(PlatformJobQueue *const queue, void *
 
 DWORD WINAPI Win32ThreadCallback(void *lpParameter)
 {
-	PlatformJobQueue *queue = (PlatformJobQueue *)lpParameter;
+	Win32ThreadParam *param = (Win32ThreadParam *)lpParameter;
+	globalThreadRingIndex   = param->ringIndex;
+
+	PlatformJobQueue *queue = param->queue;
 	for (;;)
 	{
 		if (!Platform_QueueTryExecuteNextJob(queue))
@@ -231,6 +331,48 @@ void Platform_FileClose(PlatformFile *const file)
 	DqnFile_Close(&dqnFile);
 }
 
+bool Platform_FileMap(const char *const path, PlatformFileMap *const map)
+{
+	if (!path || !map) return false;
+
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+	                          FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) return false;
+
+	bool result            = false;
+	LARGE_INTEGER fileSize = {};
+	if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+	{
+		// NOTE: PAGE_WRITECOPY/FILE_MAP_COPY make writes copy on write, they never reach the file
+		HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+		if (mapping)
+		{
+			void *memory = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+			if (memory)
+			{
+				map->memory = (u8 *)memory;
+				map->size   = (size_t)fileSize.QuadPart;
+				result      = true;
+			}
+
+			// NOTE: The view keeps the mapping and file alive, the handles aren't needed anymore
+			CloseHandle(mapping);
+		}
+	}
+
+	CloseHandle(file);
+	return result;
+}
+
+void Platform_FileUnmap(PlatformFileMap *const map)
+{
+	if (!map || !map->memory) return;
+
+	UnmapViewOfFile(map->memory);
+	map->memory = NULL;
+	map->size   = 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Win32 Layer
 ////////////////////////////////////////////////////////////////////////////////
@@ -549,6 +691,25 @@ FILE_SCOPE void Win32ProcessMessages(HWND window, PlatformInput *input)
 	}
 }
 
+// NOTE: AVX2 needs support from the CPU and the OS, which must save the YMM registers on a context
+// switch. IsProcessorFeaturePresent() has no AVX2 query on older versions of Windows.
+FILE_SCOPE bool Win32CanUseAVX2()
+{
+	i32 cpuInfo[4] = {};
+	__cpuid(cpuInfo, 1);
+	bool osUsesXSave = (cpuInfo[2] & (1 << 27)) != 0;
+	bool cpuHasAVX   = (cpuInfo[2] & (1 << 28)) != 0;
+	if (!osUsesXSave || !cpuHasAVX) return false;
+
+	// XCR0 bit 1 and 2 are set if the OS saves XMM and YMM state
+	const u64 XCR0_XMM_YMM_STATE = 0x6;
+	if ((_xgetbv(0) & XCR0_XMM_YMM_STATE) != XCR0_XMM_YMM_STATE) return false;
+
+	__cpuidex(cpuInfo, 7, 0);
+	bool result = (cpuInfo[1] & (1 << 5)) != 0;
+	return result;
+}
+
 int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPWSTR lpCmdLine, int nShowCmd)
 {
 
@@ -672,11 +833,15 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPWSTR lpCmdLi
 	platformAPI.FileRead  = Platform_FileRead;
 	platformAPI.FileWrite = Platform_FileWrite;
 	platformAPI.FileClose = Platform_FileClose;
+	platformAPI.FileMap   = Platform_FileMap;
+	platformAPI.FileUnmap = Platform_FileUnmap;
 	platformAPI.Print     = Platform_Print;
 
-	platformAPI.QueueAddJob            = Platform_QueueAddJob;
-	platformAPI.QueueTryExecuteNextJob = Platform_QueueTryExecuteNextJob;
-	platformAPI.QueueAllJobsComplete   = Platform_QueueAllJobsComplete;
+	platformAPI.QueueAddJob              = Platform_QueueAddJob;
+	platformAPI.QueueAddJobs             = Platform_QueueAddJobs;
+	platformAPI.QueueTryExecuteNextJob   = Platform_QueueTryExecuteNextJob;
+	platformAPI.QueueAllJobsComplete     = Platform_QueueAllJobsComplete;
+	platformAPI.QueueWaitAllJobsComplete = Platform_QueueWaitAllJobsComplete;
 
 	platformAPI.AtomicCompareSwap = Platform_AtomicCompareSwap;
 
@@ -692,9 +857,12 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPWSTR lpCmdLi
 	platformInput.jobQueue          = &jobQueue;
 	platformInput.flags.canUseSSE2  = IsProcessorFeaturePresent(PF_XMMI64_INSTRUCTIONS_AVAILABLE);
 	platformInput.flags.canUseRdtsc = IsProcessorFeaturePresent(PF_RDTSC_INSTRUCTION_AVAILABLE);
+	platformInput.flags.canUseAVX2  = Win32CanUseAVX2();
 
 	// Threading
-	PlatformJob jobQueueMemory[512] = {};
+	PlatformJob jobQueueMemory[1024]       = {};
+	Win32JobRing jobRingMemory[64]         = {};
+	Win32ThreadParam threadParamMemory[64] = {};
 	{
 		DqnMemStackTempRegion memRegion;
 		if (!DQN_ASSERT(DqnMemStackTempRegion_Begin(&memRegion, &globalPlatformMemory.tempStack)))
@@ -709,24 +877,36 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPWSTR lpCmdLi
 		////////////////////////////////////////////////////////////////////////
 		// Threading
 		////////////////////////////////////////////////////////////////////////
-		jobQueue.jobList = jobQueueMemory;
-		jobQueue.size    = DQN_ARRAY_COUNT(jobQueueMemory);
-
-		// NOTE: InterlockedIncrement requires things to be on 32bit boundaries.
-		DQN_ASSERT(((size_t)&jobQueue.jobToExecuteIndex) % 4 == 0);
-
 		// NOTE: (numCores - 1), 1 core is already exclusively for main thread
 		i32 availableThreads = (numCores - 1) * numThreadsPerCore;
 		if (availableThreads <= 0) availableThreads = 1;
-		
-		jobQueue.win32Semaphore = CreateSemaphore(NULL, 0, availableThreads, NULL);
-		if (jobQueue.win32Semaphore)
+		availableThreads = DQN_MIN(availableThreads, (i32)DQN_ARRAY_COUNT(jobRingMemory) - 1);
+
+		// NOTE: Split the job memory evenly between the main and worker thread rings
+		jobQueue.ringList = jobRingMemory;
+		jobQueue.numRings = availableThreads + 1;
+		LONG jobsPerRing  = DQN_ARRAY_COUNT(jobQueueMemory) / jobQueue.numRings;
+		for (LONG i = 0; i < jobQueue.numRings; i++)
+		{
+			jobQueue.ringList[i].jobList = jobQueueMemory + (i * jobsPerRing);
+			jobQueue.ringList[i].size    = jobsPerRing;
+
+			// NOTE: InterlockedCompareExchange requires things to be on 32bit boundaries.
+			DQN_ASSERT(((size_t)&jobQueue.ringList[i].jobToExecuteIndex) % 4 == 0);
+		}
+
+		jobQueue.win32Semaphore            = CreateSemaphore(NULL, 0, availableThreads, NULL);
+		jobQueue.win32AllJobsCompleteEvent = CreateEvent(NULL, false, false, NULL);
+		if (jobQueue.win32Semaphore && jobQueue.win32AllJobsCompleteEvent)
 		{
 			// Create threads
 			for (i32 i = 0; i < availableThreads; i++)
 			{
+				Win32ThreadParam *threadParam = &threadParamMemory[i];
+				threadParam->queue            = &jobQueue;
+				threadParam->ringIndex        = i + 1;
+
 				const i32 USE_DEFAULT_STACK_SIZE = 0;
-				void *threadParam                = &jobQueue;
 				HANDLE handle = CreateThread(NULL, USE_DEFAULT_STACK_SIZE, Win32ThreadCallback,
 				                             threadParam, 0, NULL);
 				CloseHandle(handle);
@@ -744,8 +924,7 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPWSTR lpCmdLi
 				}
 			}
 
-			while (Platform_QueueTryExecuteNextJob(&jobQueue))
-				;
+			Platform_QueueWaitAllJobsComplete(&jobQueue);
 
 			for (i32 i = 0; i < DQN_ARRAY_COUNT(globalDebugCounterMemoize); i++)
 				DQN_ASSERT(globalDebugCounterMemoize[i]);
@@ -756,8 +935,8 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPWSTR lpCmdLi
 		}
 		else
 		{
-			// TODO(doyle): Semaphore failed.
-			DqnWin32_DisplayLastError("CreateSemaphore() failed");
+			// TODO(doyle): Semaphore/event failed.
+			DqnWin32_DisplayLastError("CreateSemaphore()/CreateEvent() failed");
 		}
 	}
 
@@ -0,0 +1,50 @@
+#!/bin/bash
+
+# Build the headless Linux platform layer with GCC (or Clang via CXX=clang++).
+# Outputs LinuxDTRenderer and dtrenderer.so into ../bin, alike build.bat.
+
+CXX=${CXX:-g++}
+if ! command -v $CXX > /dev/null 2>&1; then
+	echo "$CXX not on path, please install a C++ compiler or set CXX."
+	exit 1
+fi
+
+# Build tags file if you have ctags in path
+if command -v ctags > /dev/null 2>&1; then
+	ctags -R
+fi
+
+ScriptDir=$(cd "$(dirname "$0")" && pwd)
+mkdir -p "$ScriptDir/../bin"
+pushd "$ScriptDir/../bin" > /dev/null
+
+################################################################################
+# Compile Switches
+################################################################################
+# fno-exceptions/fno-rtti are not used since the tinyrenderer debug code needs the STL.
+# Wno-*     mirror the MSVC /wd switches in build.bat, i.e. unused arguments, unused locals,
+#           unreferenced functions, MSVC only pragmas and string literal to char * conversions.
+# msse2     SIMD paths are selected at runtime via PlatformFlags, SSE2 is baseline on x86-64.
+CompileFlags="-std=c++11 -g -Wall -Wno-unused-parameter -Wno-unused-variable -Wno-unused-function -Wno-unused-but-set-variable -Wno-unknown-pragmas -Wno-write-strings -Wno-sign-compare -Wno-missing-field-initializers -msse2 -I$ScriptDir/external/"
+LinkLibraries="-lpthread -ldl -lm"
+
+DebugMode=1
+if [ $DebugMode -eq 1 ]; then
+	CompileFlags="$CompileFlags -O0"
+else
+	CompileFlags="$CompileFlags -O2"
+fi
+
+################################################################################
+# Compile
+################################################################################
+$CXX $CompileFlags -fPIC -shared "$ScriptDir/UnityBuild/UnityBuild.cpp" -o dtrenderer.so $LinkLibraries
+LastError=$?
+
+if [ $LastError -eq 0 ]; then
+	$CXX $CompileFlags "$ScriptDir/LinuxDTRenderer.cpp" -o LinuxDTRenderer $LinkLibraries
+	LastError=$?
+fi
+
+popd > /dev/null
+exit $LastError
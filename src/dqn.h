@@ -108,6 +108,7 @@ typedef double f64;
 typedef float  f32;
 
 #define DQN_F32_MIN -FLT_MAX
+#define DQN_F32_MAX  FLT_MAX
 
 #define DQN_TERABYTE(val) (DQN_GIGABYTE(val) * 1024LL)
 #define DQN_GIGABYTE(val) (DQN_MEGABYTE(val) * 1024LL)
@@ -6082,8 +6083,7 @@ DQN_FILE_SCOPE f64 DqnTimer_NowInMs()
 	}
 	else
 	{
-		printf("tv_nsec: %ld\n", timeSpec.tv_nsec);
-		result = ((f64)timeSpec.tv_sec * 1000.0f) + ((f64)timeSpec.tv_nsec / 100000.0f);
+		result = ((f64)timeSpec.tv_sec * 1000.0f) + ((f64)timeSpec.tv_nsec / 1000000.0f);
 	}
 
 #else